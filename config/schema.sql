@@ -293,5 +293,7 @@ CREATE TABLE SesionReport (
     seriesDataJson TEXT,
     globalAnglesJson TEXT,
     globalOverloadsJson TEXT,
-    log TEXT
+    log TEXT,
+    repStatsJson TEXT,
+    reportBlob BLOB
 );
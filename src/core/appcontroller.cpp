@@ -81,8 +81,21 @@ void AppController::initialize() {
         }
         Init_Loader loader;
         loader.load(dbManager);
+    } else if (!dbManager->migrateSchema()) {
+        qCritical(AppControllerLog) << "Error migrando el esquema de la base de datos.";
+        exit(1);
     }
 
+    // Los repositorios usados fuera del hilo principal obtienen su propia conexión del pool
+    connectionPool = QSharedPointer<DBConnectionPool>::create(dbPath);
+    dbManager->setConnectionPool(connectionPool.data());
+
+    // Las sesiones se guardan en un hilo propio; se reenvían las que quedaron pendientes en la última ejecución
+    persistenceManager = QSharedPointer<PersistenceManager>::create(dbPath, QCoreApplication::applicationDirPath() + "/journal");
+    trainingManager->setPersistenceManager(persistenceManager);
+    if (int recovered = persistenceManager->replayJournal())
+        qDebug(AppControllerLog) << "Recuperadas del diario" << recovered << "escrituras pendientes";
+
         // dbManager->get(TypeBDEnum::User).print();
         //  dbManager->get(TypeBDEnum::Client).print();
         //  dbManager->get(TypeBDEnum::ClientWorkoutCalendar).print();
@@ -499,6 +512,20 @@ void AppController::startSesionAnalysis() {
     poseManager->runAnalysis();
 }
 
+/**
+ * @brief Devuelve el puntero compartido al PersistenceManager.
+ */
+QSharedPointer<PersistenceManager> AppController::getPersistenceManager() const {
+    return persistenceManager;
+}
+
+/**
+ * @brief Devuelve el pool de conexiones usado fuera del hilo principal.
+ */
+QSharedPointer<DBConnectionPool> AppController::getConnectionPool() const {
+    return connectionPool;
+}
+
 /**
  * @brief Devuelve el puntero compartido al MetricsManager.
  */
@@ -12,6 +12,7 @@
 #include "posemanager.h"
 #include <QLoggingCategory>
 #include "soundfeedbackmanager.h"
+#include "persistencemanager.h"
 
 class MainWindow;
 
@@ -68,6 +69,8 @@ public:
     QSharedPointer<SoundFeedbackManager> getSoundFeedbackManager();
     QSharedPointer<ValidationManager> getValidationManager();
     QSharedPointer<MetricsManager> getMetricsManager() const;
+    QSharedPointer<PersistenceManager> getPersistenceManager() const;
+    QSharedPointer<DBConnectionPool> getConnectionPool() const;
 
     /**
      * @brief Devuelve el mapa de conexiones entre keypoints.
@@ -155,6 +158,7 @@ public:
     void initializeAppData();
 private:
     QSharedPointer<DBManager> dbManager;  ///< Gestor de acceso a base de datos SQLite.
+    QSharedPointer<DBConnectionPool> connectionPool; ///< Conexiones de los repositorios usados desde otros hilos.
     QSharedPointer<LoginManager> loginManager;  ///< Gestor de autenticación de usuarios.
     QSharedPointer<UserManager> userManager;  ///< Gestor de lógica relacionada con usuarios y perfiles.
     QSharedPointer<TrainingManager> trainingManager;  ///< Gestor de entrenamientos y ejercicios.
@@ -162,6 +166,7 @@ private:
     QSharedPointer<SoundFeedbackManager> soundFeedbackManager; ///< Gestor de feedback auditivo.
     QSharedPointer<ValidationManager> validationManager; ///< Módulo de validación de condiciones de ejecución.
     QSharedPointer<MetricsManager> metricsManager; ///< Módulo de cálculo de métricas de rendimiento.
+    QSharedPointer<PersistenceManager> persistenceManager; ///< Escritura de sesiones en segundo plano.
     QScopedPointer<MainWindow> mainWindow; ///< Gestor del interfaz de usuario
     QSharedPointer<AppController> self;  ///<  Para que pueda pasarse a MainWindow correctamente
     QHash<QPair<int, int>, QString> connections; ///< Conexiones entre keypoints usados para análisis biomecánico.
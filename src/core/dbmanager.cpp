@@ -9,12 +9,15 @@
  */
 
 #include "dbmanager.h"
+#include "db/dbtransaction.h"
+#include "db/dbmigrations.h"
 #include <QDebug>
 #include <QFile>
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QSqlRecord>
 #include <QCoreApplication>
+#include <QRegularExpression>
 #include <QStandardPaths>
 // Definimos una categoría para los logs
 Q_LOGGING_CATEGORY(DBManagerLog, "DBManager")
@@ -23,9 +26,11 @@ Q_LOGGING_CATEGORY(DBManagerLog, "DBManager")
  * @brief Constructor de DBManager.
  * @param dbPath Ruta del archivo de base de datos SQLite.
  * @param parent Objeto padre de Qt.
+ * @param connectionName Nombre de la conexión Qt SQL (vacío: conexión por defecto).
  */
-DBManager::DBManager(const QString& dbPath, QObject* parent)
-    : QObject(parent) {
+DBManager::DBManager(const QString& dbPath, QObject* parent, const QString& connectionName)
+    : QObject(parent),
+    sqlConnectionName(connectionName) {
     openDatabase(dbPath);
 }
 /**
@@ -42,10 +47,12 @@ DBManager::~DBManager() {
  * @return true si la base de datos se abre correctamente, false en caso contrario.
  */
 bool DBManager::openDatabase(const QString& dbPath) {
-    if (QSqlDatabase::contains("qt_sql_default_connection")) {
-        qdb = QSqlDatabase::database("qt_sql_default_connection");
+    clearStatementCache();
+    const QString name = sqlConnectionName.isEmpty() ? QString("qt_sql_default_connection") : sqlConnectionName;
+    if (QSqlDatabase::contains(name)) {
+        qdb = QSqlDatabase::database(name);
     } else {
-        qdb = QSqlDatabase::addDatabase("QSQLITE");
+        qdb = QSqlDatabase::addDatabase("QSQLITE", name);
         qdb.setDatabaseName(dbPath);
     }
 
@@ -54,31 +61,91 @@ bool DBManager::openDatabase(const QString& dbPath) {
         return false;
     }
 
+    // REPLACE borra la fila en conflicto; con esta opción ese borrado dispara los triggers AFTER DELETE, de los que
+    // dependen los acumulados de SesionSummary cuando una sesión reprocesada cambia de fecha
+    execControl("PRAGMA recursive_triggers = ON");
+    loadTableMetadata();
+
+    // Las migraciones no se aplican aquí: cada conexión del pool y del worker de persistencia abre la misma base
+    // de datos, y solo la conexión principal la migra (initializeSchema() o AppController)
     return true;
 }
 /**
  * @brief Cierra la conexión actual con la base de datos.
  */
 void DBManager::closeDatabase() {
+    if (txDepth > 0) {
+        qWarning(DBManagerLog) << "Cerrando la base de datos con una transacción abierta; se deshace.";
+        execControl("ROLLBACK");
+        txDepth = 0;
+    }
+    // Las sentencias preparadas deben liberarse antes de cerrar la conexión
+    clearStatementCache();
+    tableColumns.clear();
+    idBlocks.clear();
     if (qdb.isOpen()) {
         qdb.close();
     }
 }
 /**
- * @brief Obtiene la lista de columnas de una tabla SQLite.
+ * @brief Lee con `PRAGMA table_info` las columnas de todas las tablas de la base de datos.
+ *
+ * Se ejecuta al abrir la base de datos y tras cargar el esquema; las tablas creadas después se incorporan
+ * bajo demanda en getTableColumns().
+ */
+void DBManager::loadTableMetadata() {
+    tableColumns.clear();
+
+    QSqlQuery tables(qdb);
+    if (!tables.exec("SELECT name FROM sqlite_master WHERE type = 'table' AND name NOT LIKE 'sqlite_%'")) {
+        qWarning(DBManagerLog) << "Error leyendo las tablas de la base de datos:" << tables.lastError().text();
+        return;
+    }
+
+    QStringList names;
+    while (tables.next()) names << tables.value(0).toString();
+    tables.finish();
+
+    for (const QString& name : names) readTableColumns(name);
+}
+
+/**
+ * @brief Lee las columnas de una tabla y las guarda en la caché de metadatos.
  * @param tableName Nombre de la tabla.
- * @return Lista con los nombres de las columnas.
+ * @return Columnas de la tabla (vacío si no existe).
  */
-QStringList DBManager::getTableColumns(const QString& tableName) {
-    QString query = QString("PRAGMA table_info(%1)").arg(tableName);
-    DBTable info = getTable(query);
+QStringList DBManager::readTableColumns(const QString& tableName) {
+    QSqlQuery query(qdb);
+    if (!query.exec(QString("PRAGMA table_info(%1)").arg(tableName))) {
+        qWarning(DBManagerLog) << "Error obteniendo la info de la tabla:" << query.lastError().text();
+        return {};
+    }
 
     QStringList columnas;
-    for (int i = 0; i < info.rowCount(); ++i) {
-        columnas << info.value(i, "name").toString();
-    }
+    // el indice 1 guarda los nombres de los campos para la tabla
+    while (query.next()) columnas << query.value(1).toString();
+
+    if (!columnas.isEmpty()) tableColumns.insert(tableName.toLower(), columnas);
     return columnas;
 }
+
+/**
+ * @brief Obtiene la lista de columnas de una tabla SQLite desde la caché de metadatos.
+ * @param tableName Nombre de la tabla.
+ * @return Lista con los nombres de las columnas.
+ */
+QStringList DBManager::getTableColumns(const QString& tableName) {
+    auto it = tableColumns.constFind(tableName.toLower());
+    if (it != tableColumns.constEnd()) return it.value();
+    return readTableColumns(tableName);
+}
+
+DBTable DBManager::tableSchema(TypeBDEnum tipo) {
+    QString tableName = TableName(tipo);
+    DBTable table(tableName);
+    if (!tableName.isEmpty()) table.setColumns(getTableColumns(tableName));
+    return table;
+}
 /**
  * @brief Verifica si un filtro es aplicable a una tabla.
  * @param tableName Nombre de la tabla.
@@ -91,23 +158,92 @@ bool DBManager::isValidFilterForTable(const QString& tableName, DBFilter filtro)
 
     if (nombreColumna.isEmpty()) return false;
 
-    QSqlQuery query(qdb);
-    QString sql = QString("PRAGMA table_info(%1)").arg(tableName);
+    return getTableColumns(tableName).contains(nombreColumna, Qt::CaseInsensitive);
+}
+/**
+ * @brief Devuelve la sentencia preparada para un SQL, preparándola la primera vez que se usa.
+ *
+ * La caché se indexa por el texto SQL, que identifica la operación, la tabla y el conjunto de filtros; los
+ * valores siempre se enlazan como parámetros. Si la caché supera su tamaño máximo se vacía por completo; las
+ * sentencias que el llamador aún tiene siguen siendo válidas porque comparte su propiedad.
+ * @param sql Sentencia con marcadores `?`.
+ * @return Consulta preparada, o puntero nulo si la preparación falla.
+ */
+QSharedPointer<QSqlQuery> DBManager::preparedQuery(const QString& sql) {
+    auto it = statementCache.constFind(sql);
+    if (it != statementCache.constEnd()) return it.value();
 
-    if (!query.exec(sql)) {
-        qWarning(DBManagerLog) << "Error obteniendo la info de la tabla:" << query.lastError().text();
+    if (statementCache.size() >= maxCachedStatements) clearStatementCache();
+
+    auto query = QSharedPointer<QSqlQuery>::create(qdb);
+    query->setForwardOnly(true);
+    if (!query->prepare(sql)) {
+        qWarning(DBManagerLog) << "Error preparando la consulta:" << sql << "::" << query->lastError().text();
+        return {};
+    }
+    statementCache.insert(sql, query);
+    return query;
+}
+
+/**
+ * @brief Enlaza los valores por posición y ejecuta una sentencia preparada.
+ * @param query Sentencia obtenida con preparedQuery().
+ * @param valores Valores de los marcadores, en orden.
+ * @return true si se ejecutó correctamente.
+ */
+bool DBManager::execPrepared(QSqlQuery* query, const QList<QVariant>& valores) {
+    if (!query) return false;
+    for (int i = 0; i < valores.size(); ++i) query->bindValue(i, valores[i]);
+
+    if (!query->exec()) {
+        qWarning(DBManagerLog) << "Error ejecutando la query:" << query->lastQuery() << " -> " << query->lastError().text();
+        query->finish();
         return false;
     }
+    return true;
+}
+
+bool DBManager::execPrepared(const QSharedPointer<QSqlQuery>& query, const QList<QVariant>& valores) {
+    return execPrepared(query.data(), valores);
+}
+
+/**
+ * @brief Vuelca el resultado de una consulta ejecutada en un DBTable y libera el cursor.
+ * @param query Consulta ya ejecutada.
+ * @param tableName Nombre que recibe el DBTable.
+ * @return DBTable con las filas del resultado.
+ */
+DBTable DBManager::readRows(QSqlQuery& query, const QString& tableName) {
+    DBTable table(tableName);
+
+    // Obtenemos los  nombres de columnas para incorporarlos a como los nombres de campo de DBTable
+    QSqlRecord record = query.record();
+    QStringList columnas;
+    for (int i = 0; i < record.count(); ++i) {
+        columnas << record.fieldName(i);
+    }
+    table.setColumns(columnas);
 
+    // La misma lista se reutiliza para todas las filas; DBTable reparte los valores en sus columnas
+    QList<QVariant> fila;
+    fila.reserve(columnas.size());
     while (query.next()) {
-        // el indice 1 guarda los nombres de los campos paa la tabla
-        QString columnName = query.value(1).toString();
-        if (columnName.compare(nombreColumna, Qt::CaseInsensitive) == 0) {
-            return true;
+        fila.clear();
+        for (int i = 0; i < columnas.size(); ++i) {
+            fila.append(query.value(i));
         }
+        table.addRow(fila);
     }
+    // Las sentencias en caché se reutilizan: se cierra el cursor para no mantener el bloqueo de lectura
+    query.finish();
+    return table;
+}
 
-    return false;
+/**
+ * @brief Libera todas las sentencias preparadas.
+ */
+void DBManager::clearStatementCache() {
+    statementCache.clear();
 }
 /**
  * @brief Ejecuta una consulta SQL y devuelve los resultados como un DBTable.
@@ -115,29 +251,15 @@ bool DBManager::isValidFilterForTable(const QString& tableName, DBFilter filtro)
  * @return Objeto DBTable con el resultado de la consulta.
  */
 DBTable DBManager::getTable(const QString& queryStr) {
-    DBTable table("QueryResult");
     QSqlQuery query(qdb);
+    query.setForwardOnly(true);
 
     if (!query.exec(queryStr)) {
         qWarning(DBManagerLog) << "Error ejecutando la consulta:" << query.lastError().text();
-        return table;
-    }
-
-    QStringList columnNames;
-    for (int i = 0; i < query.record().count(); ++i) {
-        columnNames << query.record().fieldName(i);
-    }
-    table.setColumns(columnNames);
-
-    while (query.next()) {
-        QList<QVariant> row;
-        for (int i = 0; i < columnNames.size(); ++i) {
-            row.append(query.value(i));
-        }
-        table.addRow(row);
+        return DBTable("QueryResult");
     }
 
-    return table;
+    return readRows(query, "QueryResult");
 }
 /**
  * @brief Reinicia la conexión a la base de datos, eliminando y reabriendo la conexión.
@@ -168,6 +290,7 @@ QString DBManager::TableName(TypeBDEnum tipo){
         case TypeBDEnum::Trainer: tableName = "fitnesstrainers"; break;
         case TypeBDEnum::Admin: tableName = "admins"; break;
         case TypeBDEnum::Preferences: tableName = "userpreferences"; break;
+        case TypeBDEnum::UserPicture: tableName = "user_pictures"; break;
          case TypeBDEnum::ClientWorkoutCalendar: tableName = "client_workout_calendar"; break;
 
         case TypeBDEnum::ExerciseEspec: tableName = "exercise_espec"; break;
@@ -190,6 +313,9 @@ QString DBManager::TableName(TypeBDEnum tipo){
           case TypeBDEnum::TrainingSesion: tableName = "TrainingSesion"; break;
          case TypeBDEnum::ExerciseSummary: tableName = "ExerciseSummary"; break;
          case TypeBDEnum::SesionReport: tableName = "SesionReport"; break;
+         case TypeBDEnum::SesionSummary: tableName = "SesionSummary"; break;
+         case TypeBDEnum::SesionRollupDaily: tableName = "SesionRollupDaily"; break;
+         case TypeBDEnum::SesionRollupWeekly: tableName = "SesionRollupWeekly"; break;
         default:
             tableName = "";
     }
@@ -207,6 +333,7 @@ QString DBManager::getNameIdColumn(TypeBDEnum tipo) const {
     case TypeBDEnum::Client:
     case TypeBDEnum::Trainer:
     case TypeBDEnum::Admin:
+    case TypeBDEnum::UserPicture:
 
         return "idUser";
     case TypeBDEnum::Preferences:
@@ -224,6 +351,7 @@ QString DBManager::getNameIdColumn(TypeBDEnum tipo) const {
     case TypeBDEnum::WorkoutExercises:
         return "idWorkout";
     case TypeBDEnum::TrainingSesion:
+    case TypeBDEnum::SesionSummary:
         return "idSesion";
     case TypeBDEnum::ProfileGeneral:
     case TypeBDEnum::ProfileFunctional:
@@ -259,83 +387,188 @@ bool DBManager::save(TypeBDEnum tipo, DBTable& elem, DBFilter filtro, QString va
     QString fieldss = columns.join(", ");
     QString idColumn = getNameIdColumn(tipo);
 
+    QStringList simbs;
+    for (int i = 0; i < columns.size(); ++i) simbs << "?";
+
+    // La aplicabilidad del filtro no depende de la fila: se resuelve una vez para todo el DBTable
+    bool filtroAplicable = !valorFiltro.isEmpty() && filtro != DBFilter::none &&
+                           isValidFilterForTable(tableName, filtro);
+
+    if (!filtroAplicable) return saveBulk(tipo, elem);
+
+    releaseIdBlock(tipo, elem);
+
+    int idx = columns.indexOf(idColumn);
+    if (idx == -1) {
+        qWarning(DBManagerLog) << "No se encontró la columna clave primaria:" << idColumn;
+        return false;
+    }
+
+    QString campoFiltro = BDFilterToString(filtro);
+    QStringList sets;
+    for (const QString& col : columns) sets << col + " = ?";
+
+    QSharedPointer<QSqlQuery> check = preparedQuery(QString("SELECT COUNT(*) FROM %1 WHERE %2 = ? AND %3 = ?")
+                                         .arg(tableName, campoFiltro, idColumn));
+    QSharedPointer<QSqlQuery> update = preparedQuery(QString("UPDATE %1 SET %2 WHERE %3 = ? AND %4 = ?")
+                                          .arg(tableName, sets.join(", "), campoFiltro, idColumn));
+    QSharedPointer<QSqlQuery> insert = preparedQuery(QString("INSERT INTO %1 (%2) VALUES (%3)").arg(tableName, fieldss, simbs.join(", ")));
+
+    DBTransaction tx(this);
     for (int row = 0; row < elem.rowCount(); ++row) {
         QList<QVariant> valores = elem.getRow(row);
+        QVariant valorClave = valores[idx];
 
-        bool filtroAplicable = !valorFiltro.isEmpty() && filtro != DBFilter::none &&
-                               isValidFilterForTable(tableName, filtro);
+        if (!execPrepared(check, {valorFiltro, valorClave})) return false;
+        check->next();
+        int count = check->value(0).toInt();
+        check->finish();
 
-        QSqlQuery query(qdb);
-        QString queryStr;
+        bool ok;
+        if (count > 0) {
+            ok = execPrepared(update, valores + QList<QVariant>{valorFiltro, valorClave});
+        } else {
+            ok = execPrepared(insert, valores);
+        }
+        if (!ok) return false;
+    }
+    return tx.commit();
+}
 
-        if (filtroAplicable) {
+/**
+ * @brief Guarda las filas en bloques: todas las sentencias de bloque completo comparten la misma sentencia
+ * preparada y el resto de filas usa otra.
+ */
+bool DBManager::saveBulk(TypeBDEnum tipo, const DBTable& elem) {
+    QString tableName = TableName(tipo);
+    if (tableName.isEmpty() || elem.rowCount() == 0) return false;
 
-            QString campoFiltro = BDFilterToString(filtro);
-            QString filtroFormateado = valorFiltro.replace("'", "''");
+    QStringList columns = elem.getColumnsNames();
+    if (columns.isEmpty()) return false;
+
+    QStringList simbs;
+    for (int i = 0; i < columns.size(); ++i) simbs << "?";
+    const QString tupla = "(" + simbs.join(", ") + ")";
+    const QString prefix = QString("REPLACE INTO %1 (%2) VALUES ").arg(tableName, columns.join(", "));
+    const int rowsPerStatement = qMax(1, maxBoundParameters / columns.size());
+    releaseIdBlock(tipo, elem);
+
+    DBTransaction tx(this);
+    for (int first = 0; first < elem.rowCount(); first += rowsPerStatement) {
+        const int rows = qMin(rowsPerStatement, elem.rowCount() - first);
+
+        QStringList tuplas;
+        QList<QVariant> valores;
+        valores.reserve(rows * columns.size());
+        for (int row = first; row < first + rows; ++row) {
+            tuplas << tupla;
+            valores += elem.getRow(row);
+        }
 
-            int idx = columns.indexOf(idColumn);
-            if (idx == -1) {
-                qWarning(DBManagerLog) << "No se encontró la columna clave primaria:" << idColumn;
-                return false;
-            }
+        if (!execPrepared(preparedQuery(prefix + tuplas.join(", ")), valores)) return false;
+    }
+    return tx.commit();
+}
 
-            QVariant valorClave = valores[idx];
-            QString cQuery = QString("SELECT COUNT(*) FROM %1 WHERE %2 = ? AND %3 = ?")
-                                     .arg(tableName, campoFiltro, idColumn);
+/**
+ * @brief Cada tabla se guarda con save(), que dentro de la transacción del lote usa un savepoint.
+ */
+bool DBManager::writeBatch(const DBWriteBatch& batch) {
+    DBTransaction tx(this);
+    for (const auto& entry : batch.tables) {
+        DBTable table = entry.second;
+        if (!save(entry.first, table)) {
+            qWarning(DBManagerLog) << "Error guardando la tabla" << table.getTableName() << "del lote" << batch.id;
+            return false;
+        }
+    }
+    return tx.commit();
+}
 
-            QSqlQuery check(qdb);
+/**
+ * @brief `PRAGMA journal_mode` devuelve el modo resultante; con WAL basta `synchronous = NORMAL` para no
+ * perder transacciones confirmadas salvo ante un corte de corriente.
+ */
+bool DBManager::enableWriteAheadLog() {
+    QSqlQuery query(qdb);
+    if (!query.exec("PRAGMA journal_mode = WAL") || !query.next() ||
+        query.value(0).toString().compare("wal", Qt::CaseInsensitive) != 0) {
+        qWarning(DBManagerLog) << "No se pudo activar el modo WAL:" << query.lastError().text();
+        return false;
+    }
+    query.finish();
+    return execControl("PRAGMA synchronous = NORMAL");
+}
 
-            check.prepare(cQuery);
-            check.addBindValue(valorFiltro);
-            check.addBindValue(valorClave);
+bool DBManager::setReadOnly(bool readOnly) {
+    return execControl(QString("PRAGMA query_only = %1").arg(readOnly ? "ON" : "OFF"));
+}
 
+QString DBManager::connectionName() const {
+    return qdb.connectionName();
+}
 
+void DBManager::setConnectionPool(DBConnectionPool* pool) {
+    this->pool = pool;
+}
 
-            if (!check.exec()) {
-                qWarning(DBManagerLog) << "Error ejecutando SELECT previo en save():" << check.lastError().text();
-                return false;
-            }
-            check.next();
+DBConnectionPool* DBManager::connectionPool() const {
+    return pool;
+}
+
+/**
+ * @brief Ejecuta una sentencia de control o de esquema sin pasar por la caché.
+ */
+bool DBManager::execControl(const QString& sql) {
+    QSqlQuery query(qdb);
+    if (!query.exec(sql)) {
+        qWarning(DBManagerLog) << "Error ejecutando" << sql << "::" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
 
-            int count = check.value(0).toInt();
+/**
+ * @brief El nivel más externo abre la transacción con BEGIN IMMEDIATE (reserva la escritura desde el
+ * principio); los niveles internos crean un savepoint con el número de nivel.
+ */
+bool DBManager::beginTransaction() {
+    if (!qdb.isOpen()) return false;
 
-            if (count > 0) {
+    bool ok = (txDepth == 0) ? execControl("BEGIN IMMEDIATE")
+                             : execControl(QString("SAVEPOINT sp_%1").arg(txDepth));
+    if (ok) ++txDepth;
+    return ok;
+}
 
-                QStringList sets;
+bool DBManager::commitTransaction() {
+    if (txDepth == 0) return false;
 
-                for ( QString col : columns) {
-                    sets << col + " = ?";
-                }
-                queryStr = QString("UPDATE %1 SET %2 WHERE %3 = ? AND %4 = ?").arg(tableName, sets.join(", "), campoFiltro, idColumn);
-                query.prepare(queryStr);
+    --txDepth;
+    if (txDepth == 0) {
+        if (execControl("COMMIT")) return true;
+        // Si el COMMIT falla la transacción sigue abierta: se deshace para no dejar la conexión bloqueada
+        execControl("ROLLBACK");
+        return false;
+    }
+    return execControl(QString("RELEASE sp_%1").arg(txDepth));
+}
 
-                for ( QVariant val : valores) query.addBindValue(val);
+bool DBManager::rollbackTransaction() {
+    if (txDepth == 0) return false;
 
-                query.addBindValue(valorFiltro);
-                query.addBindValue(valorClave);
+    // Las reservas de IDs hechas dentro de la transacción se deshacen con ella
+    idBlocks.clear();
 
-            } else {
-                QStringList simbs;
-                for (int i = 0; i < valores.size(); ++i) simbs << "?";
-                queryStr = QString("INSERT INTO %1 (%2) VALUES (%3)").arg(tableName, fieldss, simbs.join(", "));
-                query.prepare(queryStr);
-                for (const QVariant& val : valores) query.addBindValue(val);
-            }
-        } else {
+    --txDepth;
+    if (txDepth == 0) return execControl("ROLLBACK");
 
-            QStringList simbs;
-            for (int i = 0; i < valores.size(); ++i) simbs << "?";
-            queryStr = QString("REPLACE INTO %1 (%2) VALUES (%3)").arg(tableName, fieldss, simbs.join(", "));
-            query.prepare(queryStr);
-            for (const QVariant& val : valores) query.addBindValue(val);
-        }
+    const QString sp = QString("sp_%1").arg(txDepth);
+    return execControl("ROLLBACK TO " + sp) && execControl("RELEASE " + sp);
+}
 
-        if (!query.exec()) {
-            qWarning(DBManagerLog) << "Error ejecutando la query:" << queryStr << " -> " << query.lastError().text();
-            return false;
-        }
-    }
-    return true;
+int DBManager::transactionDepth() const {
+    return txDepth;
 }
 
 
@@ -352,46 +585,21 @@ DBTable DBManager::get(TypeBDEnum tipo, DBFilter filtro,  QString valorFiltro) {
     QString tableName=TableName(tipo);
     if (tableName=="") return DBTable("error");
 
-    // Contruimos la consulta para pbtener la tabl
-    QString queryStr;
     bool aplicarFiltro = !valorFiltro.isEmpty() &&
                          filtro != DBFilter::none &&
                          isValidFilterForTable(tableName, filtro);
 
+    QSharedPointer<QSqlQuery> query;
+    QList<QVariant> valores;
     if (aplicarFiltro) {
-        QString campo = BDFilterToString(filtro);
-        QString valorFOrmateado = valorFiltro.replace("'", "''");
-        queryStr = QString("SELECT * FROM %1 WHERE %2 = '%3'") .arg(tableName, campo, valorFOrmateado);
+        query = preparedQuery(QString("SELECT * FROM %1 WHERE %2 = ?").arg(tableName, BDFilterToString(filtro)));
+        valores << valorFiltro;
     } else {
-        queryStr = QString("SELECT * FROM %1").arg(tableName);
+        query = preparedQuery(QString("SELECT * FROM %1").arg(tableName));
     }
 
-    // Se ejecuta la consulta
-    DBTable table(tableName);
-    QSqlQuery query(qdb);
-
-    if (!query.exec(queryStr)) {
-        qWarning(DBManagerLog) << "Error ejecutando SELECT en get():" << query.lastError().text();
-        return table;
-    }
-
-    // Obtenemos los  nombres de columnas para incorporarlos a como los nombres de campo de DBTable
-    QStringList columnas;
-    for (int i = 0; i < query.record().count(); ++i) {
-        columnas << query.record().fieldName(i);
-    }
-    table.setColumns(columnas);
-
-    // Añadir filas
-    while (query.next()) {
-        QList<QVariant> fila;
-        for (int i = 0; i < columnas.size(); ++i) {
-            fila.append(query.value(i));
-        }
-        table.addRow(fila);
-    }
-
-    return table;
+    if (!execPrepared(query, valores)) return DBTable(tableName);
+    return readRows(*query, tableName);
 }
 /**
  * @brief Recupera datos usando un filtro con múltiples valores.
@@ -404,48 +612,26 @@ DBTable DBManager::get(TypeBDEnum tipo, DBFilter filtro, const QStringList& list
     QString tableName = TableName(tipo);
     if (tableName == "") return DBTable("error");
 
-    QString queryStr;
     bool aplicarFiltro = !listaValores.isEmpty() &&
                          filtro != DBFilter::none &&
                          isValidFilterForTable(tableName, filtro);
 
+    QSharedPointer<QSqlQuery> query;
+    QList<QVariant> valores;
     if (aplicarFiltro) {
-        QString campo = BDFilterToString(filtro);
-
-        QStringList valoresEscapados;
+        // Una sentencia por número de valores: las listas de la misma longitud reutilizan la preparada
+        QStringList simbs;
         for (const QString& v : listaValores) {
-            valoresEscapados << "'" + v.trimmed().replace("'", "''") + "'";
+            simbs << "?";
+            valores << v.trimmed();
         }
-
-        QString inClause = valoresEscapados.join(",");
-        queryStr = QString("SELECT * FROM %1 WHERE %2 IN (%3)").arg(tableName, campo, inClause);
+        query = preparedQuery(QString("SELECT * FROM %1 WHERE %2 IN (%3)").arg(tableName, BDFilterToString(filtro), simbs.join(",")));
     } else {
-        queryStr = QString("SELECT * FROM %1").arg(tableName);
+        query = preparedQuery(QString("SELECT * FROM %1").arg(tableName));
     }
 
-    DBTable table(tableName);
-    QSqlQuery query(qdb);
-
-    if (!query.exec(queryStr)) {
-        qWarning(DBManagerLog) << "Error ejecutando SELECT múltiple en get(): " << query.lastError().text();
-        return table;
-    }
-
-    QStringList columnas;
-    for (int i = 0; i < query.record().count(); ++i) {
-        columnas << query.record().fieldName(i);
-    }
-    table.setColumns(columnas);
-
-    while (query.next()) {
-        QList<QVariant> fila;
-        for (int i = 0; i < columnas.size(); ++i) {
-            fila.append(query.value(i));
-        }
-        table.addRow(fila);
-    }
-
-    return table;
+    if (!execPrepared(query, valores)) return DBTable(tableName);
+    return readRows(*query, tableName);
 }
 /**
  * @brief Recupera datos desde la base de datos aplicando múltiples filtros simultáneamente.
@@ -457,8 +643,20 @@ DBTable DBManager::get(TypeBDEnum tipo, const QMap<DBFilter, QVariant>& filtros)
     QString tableName = TableName(tipo);
     if (tableName.isEmpty()) return DBTable("error");
 
-    QStringList condiciones;
+    QList<QVariant> valores;
+    QString where = whereClause(filtros, valores);
 
+    QSharedPointer<QSqlQuery> query = preparedQuery(QString("SELECT * FROM %1 %2").arg(tableName, where));
+    if (!execPrepared(query, valores)) return DBTable("error");
+
+    return readRows(*query, tableName);
+}
+
+/**
+ * @brief QMap recorre los filtros en orden de clave, por lo que el mismo conjunto de filtros genera el mismo SQL.
+ */
+QString DBManager::whereClause(const QMap<DBFilter, QVariant>& filtros, QList<QVariant>& valores) const {
+    QStringList condiciones;
     for (auto it = filtros.constBegin(); it != filtros.constEnd(); ++it) {
         if (it.key() == DBFilter::none)
             continue;
@@ -466,43 +664,134 @@ DBTable DBManager::get(TypeBDEnum tipo, const QMap<DBFilter, QVariant>& filtros)
         QString colName = BDFilterToString(it.key());
 
         if (!colName.isEmpty()) {
-            QString cond =QString("%1 = '%2'").arg(colName, it.value().toString().replace("'", "''"));
-            condiciones.append(cond);
+            condiciones.append(colName + " = ?");
+            valores.append(it.value().toString());
         }
     }
 
-    QString where = (condiciones.isEmpty()) ? "" : "WHERE " + condiciones.join(" AND ");
+    return (condiciones.isEmpty()) ? "" : "WHERE " + condiciones.join(" AND ");
+}
 
-    QString queryStr = QString("SELECT * FROM %1 %2").arg(tableName, where);
+bool DBManager::scan(TypeBDEnum tipo, const QMap<DBFilter, QVariant>& filtros, const DBChunkVisitor& visitor, int chunkSize) {
+    QString tableName = TableName(tipo);
+    if (tableName.isEmpty()) return false;
 
+    QList<QVariant> valores;
+    QString where = whereClause(filtros, valores);
+    return scanQuery(QString("SELECT * FROM %1 %2").arg(tableName, where), valores, visitor, chunkSize, tableName);
+}
 
+/**
+ * @brief Los nombres de columna se validan contra el esquema en caché porque forman parte del texto SQL. Los
+ * filtros de texto usan LIKE con los comodines del valor escapados.
+ */
+DBTable DBManager::getPage(const DBPageRequest& peticion) {
+    QString tableName = TableName(peticion.tipo);
+    if (tableName.isEmpty()) return DBTable("error");
 
-    QSqlQuery query(qdb);
+    const QStringList existentes = getTableColumns(tableName);
+    auto valida = [&](const QString& col) {
+        if (existentes.contains(col, Qt::CaseInsensitive)) return true;
+        qWarning(DBManagerLog) << "getPage: columna no válida" << col << "para la tabla" << tableName;
+        return false;
+    };
 
-    if (!query.exec(queryStr)) {
-        qWarning(DBManagerLog) << "Error ejecutando SELECT:" << queryStr << "::" << query.lastError().text();
-        return DBTable("error");;
+    const QStringList columnas = peticion.columns.isEmpty() ? existentes : peticion.columns;
+    for (const QString& col : columnas)
+        if (!valida(col)) return DBTable(tableName);
+
+    QStringList condiciones;
+    QList<QVariant> valores;
+    for (auto it = peticion.equals.constBegin(); it != peticion.equals.constEnd(); ++it) {
+        if (!valida(it.key())) return DBTable(tableName);
+        condiciones << it.key() + " = ?";
+        valores << it.value();
+    }
+    for (auto it = peticion.contains.constBegin(); it != peticion.contains.constEnd(); ++it) {
+        if (it.value().isEmpty()) continue;
+        if (!valida(it.key())) return DBTable(tableName);
+        QString patron = it.value();
+        patron.replace("\\", "\\\\").replace("%", "\\%").replace("_", "\\_");
+        condiciones << it.key() + " LIKE ? ESCAPE '\\'";
+        valores << "%" + patron + "%";
+    }
+    for (auto it = peticion.between.constBegin(); it != peticion.between.constEnd(); ++it) {
+        if (!valida(it.key())) return DBTable(tableName);
+        if (!it.value().first.isNull()) {
+            condiciones << it.key() + " >= ?";
+            valores << it.value().first;
+        }
+        if (!it.value().second.isNull()) {
+            condiciones << it.key() + " <= ?";
+            valores << it.value().second;
+        }
     }
 
-    DBTable table(tableName);
-    QStringList columnas;
+    const QString idColumn = getNameIdColumn(peticion.tipo);
+    const QString sentido = peticion.order == Qt::DescendingOrder ? "DESC" : "ASC";
+    QStringList orden;
+    if (!peticion.orderBy.isEmpty()) {
+        if (!valida(peticion.orderBy)) return DBTable(tableName);
+        orden << peticion.orderBy + " " + sentido;
+    }
+    if (existentes.contains(idColumn, Qt::CaseInsensitive) && peticion.orderBy.compare(idColumn, Qt::CaseInsensitive) != 0)
+        orden << idColumn + " " + sentido;
+
+    QString sql = QString("SELECT %1 FROM %2").arg(columnas.join(", "), tableName);
+    if (!condiciones.isEmpty()) sql += " WHERE " + condiciones.join(" AND ");
+    if (!orden.isEmpty()) sql += " ORDER BY " + orden.join(", ");
+    sql += " LIMIT ? OFFSET ?";
+    valores << qMax(peticion.limit, 0) << qMax(peticion.offset, 0);
+
+    QSharedPointer<QSqlQuery> query = preparedQuery(sql);
+    if (!execPrepared(query, valores)) return DBTable(tableName);
+    return readRows(*query, tableName);
+}
 
-    for (int i = 0; i < query.record().count(); ++i) {
-        columnas << query.record().fieldName(i);
+/**
+ * @brief La consulta no sale de la caché de sentencias: el visitante puede usar el DBManager mientras el cursor
+ * sigue abierto sin reejecutar la sentencia que se está recorriendo.
+ */
+bool DBManager::scanQuery(const QString& sql, const QList<QVariant>& valores, const DBChunkVisitor& visitor,
+                          int chunkSize, const QString& tableName) {
+    QSqlQuery query(qdb);
+    query.setForwardOnly(true);
+    if (!query.prepare(sql)) {
+        qWarning(DBManagerLog) << "Error preparando la consulta:" << sql << "::" << query.lastError().text();
+        return false;
     }
+    if (!execPrepared(&query, valores)) return false;
 
-    table.setColumns(columnas);
+    chunkSize = qMax(chunkSize, 1);
+    DBTable chunk(tableName);
+    QSqlRecord record = query.record();
+    QStringList columnas;
+    for (int i = 0; i < record.count(); ++i) columnas << record.fieldName(i);
+    chunk.setColumns(columnas);
 
+    QList<QVariant> fila;
+    fila.reserve(columnas.size());
     while (query.next()) {
-
-        QList<QVariant> fila;
-        for (int i = 0; i < columnas.size(); ++i) {
-            fila.append(query.value(i));
+        fila.clear();
+        for (int i = 0; i < columnas.size(); ++i) fila.append(query.value(i));
+        chunk.addRow(fila);
+
+        if (chunk.rowCount() == chunkSize) {
+            if (!visitor(chunk)) {
+                query.finish();
+                return true;
+            }
+            chunk.clearRows();
         }
-        table.addRow(fila);
     }
 
-    return table;
+    if (query.lastError().isValid()) {
+        qWarning(DBManagerLog) << "Error recorriendo la consulta:" << sql << "::" << query.lastError().text();
+        return false;
+    }
+    if (chunk.rowCount() > 0) visitor(chunk);
+    query.finish();
+    return true;
 }
 /**
  * @brief Ejecuta el script de inicialización del esquema de base de datos desde archivo.
@@ -523,7 +812,7 @@ bool DBManager::initializeSchema() {
     QString sqlContent = in.readAll();
     sqlFile.close();
 
-    QSqlQuery query;
+    QSqlQuery query(qdb);
     QStringList statements = sqlContent.split(';', Qt::SkipEmptyParts);
 
     for (QString stmt : statements) {
@@ -538,61 +827,136 @@ bool DBManager::initializeSchema() {
         }
     }
 
+    // El esquema puede haber creado tablas nuevas
+    loadTableMetadata();
+    return migrateSchema();
+}
+
+/**
+ * @brief Lee la versión del esquema; una base de datos anterior a las migraciones tiene versión 0.
+ */
+int DBManager::schemaVersion() {
+    QSqlQuery query(qdb);
+    if (!query.exec("PRAGMA user_version") || !query.next()) {
+        qWarning(DBManagerLog) << "Error leyendo la versión del esquema:" << query.lastError().text();
+        return -1;
+    }
+    return query.value(0).toInt();
+}
+
+/**
+ * @brief Recorre la lista de migraciones y aplica las de versión mayor que la guardada.
+ */
+bool DBManager::migrateSchema() {
+    int version = schemaVersion();
+    if (version < 0) return false;
+
+    // schema.sql ya incluye las columnas añadidas por las migraciones: en una base de datos creada con él,
+    // el ALTER TABLE ... ADD COLUMN fallaría y se omite
+    static const QRegularExpression addColumn(R"(^\s*ALTER\s+TABLE\s+(\w+)\s+ADD\s+COLUMN\s+(\w+))",
+                                              QRegularExpression::CaseInsensitiveOption);
+    const int initialVersion = version;
+
+    for (const DBMigration& migration : dbMigrations()) {
+        if (migration.version <= version) continue;
+
+        DBTransaction tx(this);
+        if (!tx.isActive()) {
+            qWarning(DBManagerLog) << "No se pudo iniciar la transacción de la migración" << migration.version;
+            return false;
+        }
+        // Con el bloqueo de escritura ya tomado, otra conexión puede haber aplicado la migración entre la
+        // lectura anterior y BEGIN IMMEDIATE
+        version = schemaVersion();
+        if (version < 0) return false;
+        if (migration.version <= version) continue;
+
+        bool ok = true;
+        for (const QString& stmt : migration.statements) {
+            const QRegularExpressionMatch match = addColumn.match(stmt);
+            if (match.hasMatch() && readTableColumns(match.captured(1)).contains(match.captured(2), Qt::CaseInsensitive))
+                continue;
+            if (!execControl(stmt)) { ok = false; break; }
+        }
+        // PRAGMA no admite parámetros; la versión es un entero de la lista de migraciones
+        if (ok) ok = execControl(QString("PRAGMA user_version = %1").arg(migration.version));
+        if (ok) ok = tx.commit();
+
+        if (!ok) {
+            qWarning(DBManagerLog) << "Error aplicando la migración" << migration.version << migration.description;
+            return false;
+        }
+        qDebug(DBManagerLog) << "Esquema migrado a la versión" << migration.version << ":" << migration.description;
+        version = migration.version;
+    }
+
+    // Las migraciones pueden haber cambiado las columnas de tablas ya leídas
+    if (version != initialVersion) {
+        clearStatementCache();
+        loadTableMetadata();
+    }
     return true;
 }
 /**
- * @brief Genera un nuevo ID libre para una tabla.
+ * @brief Genera un nuevo ID para una tabla.
  *
- * Utiliza una consulta recursiva para buscar el menor entero positivo no utilizado como ID.
+ * Los IDs se reservan por bloques en la tabla `id_sequence` dentro de una transacción BEGIN IMMEDIATE, de modo
+ * que dos conexiones que escriban a la vez nunca reciben el mismo ID. Los IDs del bloque reservado se
+ * entregan después desde memoria sin acceder a la base de datos. Al reservar se parte del máximo entre la
+ * secuencia y el mayor ID de la tabla (consulta sobre la clave primaria), por lo que las filas guardadas con
+ * un ID explícito no se pisan.
  * @param tipo Tipo de tabla.
- * @return Entero correspondiente al nuevo ID.
+ * @return Entero correspondiente al nuevo ID, o -1 si hay error.
  */
 int DBManager::generateID(TypeBDEnum tipo)
 {
-    // QString tableName = TableName(tipo);
-    // QString idColumn = getNameIdColumn(tipo);  // Esta función debe mapear el tipo al nombre de la columna ID
+    QString tableName = TableName(tipo);
+    QString idColumn = getNameIdColumn(tipo);
+    if (tableName.isEmpty() || idColumn.isEmpty()) return -1;
 
-    // QString queryStr = QString("SELECT MAX(%1) FROM %2").arg(idColumn, tableName);
-    // QSqlQuery query;
+    auto block = idBlocks.find(tableName);
+    if (block != idBlocks.end() && block->next < block->end) return block->next++;
 
-    // if (!query.exec(queryStr)) {
-    //     qCritical() << "DBManager::generateID - Error al ejecutar la consulta:" << query.lastError().text();
-    //     return -1;
-    // }
+    DBTransaction tx(this);
 
-    // if (query.next()) {
-    //     int maxId = query.value(0).toInt();
-    //     return maxId + 1;
-    // }
+    QSharedPointer<QSqlQuery> seq = preparedQuery("SELECT nextId FROM id_sequence WHERE tableName = ?");
+    if (!execPrepared(seq, {tableName})) return -1;
+    int next = seq->next() ? seq->value(0).toInt() : 1;
+    seq->finish();
 
-    // return 1;
-    QString tableName = TableName(tipo);
-    QString idColumn = getNameIdColumn(tipo);
+    QSharedPointer<QSqlQuery> max = preparedQuery(QString("SELECT MAX(%1) FROM %2").arg(idColumn, tableName));
+    if (!execPrepared(max, {})) return -1;
+    if (max->next()) next = qMax(next, max->value(0).toInt() + 1);
+    max->finish();
 
-    QString queryStr = QString(R"(
-        WITH RECURSIVE seq(n) AS (
-            SELECT 1
-            UNION ALL
-            SELECT n + 1 FROM seq WHERE n < 100000
-        )
-        SELECT n FROM seq
-        WHERE n NOT IN (SELECT %1 FROM %2)
-        ORDER BY n
-        LIMIT 1;
-    )").arg(idColumn, tableName);
-
-    QSqlQuery query;
-    if (!query.exec(queryStr)) {
-        qCritical(DBManagerLog) << "DBManager::generateID  Error ejecutando consulta:" << query.lastError().text();
+    QSharedPointer<QSqlQuery> reserve = preparedQuery("REPLACE INTO id_sequence (tableName, nextId) VALUES (?, ?)");
+    if (!execPrepared(reserve, {tableName, next + idBlockSize})) return -1;
+    if (!tx.commit()) {
+        qCritical(DBManagerLog) << "DBManager::generateID  No se pudo reservar un ID para" << tableName;
         return -1;
     }
 
-    if (query.next() && query.value(0).isValid()) {
-        return query.value(0).toInt();
-    }
+    idBlocks.insert(tableName, {next + 1, next + idBlockSize});
+    return next;
+}
 
-    return 1;
+/**
+ * @brief Descarta el bloque de IDs en memoria de la tabla si alguna fila usa un ID que estaba reservado en él.
+ */
+void DBManager::releaseIdBlock(TypeBDEnum tipo, const DBTable& elem) {
+    auto block = idBlocks.find(TableName(tipo));
+    if (block == idBlocks.end() || block->next >= block->end) return;
 
+    int idx = elem.getColumnsNames().indexOf(getNameIdColumn(tipo));
+    if (idx == -1) return;
+
+    for (int row = 0; row < elem.rowCount(); ++row) {
+        int id = elem.intValue(row, idx);
+        if (id >= block->next && id < block->end) {
+            idBlocks.erase(block);
+            return;
+        }
+    }
 }
 
 /**
@@ -609,18 +973,8 @@ bool DBManager::deleteRow(TypeBDEnum tipo, DBFilter filtro,  QString& valorFiltr
 
     if (!isValidFilterForTable(tableName, filtro)) return false;
 
-    QString campo = BDFilterToString(filtro);
-    QString valorEscapado = valorFiltro.replace("'", "''");
-
-    QString queryStr = QString("DELETE FROM %1 WHERE %2 = '%3'").arg(tableName, campo, valorEscapado);
-
-    QSqlQuery query(qdb);
-    if (!query.exec(queryStr)) {
-        qWarning(DBManagerLog) << "Error ejecutando DELETE:" << query.lastError().text();
-        return false;
-    }
-
-    return true;
+    QSharedPointer<QSqlQuery> query = preparedQuery(QString("DELETE FROM %1 WHERE %2 = ?").arg(tableName, BDFilterToString(filtro)));
+    return execPrepared(query, {valorFiltro});
 }
 /**
  * @brief Elimina múltiples filas usando una lista de valores.
@@ -636,23 +990,15 @@ bool DBManager::deleteRow(TypeBDEnum tipo, DBFilter filtro, const QStringList& l
     if (!isValidFilterForTable(tableName, filtro)) return false;
     if (listaValores.isEmpty()) return true;
 
-    QString campo = BDFilterToString(filtro);
-
-    QStringList condiciones;
-    for (QString v : listaValores) {
-        condiciones << QString("'%1'").arg(v.replace("'", "''"));
+    QStringList simbs;
+    QList<QVariant> valores;
+    for (const QString& v : listaValores) {
+        simbs << "?";
+        valores << v;
     }
 
-    QString whereClause = QString("%1 IN (%2)").arg(campo, condiciones.join(","));
-    QString queryStr = QString("DELETE FROM %1 WHERE %2").arg(tableName, whereClause);
-
-    QSqlQuery query(qdb);
-    if (!query.exec(queryStr)) {
-        qWarning(DBManagerLog) << "Error ejecutando DELETE :" << query.lastError().text();
-        return false;
-    }
-
-    return true;
+    QSharedPointer<QSqlQuery> query = preparedQuery(QString("DELETE FROM %1 WHERE %2 IN (%3)").arg(tableName, BDFilterToString(filtro), simbs.join(",")));
+    return execPrepared(query, valores);
 }
 /**
  * @brief Elimina filas usando múltiples condiciones combinadas.
@@ -665,23 +1011,16 @@ bool DBManager::deleteRow(TypeBDEnum tipo, const QMap<DBFilter, QVariant>& filtr
     if (tableName.isEmpty() || filtros.isEmpty()) return false;
 
     QStringList condiciones;
+    QList<QVariant> valores;
     for (auto it = filtros.constBegin(); it != filtros.constEnd(); ++it) {
         QString colName = BDFilterToString(it.key());
         if (!colName.isEmpty()) {
-            QString cond=QString("%1 = '%2'").arg(colName, it.value().toString().replace("'", "''"));
-            condiciones.append(cond);
+            condiciones.append(colName + " = ?");
+            valores.append(it.value().toString());
         }
     }
 
     QString whereClause = condiciones.join(" AND ");
-    QString queryStr = QString("DELETE FROM %1 WHERE %2").arg(tableName, whereClause);
-
-    QSqlQuery query(qdb);
-    if (!query.exec(queryStr)) {
-        qWarning(DBManagerLog) << "Error ejecutando DELETE:" << queryStr << "::" << query.lastError().text();
-        return false;
-    }
-
-    return true;
+    QSharedPointer<QSqlQuery> query = preparedQuery(QString("DELETE FROM %1 WHERE %2").arg(tableName, whereClause));
+    return execPrepared(query, valores);
 }
-
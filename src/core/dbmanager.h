@@ -20,21 +20,34 @@
 #include <QList>
 #include <QMap>
 #include "db/dbtable.h"
+#include "db/dbwritebatch.h"
+#include "db/dbconnectionpool.h"
+#include "db/dbpagerequest.h"
 #include "enums/TypeBDEnum.h"
 
 #include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QHash>
+#include <QPointer>
+#include <QSharedPointer>
 
 
 #include <QLoggingCategory>
+#include <functional>
 
 Q_DECLARE_LOGGING_CATEGORY(DBManagerLog);
 
+/// Recibe cada bloque de filas de un recorrido; devuelve false para detenerlo.
+using DBChunkVisitor = std::function<bool(const DBTable& chunk)>;
+
 /**
  * @class DBManager
  * @brief Clase responsable de gestionar la conexión y las operaciones de lectura/escritura en una base de datos SQLite.
  *
  * DBManager encapsula el uso de QSqlDatabase, permitiendo realizar operaciones de acceso,
  * actualización, inserción y eliminación sobre las entidades del sistema.
+ * Las sentencias se preparan una sola vez por conexión y se reutilizan enlazando los valores como
+ * parámetros; las columnas de cada tabla se leen al abrir la base de datos y se mantienen en caché.
  * Usa `TypeBDEnum` para abstraer las tablas, y `DBFilter` para aplicar filtros sobre las consultas.
  * Las consultas se devuelven o reciben en formato `DBTable` para facilitar el desacoplamiento del backend.
  */
@@ -47,8 +60,10 @@ public:
      * @brief Constructor principal.
      * @param dbPath Ruta al archivo de base de datos SQLite.
      * @param parent Objeto padre Qt.
+     * @param connectionName Nombre de la conexión Qt SQL. Vacío para usar la conexión por defecto; los
+     * DBManager que trabajan en otro hilo necesitan una conexión propia.
      */
-    explicit DBManager(const QString& dbPath, QObject* parent = nullptr);
+    explicit DBManager(const QString& dbPath, QObject* parent = nullptr, const QString& connectionName = QString());
 
     /**
      * @brief Destructor. Cierra la base de datos si está abierta.
@@ -83,7 +98,7 @@ public:
      * @param listaValores Lista de valores a aplicar con IN.
      * @return DBTable con los resultados.
      */
-    DBTable get(TypeBDEnum tipo, DBFilter filtro, const QStringList& listaValores = {});
+    virtual DBTable get(TypeBDEnum tipo, DBFilter filtro, const QStringList& listaValores = {});
 
     /**
      * @brief Recupera datos usando múltiples condiciones.
@@ -93,6 +108,55 @@ public:
      */
     DBTable get(TypeBDEnum tipo, const QMap<DBFilter, QVariant>& filtros);
 
+    /**
+     * @brief Recorre las filas de una tabla en bloques, sin cargar el resultado completo.
+     *
+     * La consulta se lee hacia delante y el mismo DBTable se reutiliza para cada bloque, así que la memoria no
+     * depende del número de filas. El bloque solo es válido durante la llamada al visitante.
+     * @param tipo Tipo de entidad.
+     * @param filtros Mapa de filtros y sus valores (vacío: todas las filas).
+     * @param visitor Función que recibe cada bloque.
+     * @param chunkSize Filas por bloque.
+     * @return true si la consulta se ejecutó sin errores, aunque el visitante la detuviera.
+     */
+    bool scan(TypeBDEnum tipo, const QMap<DBFilter, QVariant>& filtros, const DBChunkVisitor& visitor,
+              int chunkSize = defaultScanChunk);
+
+    /**
+     * @brief Recorre en bloques el resultado de una consulta SQL con parámetros.
+     * @param sql Consulta con marcadores `?`.
+     * @param valores Valores de los marcadores, en orden.
+     * @param visitor Función que recibe cada bloque.
+     * @param chunkSize Filas por bloque.
+     * @param tableName Nombre que recibe el DBTable de cada bloque.
+     * @return true si la consulta se ejecutó sin errores, aunque el visitante la detuviera.
+     * @see scan
+     */
+    bool scanQuery(const QString& sql, const QList<QVariant>& valores, const DBChunkVisitor& visitor,
+                   int chunkSize = defaultScanChunk, const QString& tableName = "QueryResult");
+
+    static constexpr int defaultScanChunk = 256; ///< Filas por bloque por defecto en scan().
+
+    /**
+     * @brief Recupera una página de una tabla con filtrado y ordenación resueltos en SQL.
+     *
+     * La ordenación siempre termina en la clave primaria, de modo que páginas consecutivas no repiten ni pierden
+     * filas con valores iguales en la columna de orden.
+     * @param peticion Columnas, filtros, orden y ventana de filas.
+     * @return DBTable con las filas de la página; vacío si la petición nombra columnas que no existen.
+     */
+    DBTable getPage(const DBPageRequest& peticion);
+
+    /**
+     * @brief Devuelve un DBTable vacío con el nombre y las columnas de la tabla de un tipo de entidad.
+     *
+     * Las columnas salen de la caché de metadatos (`PRAGMA table_info`), sin leer ninguna fila, y están en el
+     * mismo orden que devuelve `SELECT *`. Es la base para construir los DBTable que se pasan a save().
+     * @param tipo Tipo de entidad.
+     * @return DBTable sin filas; sin columnas si la tabla no existe.
+     */
+    virtual DBTable tableSchema(TypeBDEnum tipo);
+
     /**
      * @brief Guarda datos en la base de datos.
      * @param tipo Tipo de entidad.
@@ -103,6 +167,81 @@ public:
      */
     virtual bool save(TypeBDEnum tipo, DBTable& elem, DBFilter filtro = DBFilter::none, QString valorFiltro = "");
 
+    /**
+     * @brief Inserta o reemplaza todas las filas de un DBTable con sentencias de varias filas.
+     *
+     * Las filas se agrupan en sentencias `REPLACE INTO ... VALUES (...), (...)` del mayor tamaño que permite
+     * el límite de parámetros de SQLite, y todo el bloque se ejecuta en una única transacción (o savepoint).
+     * @param tipo Tipo de entidad.
+     * @param elem Datos a guardar.
+     * @return true si se guardaron todas las filas; si alguna falla no se guarda ninguna.
+     */
+    bool saveBulk(TypeBDEnum tipo, const DBTable& elem);
+
+    /**
+     * @brief Guarda todas las tablas de un lote en una única transacción.
+     * @param batch Lote de escrituras.
+     * @return true si se guardó el lote completo; si alguna tabla falla no se guarda ninguna.
+     */
+    bool writeBatch(const DBWriteBatch& batch);
+
+    /**
+     * @brief Activa el modo WAL en la base de datos.
+     *
+     * Con WAL los lectores no se bloquean mientras otra conexión escribe, y cada commit solo añade páginas
+     * al log en lugar de reescribir la base de datos. El modo queda guardado en el propio archivo.
+     * @return true si el modo WAL quedó activo.
+     */
+    bool enableWriteAheadLog();
+
+    /**
+     * @brief Impide (o vuelve a permitir) las escrituras en esta conexión con `PRAGMA query_only`.
+     * @param readOnly true para que la conexión solo admita lecturas.
+     * @return true si se aplicó correctamente.
+     */
+    bool setReadOnly(bool readOnly);
+
+    /**
+     * @brief Nombre de la conexión Qt SQL que usa este gestor.
+     */
+    QString connectionName() const;
+
+    /**
+     * @brief Asigna el pool del que obtienen su conexión los repositorios usados desde otros hilos.
+     * @param pool Pool de conexiones sobre la misma base de datos.
+     * @see DBHandle
+     */
+    void setConnectionPool(DBConnectionPool* pool);
+
+    /**
+     * @brief Pool de conexiones asignado, o nullptr.
+     */
+    DBConnectionPool* connectionPool() const;
+
+    /**
+     * @brief Abre una transacción, o un savepoint si ya hay una abierta.
+     * @return true si se abrió correctamente.
+     * @see DBTransaction
+     */
+    bool beginTransaction();
+
+    /**
+     * @brief Confirma la transacción o el savepoint más interno.
+     * @return true si se confirmó correctamente.
+     */
+    bool commitTransaction();
+
+    /**
+     * @brief Deshace la transacción o el savepoint más interno.
+     * @return true si se deshizo correctamente.
+     */
+    bool rollbackTransaction();
+
+    /**
+     * @brief Número de transacciones anidadas abiertas (0 si no hay ninguna).
+     */
+    int transactionDepth() const;
+
     /**
      * @brief Elimina una fila con filtro simple.
      * @param tipo Tipo de entidad.
@@ -136,7 +275,30 @@ public:
     bool initializeSchema();
 
     /**
-     * @brief Genera el primer ID disponible no usado en la tabla.
+     * @brief Aplica en orden las migraciones del esquema que aún no se han aplicado.
+     *
+     * Cada migración se ejecuta en su propia transacción junto con la actualización de la versión guardada
+     * en la base de datos, por lo que un fallo deja el esquema en la última versión completa. La versión se
+     * vuelve a leer dentro de la transacción, así que dos procesos que abran a la vez una base de datos antigua
+     * no aplican dos veces la misma migración. Si se aplica alguna, se vuelven a leer las columnas de las tablas.
+     *
+     * openDatabase() no la llama: la ejecuta solo la conexión principal, al crear el esquema o al arrancar la
+     * aplicación, antes de abrir las conexiones del pool.
+     * @return true si el esquema queda en la última versión.
+     * @see dbmigrations.h
+     */
+    bool migrateSchema();
+
+    /**
+     * @brief Versión del esquema guardada en la base de datos (`PRAGMA user_version`).
+     * @return La versión, o -1 si no se pudo leer.
+     */
+    int schemaVersion();
+
+    /**
+     * @brief Genera un ID nuevo para la tabla a partir de su secuencia.
+     *
+     * Coste constante: los IDs se reservan por bloques en la base de datos y se entregan desde memoria.
      * @param tipo Tipo de entidad.
      * @return Un nuevo ID libre, o -1 si hay error.
      */
@@ -148,6 +310,78 @@ public:
 
 private:
     QSqlDatabase qdb;  ///< Conexión a la base de datos SQLite.
+    QString sqlConnectionName; ///< Nombre de la conexión Qt SQL (vacío: conexión por defecto).
+    QPointer<DBConnectionPool> pool; ///< Conexiones para otros hilos (opcional).
+
+    static constexpr int maxCachedStatements = 128; ///< Sentencias preparadas que se conservan como máximo.
+    QHash<QString, QSharedPointer<QSqlQuery>> statementCache; ///< Sentencias preparadas por texto SQL.
+    QHash<QString, QStringList> tableColumns; ///< Columnas por tabla (nombre en minúsculas).
+    int txDepth = 0; ///< Nivel de anidamiento de transacciones.
+
+    /// Rango de IDs reservado en `id_sequence` y aún no entregado: [next, end).
+    struct IdBlock {
+        int next = 0;
+        int end = 0;
+    };
+    static constexpr int idBlockSize = 16; ///< IDs que se reservan en cada acceso a `id_sequence`.
+    QHash<QString, IdBlock> idBlocks;      ///< Bloque de IDs disponible por tabla.
+
+    /**
+     * @brief Descarta el bloque de IDs de la tabla si alguna de las filas a guardar usa uno de sus IDs.
+     * @param tipo Tipo de entidad.
+     * @param elem Filas que se van a guardar.
+     */
+    void releaseIdBlock(TypeBDEnum tipo, const DBTable& elem);
+    static constexpr int maxBoundParameters = 999; ///< Límite de parámetros por sentencia en SQLite.
+
+    /**
+     * @brief Ejecuta una sentencia sin parámetros fuera de la caché de sentencias preparadas.
+     * @param sql Sentencia de control de transacciones (BEGIN, COMMIT, SAVEPOINT...) o de esquema.
+     * @return true si se ejecutó correctamente.
+     */
+    bool execControl(const QString& sql);
+
+    /**
+     * @brief Carga en caché las columnas de todas las tablas de la base de datos.
+     */
+    void loadTableMetadata();
+
+    /**
+     * @brief Lee las columnas de una tabla con `PRAGMA table_info` y las guarda en caché.
+     * @param tableName Nombre de la tabla.
+     * @return Lista de nombres de columnas.
+     */
+    QStringList readTableColumns(const QString& tableName);
+
+    /**
+     * @brief Devuelve la sentencia preparada para un SQL, preparándola si no está en caché.
+     * @param sql Sentencia con marcadores `?`.
+     * @return Consulta preparada, o puntero nulo si hay error. El llamador comparte su propiedad con la caché,
+     * de modo que vaciarla no invalida las sentencias que está usando.
+     */
+    QSharedPointer<QSqlQuery> preparedQuery(const QString& sql);
+
+    /**
+     * @brief Enlaza los valores por posición y ejecuta una sentencia preparada.
+     * @param query Sentencia preparada.
+     * @param valores Valores de los marcadores.
+     * @return true si se ejecutó correctamente.
+     */
+    bool execPrepared(QSqlQuery* query, const QList<QVariant>& valores);
+    bool execPrepared(const QSharedPointer<QSqlQuery>& query, const QList<QVariant>& valores);
+
+    /**
+     * @brief Convierte el resultado de una consulta ejecutada en un DBTable y cierra su cursor.
+     * @param query Consulta ejecutada.
+     * @param tableName Nombre del DBTable resultante.
+     * @return DBTable con los resultados.
+     */
+    DBTable readRows(QSqlQuery& query, const QString& tableName);
+
+    /**
+     * @brief Libera todas las sentencias preparadas.
+     */
+    void clearStatementCache();
 
     /**
      * @brief Devuelve las columnas de una tabla SQLite.
@@ -164,6 +398,14 @@ private:
      */
     bool isValidFilterForTable(const QString& tableName, DBFilter filtro);
 
+    /**
+     * @brief Construye la cláusula WHERE de un conjunto de filtros.
+     * @param filtros Mapa de filtros y sus valores.
+     * @param valores Recibe los valores de los marcadores, en orden.
+     * @return Cláusula `WHERE ...`, o vacía si no hay filtros.
+     */
+    QString whereClause(const QMap<DBFilter, QVariant>& filtros, QList<QVariant>& valores) const;
+
     /**
      * @brief Ejecuta una consulta SQL libre y devuelve los resultados como DBTable.
      * @param query Cadena SQL.
@@ -1,118 +1,145 @@
 #include "core/metricsmanager.h"
+#include <algorithm>
 
 MetricsManager::MetricsManager() {}
 
 void MetricsManager::setReport(const SesionReport& report) {
     this->report = report;
+    buildCube();
 }
-QHash<ConditionType, int> MetricsManager::getGlobalConditionCounts()  {
-    QHash<ConditionType, int> counts;
 
-    QHash<int, QHash<int, QHash<int, QHash<Condition, int> >>> series = report.getSeriesData();
+/*!
+ * \brief Recorre el agregado del reporte una sola vez y genera el cubo ordenado y sus índices.
+ */
+void MetricsManager::buildCube()
+{
+    cube.clear();
+    lineNames.clear();
+    serieRanges.clear();
+    repRanges.clear();
+    globalCounts.clear();
 
-    for (auto itSerie = series.begin(); itSerie != series.end(); ++itSerie) {
+    QHash<QString, int> lineIds;
+    const auto series = report.getSeriesData();
 
+    for (auto itSerie = series.begin(); itSerie != series.end(); ++itSerie) {
         for (auto itRep = itSerie.value().begin(); itRep != itSerie.value().end(); ++itRep) {
             for (auto itState = itRep.value().begin(); itState != itRep.value().end(); ++itState) {
-
                 for (auto itCond = itState.value().begin(); itCond != itState.value().end(); ++itCond) {
+                    const Condition& cond = itCond.key();
+
+                    auto itLine = lineIds.constFind(cond.keypointLine);
+                    if (itLine == lineIds.constEnd()) {
+                        itLine = lineIds.insert(cond.keypointLine, lineNames.size());
+                        lineNames.append(cond.keypointLine);
+                    }
 
-                    ConditionType tipo=itCond.key().type;
-                    counts[tipo] += itCond.value();
+                    cube.push_back({itSerie.key(), itRep.key(), itState.key(), cond.type,
+                                    itLine.value(), cond.view, itCond.value(), cond.value});
+                    globalCounts[cond.type] += itCond.value();
                 }
             }
         }
     }
-    return counts;
-}
 
-QHash<int, QHash<ConditionType, int>> MetricsManager::getConditionCountsBySerie() {
-    QHash<int, QHash<ConditionType, int>> result;
+    std::stable_sort(cube.begin(), cube.end(), [](const CubeCell& a, const CubeCell& b) {
+        if (a.serie != b.serie) return a.serie < b.serie;
+        if (a.rep != b.rep) return a.rep < b.rep;
+        return a.state < b.state;
+    });
+
+    for (int i = 0; i < static_cast<int>(cube.size()); ++i) {
+        const CubeCell& c = cube[i];
+
+        auto itSerie = serieRanges.find(c.serie);
+        if (itSerie == serieRanges.end()) serieRanges.insert(c.serie, Range(i, i + 1));
+        else itSerie.value().second = i + 1;
 
-    QHash<int, QHash<int, QHash<int, QHash<Condition, int> >>> series = report.getSeriesData();
+        Range& rep = repRanges[c.serie][c.rep];
+        if (rep.first == rep.second) rep.first = i;
+        rep.second = i + 1;
+    }
 
+    // Las repeticiones sin condiciones también se listan en las consultas por serie
     for (auto itSerie = series.begin(); itSerie != series.end(); ++itSerie) {
-        int serie = itSerie.key();
-        for (auto itRep = itSerie.value().begin(); itRep != itSerie.value().end(); ++itRep) {
-            for (auto itState = itRep.value().begin(); itState != itRep.value().end(); ++itState) {
-                for (auto itCond = itState.value().begin(); itCond != itState.value().end(); ++itCond) {
-                    result[serie][itCond.key().type] += itCond.value();
-                }
-            }
-        }
+        serieRanges.insert(itSerie.key(), serieRanges.value(itSerie.key(), Range(0, 0)));
+        for (auto itRep = itSerie.value().begin(); itRep != itSerie.value().end(); ++itRep)
+            repRanges[itSerie.key()].insert(itRep.key(), repRanges[itSerie.key()].value(itRep.key(), Range(0, 0)));
     }
+}
+
+MetricsManager::Range MetricsManager::serieRange(int serie) const
+{
+    return serieRanges.value(serie, Range(0, 0));
+}
+
+QHash<ConditionType, int> MetricsManager::getGlobalConditionCounts() const {
+    return globalCounts;
+}
+
+QHash<PoseView, QHash<ConditionType, int>> MetricsManager::getConditionCountsByView() const {
+    QHash<PoseView, QHash<ConditionType, int>> result;
+
+    for (const CubeCell& c : cube)
+        result[c.view][c.type] += c.count;
 
     return result;
 }
 
-QHash<int, QHash<ConditionType, int>> MetricsManager::getConditionCountsByRepetition(int serie) {
+QHash<int, QHash<ConditionType, int>> MetricsManager::getConditionCountsBySerie() const {
+    QHash<int, QHash<ConditionType, int>> result;
+
+    for (const CubeCell& c : cube)
+        result[c.serie][c.type] += c.count;
+
+    return result;
+}
+
+QHash<int, QHash<ConditionType, int>> MetricsManager::getConditionCountsByRepetition(int serie) const {
 
     QHash<int, QHash<ConditionType, int>> result;
-     QHash<int, QHash<int, QHash<int, QHash<Condition, int> >>> series = report.getSeriesData();
-      QHash<int,QHash<int, QHash<Condition, int>>> reps = series.value(serie);
+    const Range range = serieRange(serie);
 
-    for (auto itRep = reps.begin(); itRep != reps.end(); ++itRep) {
-        int rep = itRep.key();
-        for (auto itState = itRep.value().begin(); itState != itRep.value().end(); ++itState) {
-            for (auto itCond = itState.value().begin(); itCond != itState.value().end(); ++itCond) {
-                 ConditionType tipo=itCond.key().type;
-                result[rep][tipo] += itCond.value();
-            }
-        }
+    for (int i = range.first; i < range.second; ++i) {
+        const CubeCell& c = cube[i];
+        result[c.rep][c.type] += c.count;
     }
 
     return result;
 }
 
-QHash<QString, QHash<ConditionType, int>> MetricsManager::getCountsPerKeypointLine(int serie, int rep) {
-  QHash<QString, QHash<ConditionType, int>>  result;
-    QHash<int, QHash<int, QHash<int, QHash<Condition, int> >>> series = report.getSeriesData();
-    QHash<int,QHash<int, QHash<Condition, int>>> reps = series.value(serie);
-    QHash<int, QHash<Condition, int>> stateData = reps.value(rep);
-
-    for (auto itState = stateData.begin(); itState != stateData.end(); ++itState) {
-        for (auto itCond = itState.value().begin(); itCond != itState.value().end(); ++itCond) {
-               ConditionType tipo=itCond.key().type;
-            Condition cond = itCond.key();
+QHash<QString, QHash<ConditionType, int>> MetricsManager::getCountsPerKeypointLine(int serie, int rep) const {
+    QHash<QString, QHash<ConditionType, int>>  result;
+    const Range range = repRanges.value(serie).value(rep, Range(0, 0));
 
-            result[cond.keypointLine][tipo] += itCond.value();
-        }
+    for (int i = range.first; i < range.second; ++i) {
+        const CubeCell& c = cube[i];
+        result[lineNames[c.lineId]][c.type] += c.count;
     }
 
     return result;
 }
 
 
-SesionReport MetricsManager::getReport()
+const SesionReport& MetricsManager::getReport() const
 {
     return report;
 }
 
 
-QMap<ConditionType, QMap<QString, int>> MetricsManager::getHeatmapData(int serie) {
+QMap<ConditionType, QMap<QString, int>> MetricsManager::getHeatmapData(int serie) const {
     QMap<ConditionType, QMap<QString, int>> result;
-    QHash<int, QHash<int, QHash<int, QHash<Condition, int>>>> series = report.getSeriesData();
-    QHash<int, QHash<int, QHash<Condition, int>>> reps = series.value(serie);
+    const Range range = serieRange(serie);
 
-    for (auto itRep = reps.begin(); itRep != reps.end(); ++itRep) {
-        int rep = itRep.key();
-        QHash<int, QHash<Condition, int>> states = itRep.value();
-
-        for (auto itState = states.begin(); itState != states.end(); ++itState) {
-            int state = itState.key();
-            QHash<Condition, int> conditions = itState.value();
+    for (int i = range.first; i < range.second; ++i) {
+        const CubeCell& c = cube[i];
 
-            // Rellenar con ceros para asegurar orden lexicográfico correcto
-            QString key = QString("Rep%1_S%2")
-                              .arg(rep, 2, 10, QChar('0'))
-                              .arg(state, 2, 10, QChar('0'));
+        // Rellenar con ceros para asegurar orden lexicográfico correcto
+        QString key = QString("Rep%1_S%2")
+                          .arg(c.rep, 2, 10, QChar('0'))
+                          .arg(c.state, 2, 10, QChar('0'));
 
-            for (auto itCond = conditions.begin(); itCond != conditions.end(); ++itCond) {
-                Condition cond = itCond.key();
-                int count = itCond.value();
-                result[cond.type][key] += count;
-            }
-        }
+        result[c.type][key] += c.count;
     }
 
     return result;
@@ -120,39 +147,32 @@ QMap<ConditionType, QMap<QString, int>> MetricsManager::getHeatmapData(int serie
 
 
 
-QList<int> MetricsManager::getAvailableSeries() {
-    return report.getSeriesData().keys();
+QList<int> MetricsManager::getAvailableSeries() const {
+    return serieRanges.keys();
 }
 
 
 
-QList<QList<QPair<QString, int>>> MetricsManager::getSegments(int serie) {
+QList<QList<QPair<QString, int>>> MetricsManager::getSegments(int serie) const {
 
     QList<QList<QPair<QString, int>>> result;
-
-    QHash<int, QHash<int, QHash<int, QHash<Condition, int> >>> series = report.getSeriesData();
-    QHash<int,QHash<int, QHash<Condition, int>>> reps = series.value(serie);
+    const QMap<int, Range> reps = repRanges.value(serie);
 
     for (auto itRep = reps.begin(); itRep != reps.end(); ++itRep) {
         QList<QPair<QString, int>> repSegments;
-          QHash<int, QHash<Condition, int> > states = itRep.value();
 
-        for (auto itState = states.begin(); itState != states.end(); ++itState) {
-             QHash<Condition, int> condMap = itState.value();
+        for (int i = itRep.value().first; i < itRep.value().second; ++i) {
+            const CubeCell& c = cube[i];
 
-            for (auto itCond = condMap.begin(); itCond != condMap.end(); ++itCond) {
-                 Condition cond = itCond.key();
-
-                if (cond.type == ConditionType::EndOfMovementPhase) {
-                    QString label = QString("Estado %1").arg(cond.keypointLine);
-                    repSegments.append(qMakePair(label, cond.value.toInt()));
-                }
-                else if (cond.type == ConditionType::SetTime) {
-                    repSegments.append(qMakePair(QString("SetTimeOver"), cond.value.toInt()));
-                }
-                else if (cond.type == ConditionType::RestOverTime) {
-                    repSegments.append(qMakePair(QString("RestOverTime"), cond.value.toInt()));
-                }
+            if (c.type == ConditionType::EndOfMovementPhase) {
+                QString label = QString("Estado %1").arg(lineNames[c.lineId]);
+                repSegments.append(qMakePair(label, c.value.toInt()));
+            }
+            else if (c.type == ConditionType::SetTime) {
+                repSegments.append(qMakePair(QString("SetTimeOver"), c.value.toInt()));
+            }
+            else if (c.type == ConditionType::RestOverTime) {
+                repSegments.append(qMakePair(QString("RestOverTime"), c.value.toInt()));
             }
         }
 
@@ -161,7 +181,7 @@ QList<QList<QPair<QString, int>>> MetricsManager::getSegments(int serie) {
 
     return result;
 }
-QList<QList<QVariant>> MetricsManager::getSerieConditionDistribution(int serie) {
+QList<QList<QVariant>> MetricsManager::getSerieConditionDistribution(int serie) const {
     QList<QList<QVariant>> result;
 
     QHash<int, QHash<ConditionType, int>> repData = getConditionCountsByRepetition(serie);
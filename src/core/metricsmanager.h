@@ -6,7 +6,17 @@
 #include <QString>
 #include <QMap>
 #include <QSet>
+#include <vector>
 
+/*!
+ * \class MetricsManager
+ * \brief Calcula las métricas de una sesión a partir de su reporte.
+ *
+ * Al asignar el reporte se construye una única vez un cubo de agregados
+ * (tipo × serie × repetición × estado × línea × vista) ordenado por serie, repetición y estado, junto con
+ * los rangos de cada serie y repetición dentro de él. Cada consulta recorre solo el tramo que le
+ * corresponde, sin copiar el reporte.
+ */
 class MetricsManager
 {
 public:
@@ -16,20 +26,43 @@ public:
 
 
 
-    QHash<ConditionType, int> getGlobalConditionCounts();
-    QHash<PoseView, QHash<ConditionType, int> > getConditionCountsByView();
-    QHash<int, QHash<ConditionType, int> > getConditionCountsBySerie();
-    QHash<int, QHash<ConditionType, int> > getConditionCountsByRepetition(int serie);
-    QHash<QString, QHash<ConditionType, int> > getCountsPerKeypointLine(int serie, int rep);
-    SesionReport getReport();
-    QList<QList<QVariant>> getSerieConditionDistribution(int serie);
-    QMap<ConditionType, QMap<QString, int> > getHeatmapData(int serie);
-    QList<int> getAvailableSeries();
-    QList<QList<QPair<QString, int>>> getSegments(int serie);
+    QHash<ConditionType, int> getGlobalConditionCounts() const;
+    QHash<PoseView, QHash<ConditionType, int> > getConditionCountsByView() const;
+    QHash<int, QHash<ConditionType, int> > getConditionCountsBySerie() const;
+    QHash<int, QHash<ConditionType, int> > getConditionCountsByRepetition(int serie) const;
+    QHash<QString, QHash<ConditionType, int> > getCountsPerKeypointLine(int serie, int rep) const;
+    const SesionReport& getReport() const;
+    QList<QList<QVariant>> getSerieConditionDistribution(int serie) const;
+    QMap<ConditionType, QMap<QString, int> > getHeatmapData(int serie) const;
+    QList<int> getAvailableSeries() const;
+    QList<QList<QPair<QString, int>>> getSegments(int serie) const;
 
 
 private:
+    /// Celda del cubo: una condición agregada con su número de ocurrencias.
+    struct CubeCell {
+        int serie;
+        int rep;
+        int state;
+        ConditionType type;
+        int lineId;
+        PoseView view;
+        int count;
+        QVariant value;
+    };
+
+    /// Tramo [first, last) de celdas del cubo.
+    using Range = QPair<int, int>;
+
     SesionReport report;
+    std::vector<CubeCell> cube;            //!< Celdas ordenadas por serie, repetición y estado.
+    QStringList lineNames;                 //!< Diccionario de líneas de las celdas.
+    QMap<int, Range> serieRanges;          //!< Tramo de cada serie.
+    QMap<int, QMap<int, Range>> repRanges; //!< Tramo de cada repetición por serie.
+    QHash<ConditionType, int> globalCounts;
+
+    void buildCube();
+    Range serieRange(int serie) const;
 };
 
 #endif // METRICSMANAGER_H
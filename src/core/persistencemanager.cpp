@@ -0,0 +1,118 @@
+/**
+ * @file persistencemanager.cpp
+ * @brief Implementación de la clase PersistenceManager.
+ */
+
+#include "persistencemanager.h"
+#include "persistenceworker.h"
+#include <QDateTime>
+#include <QFile>
+#include <QSaveFile>
+
+namespace {
+const char* kJournalSuffix = ".batch";
+}
+
+/**
+ * @brief Crea el worker, lo mueve al hilo de escritura y conecta las señales en ambos sentidos.
+ */
+PersistenceManager::PersistenceManager(const QString& dbPath, const QString& journalPath, QObject* parent)
+    : QObject(parent),
+    journal(journalPath)
+{
+    qRegisterMetaType<DBWriteBatch>("DBWriteBatch");
+    if (!journal.exists()) journal.mkpath(".");
+
+    worker = new PersistenceWorker(dbPath, QString("persistence_%1").arg(quintptr(this)));
+    worker->moveToThread(&thread);
+    thread.setObjectName("PersistenceThread");
+
+    connect(this, &PersistenceManager::writeRequested, worker, &PersistenceWorker::write, Qt::QueuedConnection);
+    connect(worker, &PersistenceWorker::written, this, &PersistenceManager::onWritten, Qt::QueuedConnection);
+    connect(worker, &PersistenceWorker::failed, this, &PersistenceManager::onFailed, Qt::QueuedConnection);
+
+    thread.start();
+    QMetaObject::invokeMethod(worker, &PersistenceWorker::open, Qt::QueuedConnection);
+}
+
+/**
+ * @brief El cierre de la conexión y la parada del hilo se encolan detrás de los lotes pendientes, de modo que
+ * estos se guardan antes de salir. Lo que no llegue a guardarse sigue en el diario.
+ */
+PersistenceManager::~PersistenceManager()
+{
+    QMetaObject::invokeMethod(worker, &PersistenceWorker::close, Qt::QueuedConnection);
+    QMetaObject::invokeMethod(worker, [this]() { thread.quit(); }, Qt::QueuedConnection);
+    thread.wait();
+    delete worker;
+}
+
+/**
+ * @brief Los identificadores empiezan por la hora en milisegundos, de modo que el orden alfabético del
+ * diario coincide con el orden en que se encolaron los lotes.
+ */
+bool PersistenceManager::enqueue(DBWriteBatch batch)
+{
+    if (batch.id.isEmpty())
+        batch.id = QString("%1-%2").arg(QDateTime::currentMSecsSinceEpoch()).arg(++sequence, 6, 10, QChar('0'));
+
+    QSaveFile file(journalFile(batch.id));
+    if (!file.open(QIODevice::WriteOnly) || file.write(batch.toBinary()) < 0 || !file.commit()) {
+        QString error = QString("No se pudo registrar %1 en el diario de escrituras").arg(batch.description);
+        qWarning(PersistenceLog) << error << file.errorString();
+        emit ui_errorMessage(error, QtMsgType::QtWarningMsg);
+        return false;
+    }
+
+    pending.insert(batch.id);
+    emit writeRequested(batch);
+    return true;
+}
+
+int PersistenceManager::replayJournal()
+{
+    int count = 0;
+    const QStringList entries = journal.entryList({QString("*") + kJournalSuffix}, QDir::Files, QDir::Name);
+    for (const QString& entry : entries) {
+        QFile file(journal.filePath(entry));
+        DBWriteBatch batch;
+        if (!file.open(QIODevice::ReadOnly) || !batch.fromBinary(file.readAll())) {
+            qWarning(PersistenceLog) << "Entrada del diario ilegible, se descarta:" << entry;
+            file.close();
+            file.rename(file.fileName() + ".bad");
+            continue;
+        }
+        if (pending.contains(batch.id)) continue;
+
+        qDebug(PersistenceLog) << "Recuperando del diario el lote" << batch.id << batch.description;
+        pending.insert(batch.id);
+        emit writeRequested(batch);
+        ++count;
+    }
+    return count;
+}
+
+int PersistenceManager::pendingCount() const
+{
+    return pending.size();
+}
+
+void PersistenceManager::onWritten(const QString& id)
+{
+    pending.remove(id);
+    QFile::remove(journalFile(id));
+    emit batchWritten(id);
+}
+
+void PersistenceManager::onFailed(const QString& id, const QString& error)
+{
+    pending.remove(id);
+    qWarning(PersistenceLog) << error << "- se reintentará en el próximo arranque";
+    emit batchFailed(id, error);
+    emit ui_errorMessage(error, QtMsgType::QtWarningMsg);
+}
+
+QString PersistenceManager::journalFile(const QString& id) const
+{
+    return journal.filePath(id + kJournalSuffix);
+}
@@ -0,0 +1,100 @@
+/**
+ * @file persistencemanager.h
+ * @brief Declaración de la clase PersistenceManager, cola de escrituras diferidas a la base de datos.
+ */
+
+#ifndef PERSISTENCEMANAGER_H
+#define PERSISTENCEMANAGER_H
+
+#include <QObject>
+#include <QDir>
+#include <QSet>
+#include <QThread>
+#include "db/dbwritebatch.h"
+
+class PersistenceWorker;
+
+/**
+ * @class PersistenceManager
+ * @brief Envía lotes de escritura a un hilo dedicado para que el hilo de la interfaz no espere a la base de datos.
+ *
+ * Antes de encolar un lote se escribe como entrada en un diario en disco (un archivo por lote, guardado de forma
+ * atómica con QSaveFile), y la entrada se borra cuando el lote se ha confirmado en la base de datos. Si la
+ * aplicación termina con lotes pendientes, o un lote falla, su entrada permanece y se vuelve a enviar con
+ * replayJournal() en el siguiente arranque; como los lotes llevan sus claves, guardarlos dos veces no duplica
+ * filas.
+ */
+class PersistenceManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor. Arranca el hilo de escritura y abre en él su conexión.
+     * @param dbPath Ruta al archivo de base de datos SQLite.
+     * @param journalPath Directorio del diario de escrituras pendientes.
+     * @param parent Objeto Qt padre.
+     */
+    explicit PersistenceManager(const QString& dbPath, const QString& journalPath, QObject* parent = nullptr);
+
+    /**
+     * @brief Destructor. Espera a que se guarden los lotes ya encolados y detiene el hilo.
+     */
+    ~PersistenceManager();
+
+    /**
+     * @brief Registra el lote en el diario y lo encola para guardarlo en segundo plano.
+     * @param batch Lote a guardar. Si no tiene identificador se le asigna uno.
+     * @return false si no se pudo escribir la entrada del diario (el lote no se encola).
+     */
+    bool enqueue(DBWriteBatch batch);
+
+    /**
+     * @brief Vuelve a encolar los lotes que quedaron en el diario sin confirmar.
+     * @return Número de lotes encolados.
+     */
+    int replayJournal();
+
+    /**
+     * @brief Número de lotes encolados que aún no se han guardado.
+     */
+    int pendingCount() const;
+
+signals:
+    /**
+     * @brief Se emite cuando un lote se ha guardado en la base de datos.
+     * @param id Identificador del lote.
+     */
+    void batchWritten(const QString& id);
+
+    /**
+     * @brief Se emite cuando un lote no se ha podido guardar. Su entrada del diario se conserva.
+     * @param id Identificador del lote.
+     * @param error Descripción del error.
+     */
+    void batchFailed(const QString& id, const QString& error);
+
+    /**
+     * @brief Mensaje de error para mostrar en la interfaz.
+     */
+    void ui_errorMessage(const QString& msg, QtMsgType type = QtWarningMsg);
+
+    /// Señal interna: entrega un lote al worker mediante una conexión encolada.
+    void writeRequested(const DBWriteBatch& batch);
+
+private slots:
+    void onWritten(const QString& id);
+    void onFailed(const QString& id, const QString& error);
+
+private:
+    QDir journal;                 ///< Directorio del diario.
+    QThread thread;               ///< Hilo de escritura.
+    PersistenceWorker* worker;    ///< Worker que vive en `thread`.
+    QSet<QString> pending;        ///< Lotes encolados y aún no confirmados.
+    quint32 sequence = 0;         ///< Contador para generar identificadores de lote ordenados.
+
+    /// Ruta de la entrada del diario de un lote.
+    QString journalFile(const QString& id) const;
+};
+
+#endif // PERSISTENCEMANAGER_H
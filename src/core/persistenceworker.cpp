@@ -0,0 +1,52 @@
+/**
+ * @file persistenceworker.cpp
+ * @brief Implementación de la clase PersistenceWorker.
+ */
+#include "persistenceworker.h"
+#include "core/dbmanager.h"
+#include <QSqlDatabase>
+
+Q_LOGGING_CATEGORY(PersistenceLog, "Persistence")
+
+PersistenceWorker::PersistenceWorker(const QString& dbPath, const QString& connectionName, QObject* parent)
+    : QObject(parent),
+    dbPath(dbPath),
+    connectionName(connectionName)
+{
+}
+
+PersistenceWorker::~PersistenceWorker()
+{
+    if (db) qWarning(PersistenceLog) << "PersistenceWorker destruido con la conexión abierta";
+}
+
+/**
+ * @brief El DBManager se crea aquí, y no en el constructor, para que su conexión pertenezca al hilo del worker.
+ */
+void PersistenceWorker::open()
+{
+    if (db) return;
+    db = new DBManager(dbPath, this, connectionName);
+    db->enableWriteAheadLog();
+}
+
+void PersistenceWorker::write(const DBWriteBatch& batch)
+{
+    if (!db) open();
+
+    if (db->writeBatch(batch)) {
+        qDebug(PersistenceLog) << "Guardado el lote" << batch.id << batch.description;
+        emit written(batch.id);
+    } else {
+        emit failed(batch.id, QString("No se pudo guardar %1 en la base de datos").arg(batch.description));
+    }
+}
+
+void PersistenceWorker::close()
+{
+    if (!db) return;
+    delete db;
+    db = nullptr;
+    // La conexión solo se puede eliminar cuando ya no queda ningún QSqlDatabase que la use
+    QSqlDatabase::removeDatabase(connectionName);
+}
@@ -0,0 +1,80 @@
+/**
+ * @file persistenceworker.h
+ * @brief Declaración de la clase PersistenceWorker, que guarda lotes de escritura en un hilo propio.
+ */
+#ifndef PERSISTENCEWORKER_H
+#define PERSISTENCEWORKER_H
+
+#include <QObject>
+#include <QString>
+#include <QLoggingCategory>
+#include "db/dbwritebatch.h"
+
+class DBManager;
+
+Q_DECLARE_LOGGING_CATEGORY(PersistenceLog)
+
+/**
+ * @class PersistenceWorker
+ * @brief Objeto que escribe lotes de DBWriteBatch en la base de datos desde un hilo dedicado.
+ *
+ * Se mueve a un QThread propiedad de PersistenceManager y todos sus slots se invocan mediante conexiones
+ * encoladas, por lo que se ejecutan en ese hilo y en el orden en que se pidieron. Usa su propia conexión
+ * SQLite (en modo WAL), independiente de la del hilo de la interfaz.
+ */
+class PersistenceWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor. La conexión no se abre hasta llamar a open() desde el hilo del worker.
+     * @param dbPath Ruta al archivo de base de datos SQLite.
+     * @param connectionName Nombre de la conexión Qt SQL propia del worker.
+     * @param parent Objeto Qt padre.
+     */
+    explicit PersistenceWorker(const QString& dbPath, const QString& connectionName, QObject* parent = nullptr);
+
+    /**
+     * @brief Destructor. La conexión debe haberse cerrado antes con close().
+     */
+    ~PersistenceWorker();
+
+public slots:
+    /**
+     * @brief Abre la conexión del worker y activa el modo WAL.
+     */
+    void open();
+
+    /**
+     * @brief Guarda un lote en una única transacción y notifica el resultado.
+     * @param batch Lote a guardar.
+     */
+    void write(const DBWriteBatch& batch);
+
+    /**
+     * @brief Cierra la conexión del worker y la elimina del registro de conexiones de Qt.
+     */
+    void close();
+
+signals:
+    /**
+     * @brief Se emite cuando un lote se ha confirmado en la base de datos.
+     * @param id Identificador del lote.
+     */
+    void written(const QString& id);
+
+    /**
+     * @brief Se emite cuando un lote no se ha podido guardar.
+     * @param id Identificador del lote.
+     * @param error Descripción del error.
+     */
+    void failed(const QString& id, const QString& error);
+
+private:
+    QString dbPath;           ///< Ruta al archivo de base de datos.
+    QString connectionName;   ///< Nombre de la conexión propia.
+    DBManager* db = nullptr;  ///< Gestor de base de datos del hilo del worker.
+};
+
+#endif // PERSISTENCEWORKER_H
@@ -411,6 +411,8 @@ void PoseManager::init(QSharedPointer<TrainingSesion> sesion, QSharedPointer<Exe
     //dualMode = dual;
     runningSesion = sesion;
     poseAnalyzer = QSharedPointer<StateMachine>::create(espec);
+    feedbackAggregator.reset();
+    messageTable = QSharedPointer<const FeedbackMessageTable>::create(poseAnalyzer->getLines());
     running = true;
     runningAnalysis=false;
 
@@ -544,9 +546,13 @@ void PoseManager::processNextFrame()
     // El análisis lo ejcutaremos sólo si hay al menos unos datos válidos en alguna de las vistas
     //y si hemos notificado que estamos listos
     if (runningAnalysis && !anglesByView.isEmpty()) {
-        FeedBack feedback(poseAnalyzer->run(anglesByView, timestamp));
-        emit feedbackGenerated(feedback);
-        qDebug(PoseManagerLog) << "FeedBack emitido";
+        // Solo se notifica a la interfaz cuando cambia el conjunto de condiciones activas; las liberaciones
+        // también se notifican para que la interfaz cierre el intervalo de la condición
+        FeedbackDelta delta = feedbackAggregator.update(poseAnalyzer->run(anglesByView, timestamp), timestamp);
+        if (!delta.isEmpty()) {
+            emit feedbackGenerated(FeedBack(delta.onsets, feedbackAggregator.getActive(), messageTable, timestamp));
+            qDebug(PoseManagerLog) << "FeedBack emitido";
+        }
     }
 
     if (poseAnalyzer->isComplete()) {
@@ -697,6 +703,7 @@ void PoseManager::newSerie() {
 
     // Reinicia estado y contadores para forzar una nueva serie
     poseAnalyzer->newSerie();
+    feedbackAggregator.reset();
 }
 
 /**
@@ -22,6 +22,7 @@
 #include "pose/pose.h"
 #include "pose/statemachine.h"
 #include "pose/feedback.h"
+#include "pose/feedbackaggregator.h"
 #include <QDateTime>
 #include <qthread.h>
 #include <fstream>
@@ -168,6 +169,8 @@ private:
 
     QSharedPointer<TrainingSesion> runningSesion;
     QSharedPointer<StateMachine> poseAnalyzer;
+    FeedbackAggregator feedbackAggregator; ///< Reduce las condiciones de cada frame a activaciones y liberaciones.
+    QSharedPointer<const FeedbackMessageTable> messageTable; ///< Mensajes de feedback resueltos para el ejercicio en curso.
 
     // --- Test Mode ---
     bool testMode = false;
@@ -16,10 +16,9 @@ SoundFeedbackManager::SoundFeedbackManager(QObject *parent)
     soundPath = QCoreApplication::applicationDirPath() + "/sounds/";
     loadSounds();
 
-    soundTimer = new QTimer(this);
-    connect(soundTimer, &QTimer::timeout, this, &SoundFeedbackManager::checkAndPlayNext);
-    soundTimer->start(250);
-
+    // Los avisos críticos se repiten antes que el resto
+    setCooldown(ConditionType::JointOverload, 1000);
+    clock.start();
 }
 /**
  * @brief Asocia un archivo de sonido con un tipo de condición.
@@ -42,6 +41,7 @@ void SoundFeedbackManager::addSound(ConditionType type, const QString &path)
     connect(effect, &QSoundEffect::statusChanged, this, [=]() {
         onSoundStatusChanged(effect, path);
     });
+    connect(effect, &QSoundEffect::playingChanged, this, &SoundFeedbackManager::onSoundFinished);
 
     soundMap.insert(type, effect);
 }
@@ -112,100 +112,121 @@ void SoundFeedbackManager::loadSounds()
 
 
 
-void SoundFeedbackManager::addtoSoundList(ConditionType cond, ConditionCategory catCond){
-
-    int firstInfo = -1;
-    int firstAlert = -1;
-    int firstCritical = -1;
-    QSoundEffect* effect = soundMap.value(cond);
-
-    // if (QDateTime::currentMSecsSinceEpoch() - lastPlayTimestamp < 2000)
-    //     return;
-
-    if (!effect || !effect->isLoaded()) return;
-    for (const auto& pair : soundQueue) {
-        if (pair.first == effect)
-            return;
+int SoundFeedbackManager::categoryIndex(ConditionCategory category)
+{
+    switch (category) {
+    case ConditionCategory::critical: return 0;
+    case ConditionCategory::alert: return 1;
+    case ConditionCategory::info: return 2;
+    default: return -1;
     }
+}
 
-    // Si hay espacio, se agrega al final
-    if (soundQueue.size() < 5) {
-        soundQueue.append(QPair(effect,catCond));
-        return;
+bool SoundFeedbackManager::isCategoryEnabled(ConditionCategory category) const
+{
+    switch (category) {
+    case ConditionCategory::critical: return criticaSoundEnable;
+    case ConditionCategory::alert: return alertSoundEnabled;
+    case ConditionCategory::info: return infoSoundEnable;
+    default: return false;
     }
+}
 
-    // for (int i = 0; i < soundQueue.size(); ++i) {
-    //     ConditionType t = soundMap.key(soundQueue[i].first);
-    //     ConditionCategory cat = soundQueue[i].second;
+void SoundFeedbackManager::setCooldown(ConditionType type, int cooldownMs)
+{
+    cooldowns.insert(type, qMax(cooldownMs, 0));
+}
 
-    //     if (cat == ConditionCategory::info && firstInfo == -1)
-    //         firstInfo = i;
-    //     else if (cat == ConditionCategory::alert && firstAlert == -1)
-    //         firstAlert = i;
-    //     else if (cat == ConditionCategory::critical && firstCritical == -1)
-    //         firstCritical = i;
-    // }
+/**
+ * @brief Encola el sonido en su severidad y, si procede, lo reproduce sin esperar: inmediatamente si no suena
+ * nada, o interrumpiendo el sonido en curso si el nuevo es crítico y el actual no.
+ */
+void SoundFeedbackManager::addtoSoundList(ConditionType cond, ConditionCategory catCond){
 
+    const int category = categoryIndex(catCond);
+    if (category < 0 || !isCategoryEnabled(catCond)) return;
 
-    // // una vez vista la posicion reemplazamos el sonido por el nuevo
-    // if (catCond == ConditionCategory::alert) {
-    //     if (firstInfo != -1)
-    //         soundQueue[firstInfo] = QPair(effect,ConditionCategory::alert);
-    //     else if (firstAlert != -1)
-    //         soundQueue[firstAlert] = QPair(effect,ConditionCategory::alert);
-    //     else if (firstCritical != -1) {
-    //         soundQueue.removeAt(firstCritical);
-    //         soundQueue.append(QPair(effect,ConditionCategory::alert));
-    //     }
-    // } else if (catCond == ConditionCategory::critical) {
-    //     if (firstInfo != -1)
+    QSoundEffect* effect = soundMap.value(cond);
+    if (!effect || !effect->isLoaded()) return;
 
-    //     soundQueue[firstInfo] = QPair(effect,ConditionCategory::critical);
-    //     else if (firstAlert != -1)
-    //         soundQueue[firstAlert] = QPair(effect,ConditionCategory::critical);
-    //     else if (firstCritical != -1) {
+    const qint64 now = clock.elapsed();
+    auto last = lastPlayed.constFind(cond);
+    if (last != lastPlayed.constEnd() && now - last.value() < cooldowns.value(cond, minDelayMs))
+        return;
 
-    //         soundQueue.removeAt(firstCritical);
-    //         soundQueue.append(QPair(effect,ConditionCategory::critical));
-    //     }
-   //}
+    QQueue<QueuedSound>& queue = soundQueues[category];
+    for (const QueuedSound& queued : queue) {
+        if (queued.type == cond) return;
+    }
+    if (queue.size() >= maxQueuePerCategory)
+        queue.dequeue();
+    queue.enqueue({cond, now});
 
+    if (isPlaying && category == 0 && currentCategory > 0) {
+        // Se libera el efecto en curso antes de pararlo para que su playingChanged no lance otro sonido
+        QSoundEffect* preempted = currentPlayingEffect;
+        currentPlayingEffect = nullptr;
+        isPlaying = false;
+        preempted->stop();
+    }
 
+    checkAndPlayNext();
 }
 
-
-
-
-
-
 void SoundFeedbackManager::checkAndPlayNext()
 {
-    if (isPlaying || soundQueue.isEmpty())
+    if (isPlaying)
         return;
 
-    auto pair = soundQueue.takeFirst();
-    currentPlayingEffect = pair.first;
+    const qint64 now = clock.elapsed();
+    for (int category = 0; category < CATEGORY_COUNT; ++category) {
+        QQueue<QueuedSound>& queue = soundQueues[category];
+        while (!queue.isEmpty()) {
+            QueuedSound next = queue.dequeue();
+            if (now - next.enqueuedAt > maxWaitMs) continue;
 
-    if (!currentPlayingEffect || !currentPlayingEffect->isLoaded())
-        return;
+            QSoundEffect* effect = soundMap.value(next.type);
+            if (!effect || !effect->isLoaded()) continue;
 
+            play(effect, next.type, category);
+            return;
+        }
+    }
+}
+
+void SoundFeedbackManager::play(QSoundEffect* effect, ConditionType type, int category)
+{
     isPlaying = true;
+    currentPlayingEffect = effect;
+    currentCategory = category;
+    lastPlayed.insert(type, clock.elapsed());
+    effect->play();
+}
 
+void SoundFeedbackManager::onSoundFinished() {
 
-    connect(currentPlayingEffect, &QSoundEffect::playingChanged, this, &SoundFeedbackManager::onSoundFinished, Qt::UniqueConnection);
+    QSoundEffect* effect = qobject_cast<QSoundEffect*>(sender());
+    if (!effect || effect != currentPlayingEffect || effect->isPlaying())
+        return;
 
-    currentPlayingEffect->play();
-    lastPlayTimestamp = QDateTime::currentMSecsSinceEpoch();
+    isPlaying = false;
+    currentPlayingEffect = nullptr;
+    currentCategory = CATEGORY_COUNT;
+    checkAndPlayNext();
 }
 
+void SoundFeedbackManager::clearQueue()
+{
+    for (QQueue<QueuedSound>& queue : soundQueues)
+        queue.clear();
 
-void SoundFeedbackManager::onSoundFinished() {
-
-    if (currentPlayingEffect && !currentPlayingEffect->isPlaying()) {
-        disconnect(currentPlayingEffect, &QSoundEffect::playingChanged,this, &SoundFeedbackManager::onSoundFinished);
-        isPlaying = false;
+    if (currentPlayingEffect) {
+        QSoundEffect* effect = currentPlayingEffect;
         currentPlayingEffect = nullptr;
+        effect->stop();
     }
+    isPlaying = false;
+    currentCategory = CATEGORY_COUNT;
 }
 
 /**
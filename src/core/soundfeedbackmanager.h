@@ -8,7 +8,9 @@
 #include "pose/condition.h"
 #include <QDir>
 #include <QList>
-#include <QTimer>
+#include <QQueue>
+#include <QElapsedTimer>
+#include <array>
 
 /**
  * @class SoundFeedbackManager
@@ -16,6 +18,12 @@
  *
  * Esta clase permite la asociación entre `ConditionType` y archivos de sonido. Soporta reproducción priorizada
  * en tiempo real, control de volumen, enmudecimiento global y activación selectiva por severidad.
+ *
+ * Los sonidos se decodifican al arrancar (QSoundEffect los mantiene en memoria como PCM), y la reproducción
+ * se decide por eventos: al recibir un sonido y al terminar el anterior. Cada severidad tiene su propia cola;
+ * siempre se reproduce primero la de mayor severidad, y un sonido crítico interrumpe a uno de menor severidad
+ * que esté sonando. Cada tipo de condición tiene un tiempo mínimo entre reproducciones, y los sonidos que
+ * llevan demasiado tiempo en cola se descartan porque ya no corresponden a lo que está haciendo el usuario.
  */
 class SoundFeedbackManager : public QObject
 {
@@ -60,38 +68,76 @@ public:
 
 
     /**
-     * @brief Reproduce el siguiente sonido en la cola si no hay ninguno en reproducción.
-     *
-     * Este método se llama de forma periódica mediante un QTimer. Si no hay ningún sonido
-     * en reproducción actualmente y la cola contiene sonidos pendientes, se reproduce el siguiente.
+     * @brief Reproduce el sonido pendiente de mayor severidad si no hay ninguno en reproducción.
      *
-     * También establece una conexión temporal a la señal `playingChanged` del QSoundEffect
-     * para detectar cuándo finaliza la reproducción, permitiendo continuar con el siguiente sonido.
+     * Se invoca al añadir un sonido y al terminar el que estaba sonando. Los sonidos que han superado el
+     * tiempo máximo de espera se descartan sin reproducirse.
      */
     void checkAndPlayNext();
 
     /**
-     * @brief Añade un sonido a la cola con lógica de prioridad y reemplazo, según la categoría proporcionada por el feedback.
-     * Si la cola ya contiene el sonido, no se añade. Si está llena, se aplica la siguiente política:
-     * - ALERTA reemplaza INFO; si no hay, reemplaza ALERTA; si todos son CRÍTICOS, elimina el primero y añade al final.
-     * - CRÍTICO reemplaza INFO o ALERTA; si todos son CRÍTICOS, elimina el primero y añade al final.
-     * @param feedback Objeto `FeedBack` que proporciona la categoría del sonido.
-     * @param type Tipo de condición cuyo sonido se desea añadir.
+     * @brief Añade un sonido a la cola de su severidad y lo reproduce de inmediato si es posible.
+     *
+     * El sonido se descarta si su severidad está deshabilitada, si ya está en cola o si el mismo tipo sonó
+     * hace menos que su tiempo mínimo entre reproducciones. Si la cola de su severidad está llena se descarta
+     * el sonido más antiguo. Un sonido crítico interrumpe a un sonido de alerta o informativo en curso.
+     * @param cond Tipo de condición cuyo sonido se desea añadir.
+     * @param catCond Severidad de la condición.
      */
     void addtoSoundList(ConditionType cond, ConditionCategory catCond);
+
+    /**
+     * @brief Establece el tiempo mínimo entre dos reproducciones del sonido de un tipo de condición.
+     * @param type Tipo de condición.
+     * @param cooldownMs Tiempo en milisegundos.
+     */
+    void setCooldown(ConditionType type, int cooldownMs);
+
+    /**
+     * @brief Descarta los sonidos pendientes y detiene el que esté sonando.
+     */
+    void clearQueue();
 private:
     QHash<ConditionType, QSoundEffect*> soundMap; ///< Mapa que asocia condiciones con efectos de sonido.
-    QList<QPair<QSoundEffect*,ConditionCategory>> soundQueue;              ///< Cola de reproducción priorizada.
+
+    /// Sonido pendiente de reproducir.
+    struct QueuedSound {
+        ConditionType type;
+        qint64 enqueuedAt;  ///< Instante de llegada (ms del reloj interno).
+    };
+
+    static constexpr int CATEGORY_COUNT = 3;      ///< Severidades con sonido: crítica, alerta e informativa.
+    static constexpr int maxQueuePerCategory = 3; ///< Sonidos pendientes por severidad.
+    static constexpr int maxWaitMs = 1500;        ///< Tiempo máximo en cola antes de descartar un sonido.
+
+    std::array<QQueue<QueuedSound>, CATEGORY_COUNT> soundQueues; ///< Colas por severidad (índice 0 = crítica).
+    QHash<ConditionType, int> cooldowns;          ///< Tiempo mínimo entre reproducciones por tipo.
+    QHash<ConditionType, qint64> lastPlayed;      ///< Último instante de reproducción por tipo.
+    QElapsedTimer clock;                          ///< Reloj monótono para colas y tiempos mínimos.
     bool isPlaying = false;                       ///< Indica si un sonido está siendo reproducido actualmente.
+    int currentCategory = CATEGORY_COUNT;         ///< Severidad del sonido en reproducción.
 
     bool infoSoundEnable = true;    ///< Bandera para sonidos informativos.
     bool alertSoundEnabled = true;  ///< Bandera para sonidos de alerta.
     bool criticaSoundEnable = true; ///< Bandera para sonidos críticos.
-    qint64 lastPlayTimestamp = 0; ///< Tiempo (ms) del último sonido reproducido
-    const int minDelayMs = 2000;
+    const int minDelayMs = 2000;  ///< Tiempo mínimo por defecto entre reproducciones de un mismo tipo.
     QSoundEffect* currentPlayingEffect = nullptr;
     QString soundPath; ///< Ruta base a la carpeta de sonidos.
-    QTimer* soundTimer;///<Temporizador para la emisión de los sonidos
+
+    /**
+     * @brief Índice de la cola de una severidad (0 = crítica), o -1 si la severidad no tiene sonido.
+     */
+    static int categoryIndex(ConditionCategory category);
+
+    /**
+     * @brief Indica si los sonidos de una severidad están habilitados.
+     */
+    bool isCategoryEnabled(ConditionCategory category) const;
+
+    /**
+     * @brief Reproduce un efecto y lo marca como el sonido en curso.
+     */
+    void play(QSoundEffect* effect, ConditionType type, int category);
     /**
      * @brief Carga los sonidos predeterminados desde la carpeta de configuración.
      */
@@ -115,7 +161,8 @@ private:
 
 private slots:
     /**
-     * @brief Slot llamado automáticamente al terminar un sonido, lanza el siguiente si existe.
+     * @brief Slot llamado cuando cambia el estado de reproducción de un efecto; al terminar el sonido en curso
+     * lanza el siguiente si existe.
      */
     void onSoundFinished();
 };
@@ -43,13 +43,11 @@ QList<WorkoutSummary> TrainingManager::listWorkouts(DBFilter filtro, const QStri
     DBTable table = repository->listWorkouts(filtro, valor);
 
     for (int i = 0; i < table.rowCount(); ++i) {
-        QList<QVariant> row = table.getRow(i);
-
         WorkoutSummary summary(
-            row[0].toInt(),     // idWorkout
-            row[1].toString(),  // name
-            row[2].toString(),  // description
-            row[3].toString()   // author
+            table.intValue(i, 0),     // idWorkout
+            table.stringValue(i, 1),  // name
+            table.stringValue(i, 2),  // description
+            table.stringValue(i, 3)   // author
             );
 
         list.append(summary);
@@ -91,14 +89,12 @@ QList<ExerciseSummary> TrainingManager::listExercises(DBFilter filtro, const QSt
     DBTable table = repository->listExercises(filtro, valor);
 
     for (int i = 0; i < table.rowCount(); ++i) {
-        QList<QVariant> row = table.getRow(i);
-
         ExerciseSummary summary(
-            row[0].toInt(),       // idEx
-            row[1].toString(),    // name
-            row[2].toString(),    // description
-            row[3].toString(),    // type
-            row[4].toString()     // targetMuscle
+            table.intValue(i, 0),       // idEx
+            table.stringValue(i, 1),    // name
+            table.stringValue(i, 2),    // description
+            table.stringValue(i, 3),    // type
+            table.stringValue(i, 4)     // targetMuscle
             );
 
         list.append(summary);
@@ -148,7 +144,20 @@ bool TrainingManager::endCurrentSesion()
 
     currentSesion->setDuration(currentSesion->getDate().msecsTo(QDateTime::currentDateTime()));
 
-    return repository->SaveTrainingSesion(currentSesion);
+    if (!persistence) return repository->SaveTrainingSesion(currentSesion);
+
+    // El lote se prepara aquí (asigna el ID de la sesión) y se escribe en el hilo de persistencia
+    DBWriteBatch batch;
+    if (!repository->buildSesionBatch(currentSesion, batch)) return false;
+    return persistence->enqueue(batch);
+}
+
+/**
+ * @brief Asigna el gestor de escrituras en segundo plano.
+ */
+void TrainingManager::setPersistenceManager(QSharedPointer<PersistenceManager> manager)
+{
+    persistence = manager;
 }
 
 /**
@@ -172,4 +181,10 @@ QSharedPointer<TrainingRepository> TrainingManager::getRepository() const
 QMap<int,QDateTime> TrainingManager::getSesionList(int idClient, int idWorkout, int idEx) {
   return repository->listSesionSummaries(idClient, idWorkout, idEx);
 }
+/**
+ * @brief Devuelve la tendencia de progreso diaria o semanal de un cliente en un ejercicio.
+ */
+DBTable TrainingManager::getProgressTrend(int idClient, int idEx, const QDate& from, const QDate& to, bool weekly) {
+  return repository->getProgressTrend(idClient, idEx, from, to, weekly);
+}
 
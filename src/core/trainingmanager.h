@@ -16,6 +16,7 @@
 #include "workouts/exercisesummary.h"
 #include "enums/TypeBDEnum.h"
 #include "repositories/trainingrepository.h"
+#include "core/persistencemanager.h"
 #include "utils/uiutils.h"
 #include <QPointer>
 #include <QDateTime>
@@ -116,10 +117,19 @@ public:
 
     /**
      * @brief Finaliza la sesión actual y la guarda.
-     * @return true si se guardó correctamente.
+     *
+     * Si hay un PersistenceManager asignado, la sesión se convierte en un lote y se guarda en segundo plano;
+     * el resultado final se notifica con sus señales.
+     * @return true si se guardó (o se encoló) correctamente.
      */
     bool endCurrentSesion();
 
+    /**
+     * @brief Asigna el gestor de escrituras en segundo plano usado para guardar las sesiones.
+     * @param manager Gestor de persistencia; nulo para guardar de forma síncrona.
+     */
+    void setPersistenceManager(QSharedPointer<PersistenceManager> manager);
+
     /**
      * @brief Obtiene el siguiente ID disponible para ejercicios.
      * @return Entero ID disponible.
@@ -154,10 +164,22 @@ public:
      */
     QMap<int,QDateTime> getSesionList(int idClient, int idWorkout, int idEx);
 
+    /**
+     * @brief Obtiene la tendencia de progreso de un cliente en un ejercicio desde los acumulados por periodo.
+     * @param idClient ID del cliente.
+     * @param idEx ID del ejercicio.
+     * @param from Primer día incluido.
+     * @param to Último día incluido.
+     * @param weekly `true` para agrupar por semana.
+     * @return Tabla con una fila por día o semana con sesiones.
+     */
+    DBTable getProgressTrend(int idClient, int idEx, const QDate& from, const QDate& to, bool weekly = false);
+
 private:
     QSharedPointer<TrainingRepository> repository;        ///< Repositorio de entrenamientos.
     QSharedPointer<TrainingWorkout> currentWorkout;       ///< Workout actualmente en edición o ejecución.
     QSharedPointer<TrainingSesion> currentSesion;         ///< Sesión en ejecución.
+    QSharedPointer<PersistenceManager> persistence;       ///< Escrituras en segundo plano (opcional).
 };
 
 #endif // TRAININGMANAGER_H
@@ -19,6 +19,12 @@ UserManager::UserManager(QSharedPointer<UserRepository> repo, QObject* parent)
 QSharedPointer<User> UserManager::getUser(int id) {
     return repository->getUserById(id);
 }
+/**
+ * @brief Recupera la miniatura de perfil de un usuario desde el repositorio.
+ */
+QImage UserManager::getUserThumbnail(int id) {
+    return repository->getUserThumbnail(id);
+}
 /**
  * @brief Método placeholder de autenticación.
  * @note Siempre devuelve false.
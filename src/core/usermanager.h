@@ -40,6 +40,11 @@ public:
      */
     QSharedPointer<User> getUser(int id);
 
+    /**
+     * @brief Devuelve la miniatura de la imagen de perfil de un usuario. Puede llamarse desde otros hilos.
+     */
+    QImage getUserThumbnail(int id);
+
     /**
      * @brief Autentica a un usuario por nombre y contraseña (método por implementar).
      */
@@ -0,0 +1,141 @@
+/**
+ * @file dbconnectionpool.cpp
+ * @brief Implementación de la clase DBConnectionPool.
+ */
+
+#include "dbconnectionpool.h"
+#include "core/dbmanager.h"
+#include <QMutexLocker>
+#include <QSqlDatabase>
+#include <QThread>
+#include <QThreadPool>
+#include <QThreadStorage>
+#include <atomic>
+
+namespace {
+
+/// Cierra un DBManager del pool y elimina su conexión del registro de Qt.
+void closeConnection(DBManager* db)
+{
+    const QString name = db->connectionName();
+    delete db;
+    QSqlDatabase::removeDatabase(name);
+}
+
+QMutex poolsMutex;                            ///< Protege `livePools`.
+QHash<quint64, DBConnectionPool*> livePools;  ///< Pools sin destruir, por identificador.
+std::atomic<quint64> nextPoolId{1};
+
+}
+
+struct DBConnectionPool::ThreadConnections {
+    QHash<QPair<quint64, int>, DBManager*> dbs; ///< Conexión por pool y modo.
+
+    ~ThreadConnections();
+};
+
+/**
+ * @brief QThreadStorage lo destruye desde el propio hilo al terminar este: cierra sus conexiones y las retira
+ * de los pools que siguen existiendo.
+ */
+DBConnectionPool::ThreadConnections::~ThreadConnections()
+{
+    QThread* thread = QThread::currentThread();
+    QMutexLocker lock(&poolsMutex);
+    for (auto it = dbs.constBegin(); it != dbs.constEnd(); ++it) {
+        if (DBConnectionPool* pool = livePools.value(it.key().first)) {
+            QMutexLocker poolLock(&pool->mutex);
+            pool->connections.remove(Key(thread, it.key().second));
+        }
+        closeConnection(it.value());
+    }
+}
+
+DBConnectionPool::ThreadConnections* DBConnectionPool::localConnections(bool create)
+{
+    static QThreadStorage<ThreadConnections*> storage;
+    if (!storage.hasLocalData()) {
+        if (!create) return nullptr;
+        storage.setLocalData(new ThreadConnections);
+    }
+    return storage.localData();
+}
+
+DBConnectionPool::DBConnectionPool(const QString& dbPath, QObject* parent)
+    : QObject(parent),
+    poolId(nextPoolId++),
+    dbPath(dbPath)
+{
+    QMutexLocker lock(&poolsMutex);
+    livePools.insert(poolId, this);
+}
+
+/**
+ * @brief Qt no permite cerrar una conexión desde otro hilo, así que solo se cierran las del hilo actual. Las
+ * tareas del QThreadPool global (cargas en segundo plano) se esperan antes; las conexiones que queden quedan a
+ * cargo de sus hilos.
+ */
+DBConnectionPool::~DBConnectionPool()
+{
+    QThreadPool::globalInstance()->waitForDone();
+    releaseCurrentThread();
+
+    QMutexLocker poolsLock(&poolsMutex);
+    livePools.remove(poolId);
+    QMutexLocker lock(&mutex);
+    if (!connections.isEmpty())
+        qDebug(DBManagerLog) << connections.size() << "conexiones del pool siguen abiertas; las cerrarán sus hilos al terminar";
+}
+
+/**
+ * @brief Las conexiones se guardan en el almacenamiento local del hilo, de modo que buscarlas no necesita el
+ * mutex; el registro del pool solo se actualiza al crearlas.
+ */
+DBManager* DBConnectionPool::connection(Mode mode)
+{
+    ThreadConnections* local = localConnections(true);
+    const QPair<quint64, int> localKey(poolId, int(mode));
+    if (DBManager* db = local->dbs.value(localKey)) return db;
+
+    QThread* thread = QThread::currentThread();
+    const QString name = QString("pool_%1_%2_%3")
+                             .arg(poolId)
+                             .arg(quintptr(thread), 0, 16)
+                             .arg(mode == Mode::ReadOnly ? "ro" : "rw");
+    DBManager* db = new DBManager(dbPath, nullptr, name);
+    db->enableWriteAheadLog();
+    if (mode == Mode::ReadOnly) db->setReadOnly(true);
+    local->dbs.insert(localKey, db);
+
+    QMutexLocker lock(&mutex);
+    connections.insert(Key(thread, int(mode)), db);
+    return db;
+}
+
+void DBConnectionPool::releaseCurrentThread()
+{
+    ThreadConnections* local = localConnections(false);
+    if (!local) return;
+
+    QThread* thread = QThread::currentThread();
+    for (Mode mode : {Mode::ReadWrite, Mode::ReadOnly}) {
+        DBManager* db = local->dbs.take(qMakePair(poolId, int(mode)));
+        if (!db) continue;
+        {
+            QMutexLocker lock(&mutex);
+            connections.remove(Key(thread, int(mode)));
+        }
+        closeConnection(db);
+    }
+}
+
+int DBConnectionPool::size()
+{
+    QMutexLocker lock(&mutex);
+    return connections.size();
+}
+
+QString DBConnectionPool::databasePath() const
+{
+    return dbPath;
+}
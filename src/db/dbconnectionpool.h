@@ -0,0 +1,90 @@
+/**
+ * @file dbconnectionpool.h
+ * @brief Declaración de la clase DBConnectionPool, conexiones SQLite por hilo sobre la misma base de datos.
+ */
+
+#ifndef DBCONNECTIONPOOL_H
+#define DBCONNECTIONPOOL_H
+
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+
+class DBManager;
+class QThread;
+
+/**
+ * @class DBConnectionPool
+ * @brief Reparte un DBManager con conexión propia a cada hilo que accede a la base de datos.
+ *
+ * Una conexión Qt SQL solo puede usarse y cerrarse desde el hilo que la creó, por lo que cada hilo recibe la
+ * suya la primera vez que la pide y la guarda en su almacenamiento local (QThreadStorage); el propio hilo la
+ * cierra al terminar. La base de datos trabaja en modo
+ * WAL: las conexiones de lectura no se bloquean mientras otra escribe, y las escrituras de distintas
+ * conexiones se serializan en SQLite (las transacciones empiezan con BEGIN IMMEDIATE y esperan a que termine
+ * la anterior), de modo que en cada momento hay un único escritor.
+ */
+class DBConnectionPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Tipo de conexión.
+    enum class Mode {
+        ReadWrite, ///< Lecturas y escrituras.
+        ReadOnly   ///< Solo lecturas (`PRAGMA query_only`), para consultas de análisis.
+    };
+
+    /**
+     * @brief Constructor.
+     * @param dbPath Ruta al archivo de base de datos SQLite.
+     * @param parent Objeto Qt padre.
+     */
+    explicit DBConnectionPool(const QString& dbPath, QObject* parent = nullptr);
+
+    /**
+     * @brief Destructor. Espera a que terminen las tareas del QThreadPool global y cierra las conexiones del
+     * hilo actual; las de otros hilos que sigan vivos las cierra cada hilo al terminar.
+     */
+    ~DBConnectionPool();
+
+    /**
+     * @brief Devuelve el DBManager del hilo actual para el modo indicado, creándolo si no existe.
+     * @param mode Tipo de conexión.
+     * @return Gestor de base de datos que solo debe usarse desde el hilo actual.
+     */
+    DBManager* connection(Mode mode = Mode::ReadWrite);
+
+    /**
+     * @brief Cierra las conexiones del hilo actual. Si no se llama, el hilo las cierra al terminar.
+     */
+    void releaseCurrentThread();
+
+    /**
+     * @brief Número de conexiones abiertas.
+     */
+    int size();
+
+    /**
+     * @brief Ruta de la base de datos.
+     */
+    QString databasePath() const;
+
+private:
+    using Key = QPair<QThread*, int>;
+
+    /// Conexiones de un hilo, de todos los pools; pertenecen al hilo, que las cierra al terminar.
+    struct ThreadConnections;
+
+    /// Conexiones del hilo actual; si `create` es true y el hilo aún no tiene, las crea.
+    static ThreadConnections* localConnections(bool create);
+
+    const quint64 poolId;               ///< Identificador único del pool (una dirección puede reutilizarse).
+    QString dbPath;                     ///< Ruta de la base de datos.
+    QMutex mutex;                       ///< Protege `connections`.
+    QHash<Key, DBManager*> connections; ///< Conexiones abiertas por hilo y modo; las posee su hilo.
+};
+
+#endif // DBCONNECTIONPOOL_H
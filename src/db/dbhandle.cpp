@@ -0,0 +1,26 @@
+/**
+ * @file dbhandle.cpp
+ * @brief Implementación de la clase DBHandle.
+ */
+
+#include "dbhandle.h"
+#include "core/dbmanager.h"
+#include <QThread>
+
+DBHandle::DBHandle(DBManager* owner, DBConnectionPool::Mode mode)
+    : owner(owner),
+    mode(mode)
+{
+}
+
+/**
+ * @brief Sin pool, o desde el hilo del gestor principal (el habitual), se devuelve el propio gestor.
+ */
+DBManager* DBHandle::get() const
+{
+    if (!owner) return nullptr;
+
+    DBConnectionPool* pool = owner->connectionPool();
+    if (!pool || QThread::currentThread() == owner->thread()) return owner;
+    return pool->connection(mode);
+}
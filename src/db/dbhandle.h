@@ -0,0 +1,45 @@
+/**
+ * @file dbhandle.h
+ * @brief Declaración de la clase DBHandle, acceso al DBManager que corresponde al hilo actual.
+ */
+
+#ifndef DBHANDLE_H
+#define DBHANDLE_H
+
+#include "db/dbconnectionpool.h"
+
+class DBManager;
+
+/**
+ * @class DBHandle
+ * @brief Referencia a un DBManager que, usada desde otro hilo, se resuelve a la conexión de ese hilo.
+ *
+ * Los repositorios guardan un DBHandle en lugar de un puntero a DBManager. Desde el hilo del DBManager
+ * principal el handle devuelve ese mismo gestor; desde cualquier otro hilo devuelve la conexión del hilo
+ * obtenida del DBConnectionPool asignado al gestor principal. Se usa igual que un puntero (`handle->get(...)`)
+ * y se convierte implícitamente a `DBManager*`.
+ */
+class DBHandle
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param owner Gestor principal.
+     * @param mode Tipo de conexión a pedir al pool desde otros hilos.
+     */
+    DBHandle(DBManager* owner = nullptr, DBConnectionPool::Mode mode = DBConnectionPool::Mode::ReadWrite);
+
+    /**
+     * @brief Devuelve el gestor que debe usarse desde el hilo actual.
+     */
+    DBManager* get() const;
+
+    DBManager* operator->() const { return get(); }
+    operator DBManager*() const { return get(); }
+
+private:
+    DBManager* owner;              ///< Gestor principal.
+    DBConnectionPool::Mode mode;   ///< Tipo de conexión en otros hilos.
+};
+
+#endif // DBHANDLE_H
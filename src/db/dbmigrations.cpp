@@ -0,0 +1,142 @@
+/**
+ * @file dbmigrations.cpp
+ * @brief Lista de migraciones del esquema de la base de datos.
+ */
+
+#include "dbmigrations.h"
+
+namespace {
+
+/**
+ * @brief Sentencias que recalculan un acumulado de SesionRollupDaily o SesionRollupWeekly desde SesionSummary.
+ * @param table Tabla de acumulados.
+ * @param period Columna del periodo (`day` o `week`).
+ * @param row Fila del trigger cuyo periodo se recalcula (`NEW` u `OLD`).
+ */
+QString recomputeRollup(const QString& table, const QString& period, const QString& row)
+{
+    const QString where = QString("idClient = %1.idClient AND idEx = %1.idEx AND %2 = %1.%2").arg(row, period);
+    return QString("DELETE FROM %1 WHERE %3; "
+                   "INSERT INTO %1 SELECT idClient, idEx, %2, COUNT(*), SUM(duration), SUM(repetitions), "
+                   "SUM(timeUnderTension), SUM(criticalCount), SUM(alertCount), SUM(infoCount), SUM(overloadCount), "
+                   "AVG(romMean) FROM SesionSummary WHERE %3 GROUP BY idClient, idEx, %2; ")
+        .arg(table, period, where);
+}
+
+/**
+ * @brief Trigger de SesionSummary que recalcula el día y la semana de cada una de las filas indicadas.
+ * @param name Nombre del trigger.
+ * @param event Evento que lo dispara (`INSERT`, `UPDATE` o `DELETE`).
+ * @param rows Filas del trigger (`NEW`, `OLD`) en el orden en que se recalculan.
+ */
+QString rollupTrigger(const QString& name, const QString& event, const QStringList& rows)
+{
+    QString body;
+    for (const QString& row : rows)
+        body += recomputeRollup("SesionRollupDaily", "day", row);
+    for (const QString& row : rows)
+        body += recomputeRollup("SesionRollupWeekly", "week", row);
+    return QString("CREATE TRIGGER IF NOT EXISTS %1 AFTER %2 ON SesionSummary BEGIN %3END").arg(name, event, body);
+}
+
+} // namespace
+
+const QList<DBMigration>& dbMigrations()
+{
+    static const QList<DBMigration> migrations = {
+        {1, "Columnas nuevas de SesionReport e índice de sesiones por cliente, workout y ejercicio", {
+            // Estadísticos por repetición y bloque binario del reporte; sustituye a la comprobación de columnas que
+            // se hacía al abrir la base de datos
+            "ALTER TABLE SesionReport ADD COLUMN repStatsJson TEXT",
+            "ALTER TABLE SesionReport ADD COLUMN reportBlob BLOB",
+            // listSesionSummaries filtra por las tres columnas y el resto de consultas por un prefijo de ellas
+            "CREATE INDEX IF NOT EXISTS idx_trainingsesion_client_workout_ex "
+            "ON TrainingSesion (idClient, idWorkout, idEx, date)",
+        }},
+        {2, "Índices de búsqueda por usuario, cliente y ejercicio", {
+            "CREATE INDEX IF NOT EXISTS idx_clients_user ON clients (idUser)",
+            "CREATE INDEX IF NOT EXISTS idx_fitnesstrainers_user ON fitnesstrainers (idUser)",
+            "CREATE INDEX IF NOT EXISTS idx_admins_user ON admins (idUser)",
+            "CREATE INDEX IF NOT EXISTS idx_userpreferences_user ON userpreferences (idUser)",
+            "CREATE INDEX IF NOT EXISTS idx_workout_exercise_espec_ex ON workout_exercise_espec (idEx)",
+            "CREATE INDEX IF NOT EXISTS idx_general_records_client ON general_records (idClient)",
+            "CREATE INDEX IF NOT EXISTS idx_functional_records_client ON functional_records (idClient)",
+            "CREATE INDEX IF NOT EXISTS idx_morfological_records_client ON morfological_records (idClient)",
+            "CREATE INDEX IF NOT EXISTS idx_rom_records_client ON rom_records (idClient)",
+            "CREATE INDEX IF NOT EXISTS idx_lifestyle_records_client ON lifestyle_records (idClient)",
+            "CREATE INDEX IF NOT EXISTS idx_medical_records_client ON medical_records (idClient)",
+            "CREATE INDEX IF NOT EXISTS idx_aditional_records_client ON aditional_records (idClient)",
+        }},
+        {3, "Secuencias de IDs por tabla", {
+            // Siguiente ID libre de cada tabla; lo mantiene DBManager::generateID()
+            "CREATE TABLE IF NOT EXISTS id_sequence ("
+            "tableName TEXT PRIMARY KEY, "
+            "nextId INTEGER NOT NULL)",
+        }},
+        {4, "Índices de los listados paginados de usuarios", {
+            // Las tablas de administración filtran por tipo y ordenan por nombre
+            "CREATE INDEX IF NOT EXISTS idx_users_type_name ON users (userType, userName)",
+            "CREATE INDEX IF NOT EXISTS idx_users_name ON users (userName)",
+        }},
+        {5, "Resumen por sesión y acumulados diarios y semanales", {
+            // Una fila por sesión, escrita en la misma transacción que la sesión
+            "CREATE TABLE IF NOT EXISTS SesionSummary ("
+            "idSesion INTEGER PRIMARY KEY, "
+            "idClient INTEGER NOT NULL, "
+            "idWorkout INTEGER, "
+            "idEx INTEGER NOT NULL, "
+            "date TEXT, "
+            "day TEXT NOT NULL, "
+            "week TEXT NOT NULL, "
+            "duration INTEGER, "
+            "repetitions INTEGER, "
+            "timeUnderTension INTEGER, "
+            "criticalCount INTEGER, "
+            "alertCount INTEGER, "
+            "infoCount INTEGER, "
+            "overloadCount INTEGER, "
+            "romMean REAL, "
+            "lineStats TEXT)",
+            "CREATE INDEX IF NOT EXISTS idx_sesionsummary_client_ex_day ON SesionSummary (idClient, idEx, day)",
+            "CREATE INDEX IF NOT EXISTS idx_sesionsummary_client_ex_week ON SesionSummary (idClient, idEx, week)",
+            // La clave primaria sirve a las consultas de tendencia: cliente y ejercicio fijos, rango de fechas
+            "CREATE TABLE IF NOT EXISTS SesionRollupDaily ("
+            "idClient INTEGER NOT NULL, idEx INTEGER NOT NULL, day TEXT NOT NULL, "
+            "sessions INTEGER, duration INTEGER, repetitions INTEGER, timeUnderTension INTEGER, "
+            "criticalCount INTEGER, alertCount INTEGER, infoCount INTEGER, overloadCount INTEGER, romMean REAL, "
+            "PRIMARY KEY (idClient, idEx, day))",
+            "CREATE TABLE IF NOT EXISTS SesionRollupWeekly ("
+            "idClient INTEGER NOT NULL, idEx INTEGER NOT NULL, week TEXT NOT NULL, "
+            "sessions INTEGER, duration INTEGER, repetitions INTEGER, timeUnderTension INTEGER, "
+            "criticalCount INTEGER, alertCount INTEGER, infoCount INTEGER, overloadCount INTEGER, romMean REAL, "
+            "PRIMARY KEY (idClient, idEx, week))",
+            // Los acumulados de un día y una semana se recalculan enteros desde los resúmenes, de modo que volver
+            // a guardar una sesión (INSERT OR REPLACE al reprocesar el diario) no la cuenta dos veces
+            rollupTrigger("trg_sesionsummary_insert", "INSERT", {"NEW"}),
+            rollupTrigger("trg_sesionsummary_delete", "DELETE", {"OLD"}),
+        }},
+        {6, "Imágenes de perfil fuera de la tabla de usuarios", {
+            // Imagen completa y miniatura por usuario; los listados ya no arrastran las imágenes al leer users
+            "CREATE TABLE IF NOT EXISTS user_pictures ("
+            "idUser INTEGER PRIMARY KEY, "
+            "picture BLOB, "
+            "thumbnail BLOB)",
+            // Las miniaturas de las imágenes migradas se generan la primera vez que se piden
+            "INSERT OR IGNORE INTO user_pictures (idUser, picture) "
+            "SELECT idUser, profile_picture FROM users WHERE length(profile_picture) > 0",
+            // La columna se mantiene por compatibilidad con schema.sql, pero siempre queda vacía
+            "UPDATE users SET profile_picture = NULL WHERE profile_picture IS NOT NULL",
+        }},
+        {7, "Acumulados de progreso al actualizar un resumen de sesión", {
+            // DBManager::save() actualiza con UPDATE las sesiones ya guardadas; si cambian la fecha o los contadores
+            // se recalculan el periodo anterior y el nuevo
+            rollupTrigger("trg_sesionsummary_update", "UPDATE", {"OLD", "NEW"}),
+        }},
+    };
+    return migrations;
+}
+
+int dbLatestSchemaVersion()
+{
+    return dbMigrations().isEmpty() ? 0 : dbMigrations().last().version;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file dbmigrations.h
+ * @brief Declaración de las migraciones del esquema de la base de datos.
+ *
+ * Cada migración lleva el esquema de la versión anterior a la suya. La versión aplicada se guarda en la propia
+ * base de datos (`PRAGMA user_version`) y DBManager::migrateSchema() ejecuta, en orden, las que falten.
+ * Las migraciones nunca se modifican una vez publicadas: los cambios nuevos se añaden al final de la lista.
+ * Las columnas nuevas se añaden también a `schema.sql`; por eso un `ALTER TABLE ... ADD COLUMN` se omite si la
+ * columna ya existe.
+ */
+
+#ifndef DBMIGRATIONS_H
+#define DBMIGRATIONS_H
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @struct DBMigration
+ * @brief Conjunto de sentencias SQL que llevan el esquema a una versión concreta.
+ */
+struct DBMigration {
+    int version;             ///< Versión del esquema tras aplicar la migración (empieza en 1).
+    QString description;     ///< Descripción breve, para los logs.
+    QStringList statements;  ///< Sentencias SQL, ejecutadas en orden dentro de una transacción.
+};
+
+/**
+ * @brief Devuelve todas las migraciones del esquema ordenadas por versión.
+ */
+const QList<DBMigration>& dbMigrations();
+
+/**
+ * @brief Versión del esquema tras aplicar todas las migraciones.
+ */
+int dbLatestSchemaVersion();
+
+#endif // DBMIGRATIONS_H
@@ -0,0 +1,36 @@
+/**
+ * @file dbpagerequest.h
+ * @brief Declaración de DBPageRequest, descripción de una página de resultados de una tabla.
+ */
+
+#ifndef DBPAGEREQUEST_H
+#define DBPAGEREQUEST_H
+
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include "enums/TypeBDEnum.h"
+
+/**
+ * @struct DBPageRequest
+ * @brief Consulta paginada sobre una tabla: columnas, filtros, orden y ventana de filas.
+ *
+ * Los nombres de columna se comprueban contra el esquema de la tabla antes de construir el SQL y todos los
+ * valores se enlazan como parámetros. Se usan QMap para que el mismo conjunto de filtros genere siempre el mismo
+ * SQL y reutilice la sentencia preparada.
+ */
+struct DBPageRequest {
+    TypeBDEnum tipo = TypeBDEnum::Unknown;   ///< Tabla consultada.
+    QStringList columns;                     ///< Columnas a leer (vacío: todas).
+    QMap<QString, QVariant> equals;          ///< Columna → valor exacto.
+    QMap<QString, QString> contains;         ///< Columna → texto que debe contener (sin distinguir mayúsculas).
+    QMap<QString, QPair<QVariant, QVariant>> between; ///< Columna → rango cerrado [desde, hasta]; un extremo nulo no se aplica.
+    QString orderBy;                         ///< Columna de ordenación (vacío: clave primaria).
+    Qt::SortOrder order = Qt::AscendingOrder;///< Sentido de la ordenación.
+    int limit = 100;                         ///< Filas por página.
+    int offset = 0;                          ///< Filas que se saltan.
+};
+
+#endif // DBPAGEREQUEST_H
@@ -13,57 +13,82 @@ DBTable::DBTable(QString tableName):tableName(tableName) {}
  * @brief Devuelve el valor de una celda por índice de fila y nombre de columna.
  */
 QVariant DBTable::value(int row, const QString& column) const {
-    int colIndex = -1;
-    for (int i = 0; i < columns.size(); ++i) {
+    int colIndex = columnIndex(column);
 
-        if (columns[i].compare(column, Qt::CaseInsensitive) == 0) {
-            colIndex = i;
-            break;
-        }
-    }
-
-    if (colIndex < 0 || row < 0 || row >= rows.size()) {
+    if (colIndex < 0 || row < 0 || row >= rowTotal) {
         qWarning() << "DBTable::value - columna no encontrada:" << column << "- columnas:" << columns;
         return QVariant();
     }
 
-    return rows[row][colIndex];
+    return cell(data[colIndex], row);
+}
+
+QVariant DBTable::value(int row, int column) const {
+    if (column < 0 || column >= data.size() || row < 0 || row >= rowTotal) return QVariant();
+    return cell(data[column], row);
+}
+
+int DBTable::intValue(int row, int column) const {
+    if (column < 0 || column >= data.size() || row < 0 || row >= rowTotal) return 0;
+    const Column& c = data[column];
+    if (c.kind == Column::Kind::Integer) return int(c.integers[row]);
+    return cell(c, row).toInt();
+}
+
+double DBTable::doubleValue(int row, int column) const {
+    if (column < 0 || column >= data.size() || row < 0 || row >= rowTotal) return 0.0;
+    const Column& c = data[column];
+    if (c.kind == Column::Kind::Real) return c.reals[row];
+    return cell(c, row).toDouble();
+}
+
+QString DBTable::stringValue(int row, int column) const {
+    if (column < 0 || column >= data.size() || row < 0 || row >= rowTotal) return QString();
+    const Column& c = data[column];
+    if (c.kind == Column::Kind::Text) return c.texts[row];
+    return cell(c, row).toString();
+}
+
+/**
+ * @brief Busca primero el nombre tal cual y, si no está, en minúsculas.
+ */
+int DBTable::columnIndex(const QString& column) const {
+    auto it = columnIndexes.constFind(column);
+    if (it == columnIndexes.constEnd()) it = columnIndexes.constFind(column.toLower());
+    return it == columnIndexes.constEnd() ? -1 : it.value();
 }
+
 /**
  * @brief Asigna un nuevo valor a una celda específica.
  */
 void DBTable::setValue(int row, const QString& column, QVariant new_value) {
-    int colIndex = -1;
-    for (int i = 0; i < columns.size(); ++i) {
-
-        if (columns[i].compare(column, Qt::CaseInsensitive) == 0) {
-            colIndex = i;
-            break;
-        }
-    }
+    int colIndex = columnIndex(column);
 
     if (colIndex < 0) {
         qWarning() << "DBTable::setValue - Columna no encontrada:" << column;
         return;
     }
 
-    if (row < 0 || row >= rows.size()) {
+    if (row < 0 || row >= rowTotal) {
         qWarning() << "DBTable::setValue - Índice de fila fuera de rango:" << row;
         return;
     }
 
-    if (colIndex >= rows[row].size()) {
-        qWarning() << "DBTable::setValue - Índice de columna fuera de rango para la fila:" << colIndex;
+    assign(data[colIndex], row, new_value);
+}
+
+void DBTable::setValue(int row, int column, const QVariant& new_value) {
+    if (column < 0 || column >= data.size() || row < 0 || row >= rowTotal) {
+        qWarning() << "DBTable::setValue - Posición fuera de rango:" << row << column;
         return;
     }
-
-    rows[row][colIndex] = new_value;
+    assign(data[column], row, new_value);
 }
 
 /**
  * @brief Devuelve el número de filas en la tabla.
  */
-int  DBTable::rowCount() const { return rows.size();}
+int  DBTable::rowCount() const { return rowTotal;}
 
 /**
  * @brief Devuelve el número de columnas.
@@ -80,24 +105,72 @@ QString DBTable::getColumnName(int columnNumber) const{
     return columns[columnNumber];
 }
 /**
- * @brief Establece los nombres de las columnas.
+ * @brief Establece los nombres de las columnas y reconstruye el índice por nombre.
  */
 void DBTable::setColumns(const QStringList& colNames) {
     columns = colNames;
+
+    columnIndexes.clear();
+    columnIndexes.reserve(columns.size() * 2);
+    for (int i = columns.size() - 1; i >= 0; --i) {
+        columnIndexes.insert(columns[i], i);
+        columnIndexes.insert(columns[i].toLower(), i);
+    }
+
+    const int previous = data.size();
+    data.resize(columns.size());
+    for (int i = previous; i < data.size(); ++i)
+        data[i].cells.fill(CellInvalid, rowTotal);
+}
+
+void DBTable::reserve(int rowCount) {
+    for (Column& c : data) {
+        c.cells.reserve(rowCount);
+        switch (c.kind) {
+        case Column::Kind::Integer: c.integers.reserve(rowCount); break;
+        case Column::Kind::Real: c.reals.reserve(rowCount); break;
+        case Column::Kind::Text: c.texts.reserve(rowCount); break;
+        case Column::Kind::Generic: c.generic.reserve(rowCount); break;
+        case Column::Kind::Unset: break;
+        }
+    }
+}
+
+/**
+ * @brief Pensado para reutilizar la tabla como bloque en recorridos largos: los vectores conservan su capacidad.
+ */
+void DBTable::clearRows() {
+    for (Column& c : data) {
+        c.integers.clear();
+        c.reals.clear();
+        c.texts.clear();
+        c.generic.clear();
+        c.cells.clear();
+    }
+    rowTotal = 0;
 }
+
 /**
  * @brief Añade una fila completa a la tabla.
  */
 void DBTable::addRow(const QList<QVariant>& rowData) {
-    rows.append(rowData);
+    if (rowData.size() > data.size())
+        qWarning() << "DBTable::addRow - La fila tiene más valores que columnas:" << rowData.size() << data.size();
+
+    for (int i = 0; i < data.size(); ++i)
+        append(data[i], i < rowData.size() ? rowData[i] : QVariant());
+    ++rowTotal;
 }
 /**
  * @brief Recupera una fila completa como lista ordenada de valores.
  */
 QList<QVariant> DBTable::getRow(int rowIndex) const {
     QList<QVariant> row;
-    for (const QString& col : columns) {
-        row.append(value(rowIndex, col));
+    if (rowIndex < 0 || rowIndex >= rowTotal) return row;
+
+    row.reserve(data.size());
+    for (const Column& c : data) {
+        row.append(cell(c, rowIndex));
     }
     return row;
 }
@@ -106,29 +179,23 @@ QList<QVariant> DBTable::getRow(int rowIndex) const {
  */
 bool DBTable::isEmpty()
 {
-    return rows.isEmpty();
+    return rowTotal == 0;
 }
 
 /**
  * @brief Verifica si existe un valor específico en una columna.
  */
 bool DBTable::contains( const QString& column, QVariant value){
-    int colIndex = -1;
-    for (int i = 0; i < columns.size(); ++i) {
-        if (columns[i].toLower() == column.toLower())
-        {
-            colIndex = i;
-            break;
-        }
-    }
+    int colIndex = columnIndex(column);
 
     if (colIndex == -1) {
         qWarning() << "DBTable::contains - columna no encontrada:" << column;
         return false;
     }
 
-    for (const auto& row : rows) {
-        if (row[colIndex] == value) {
+    const Column& c = data[colIndex];
+    for (int row = 0; row < rowTotal; ++row) {
+        if (cell(c, row) == value) {
             return true;
         }
     }
@@ -151,10 +218,10 @@ void DBTable::print() const {
     qDebug().noquote() << header;
 
     // Imprimir cada fila
-    for (const auto& row : rows) {
+    for (int row = 0; row < rowTotal; ++row) {
         QString fila;
-        for (const QVariant& val : row) {
-            fila =fila + QString("%1\t").arg(val.toString());
+        for (const Column& c : data) {
+            fila =fila + QString("%1\t").arg(cell(c, row).toString());
         }
         qDebug().noquote() << fila;
     }
@@ -167,3 +234,136 @@ QString DBTable::getTableName() const
     return tableName;
 }
 
+/**
+ * @brief Tipo de almacenamiento que corresponde a un tipo de QVariant.
+ */
+DBTable::Column::Kind DBTable::kindOf(int typeId) {
+    switch (typeId) {
+    case QMetaType::Int:
+    case QMetaType::LongLong:
+        return Column::Kind::Integer;
+    case QMetaType::Double:
+        return Column::Kind::Real;
+    case QMetaType::QString:
+        return Column::Kind::Text;
+    default:
+        return Column::Kind::Generic;
+    }
+}
+
+/**
+ * @brief Reconstruye el QVariant de una celda con el tipo con el que se guardó.
+ */
+QVariant DBTable::cell(const Column& column, int row) {
+    if (column.kind == Column::Kind::Generic) return column.generic[row];
+
+    const quint8 state = column.cells[row];
+    if (state == CellInvalid) return QVariant();
+    if (state == CellNull) return QVariant(QMetaType(column.typeId));
+
+    switch (column.kind) {
+    case Column::Kind::Integer:
+        if (column.typeId == QMetaType::Int) return QVariant(int(column.integers[row]));
+        return QVariant(qlonglong(column.integers[row]));
+    case Column::Kind::Real:
+        return QVariant(column.reals[row]);
+    case Column::Kind::Text:
+        return QVariant(column.texts[row]);
+    default:
+        return QVariant();
+    }
+}
+
+/**
+ * @brief Añade un valor al final de la columna. Un valor de otro tipo convierte la columna en genérica.
+ */
+void DBTable::append(Column& column, const QVariant& value) {
+    if (column.kind != Column::Kind::Generic && value.isValid()) {
+        if (column.kind == Column::Kind::Unset)
+            promote(column, value, column.cells.size());
+        else if (value.typeId() != column.typeId)
+            makeGeneric(column, column.cells.size());
+    }
+
+    switch (column.kind) {
+    case Column::Kind::Generic:
+        column.generic.append(value);
+        return;
+    case Column::Kind::Integer:
+        column.integers.append(value.toLongLong());
+        break;
+    case Column::Kind::Real:
+        column.reals.append(value.toDouble());
+        break;
+    case Column::Kind::Text:
+        column.texts.append(value.toString());
+        break;
+    case Column::Kind::Unset:
+        break;
+    }
+    column.cells.append(!value.isValid() ? CellInvalid : value.isNull() ? CellNull : CellValue);
+}
+
+/**
+ * @brief Sustituye el valor de una celda existente.
+ */
+void DBTable::assign(Column& column, int row, const QVariant& value) {
+    if (column.kind != Column::Kind::Generic && value.isValid()) {
+        if (column.kind == Column::Kind::Unset)
+            promote(column, value, column.cells.size());
+        else if (value.typeId() != column.typeId)
+            makeGeneric(column, column.cells.size());
+    }
+
+    switch (column.kind) {
+    case Column::Kind::Generic:
+        column.generic[row] = value;
+        return;
+    case Column::Kind::Integer:
+        column.integers[row] = value.toLongLong();
+        break;
+    case Column::Kind::Real:
+        column.reals[row] = value.toDouble();
+        break;
+    case Column::Kind::Text:
+        column.texts[row] = value.toString();
+        break;
+    case Column::Kind::Unset:
+        break;
+    }
+    column.cells[row] = !value.isValid() ? CellInvalid : value.isNull() ? CellNull : CellValue;
+}
+
+/**
+ * @brief Fija el tipo de una columna sin valores a partir del primer valor válido. Las celdas previas quedan
+ * inválidas.
+ */
+void DBTable::promote(Column& column, const QVariant& value, int rowCount) {
+    column.kind = kindOf(value.typeId());
+    column.typeId = value.typeId();
+
+    switch (column.kind) {
+    case Column::Kind::Integer: column.integers.fill(0, rowCount); break;
+    case Column::Kind::Real: column.reals.fill(0.0, rowCount); break;
+    case Column::Kind::Text: column.texts.fill(QString(), rowCount); break;
+    case Column::Kind::Generic:
+        column.generic.fill(QVariant(), rowCount);
+        column.cells.clear();
+        break;
+    case Column::Kind::Unset: break;
+    }
+}
+
+/**
+ * @brief Pasa una columna tipada a almacenamiento genérico conservando sus valores.
+ */
+void DBTable::makeGeneric(Column& column, int rowCount) {
+    QList<QVariant> values;
+    values.reserve(rowCount);
+    for (int row = 0; row < rowCount; ++row)
+        values.append(cell(column, row));
+
+    column = Column();
+    column.kind = Column::Kind::Generic;
+    column.generic = std::move(values);
+}
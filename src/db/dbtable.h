@@ -5,6 +5,10 @@
  * Esta clase ofrece una representación simple de una tabla relacional,
  * permitiendo acceder, modificar y consultar filas y columnas utilizando nombres de columnas.
  * Se utiliza principalmente como intermediario entre la base de datos y las capas superiores de la aplicación.
+ *
+ * Los datos se guardan por columnas: cada columna con valores de un único tipo (entero, real o texto) usa un
+ * vector de ese tipo, y solo las columnas mixtas guardan QVariant. Los nombres de columna se resuelven con un
+ * hash construido al fijar las columnas.
  */
 
 #ifndef DBTABLE_H
@@ -12,6 +16,8 @@
 
 #include <QStringList>
 #include <QVariant>
+#include <QHash>
+#include <QList>
 
 /**
  * @class DBTable
@@ -19,6 +25,10 @@
  *
  * Proporciona métodos para insertar y acceder a datos tabulares de forma estructurada.
  * Útil para gestionar datos provenientes de SQLite u otros motores relacionales en la lógica de la aplicación.
+ *
+ * En bucles sobre muchas filas conviene resolver la columna una vez con columnIndex() y usar los accesores por
+ * índice (value(int, int), intValue(), doubleValue(), stringValue()). La tabla se devuelve por valor y se mueve
+ * sin copiar sus columnas.
  */
 class DBTable
 {
@@ -37,6 +47,42 @@ public:
      */
     QVariant value(int row, const QString& column) const;
 
+    /**
+     * @brief Devuelve el valor de una celda por fila e índice de columna.
+     * @param row Índice de fila.
+     * @param column Índice de la columna (ver columnIndex()).
+     * @return Valor de la celda, o QVariant inválido si la posición no existe.
+     */
+    QVariant value(int row, int column) const;
+
+    /**
+     * @brief Valor entero de una celda, leído directamente si la columna es entera.
+     * @param row Índice de fila.
+     * @param column Índice de la columna.
+     */
+    int intValue(int row, int column) const;
+
+    /**
+     * @brief Valor real de una celda, leído directamente si la columna es real.
+     * @param row Índice de fila.
+     * @param column Índice de la columna.
+     */
+    double doubleValue(int row, int column) const;
+
+    /**
+     * @brief Valor de texto de una celda, leído directamente si la columna es de texto.
+     * @param row Índice de fila.
+     * @param column Índice de la columna.
+     */
+    QString stringValue(int row, int column) const;
+
+    /**
+     * @brief Devuelve la posición de una columna (sin distinguir mayúsculas).
+     * @param column Nombre de la columna.
+     * @return Índice de la columna, o -1 si no existe.
+     */
+    int columnIndex(const QString& column) const;
+
     /**
      * @brief Establece el valor de una celda.
      * @param row Índice de fila.
@@ -45,6 +91,14 @@ public:
      */
     void setValue(int row, const QString& column, QVariant new_value);
 
+    /**
+     * @brief Establece el valor de una celda por índice de columna.
+     * @param row Índice de fila.
+     * @param column Índice de la columna.
+     * @param new_value Nuevo valor a asignar.
+     */
+    void setValue(int row, int column, const QVariant& new_value);
+
     /**
      * @brief Devuelve el número de filas actuales en la tabla.
      */
@@ -69,12 +123,27 @@ public:
 
     /**
      * @brief Establece los nombres de las columnas.
+     *
+     * Si la tabla ya tiene filas, las columnas nuevas quedan vacías y las que sobran se descartan.
      * @param colNames Lista de nombres de columnas.
      */
     void setColumns(const QStringList& colNames);
 
+    /**
+     * @brief Reserva espacio para un número de filas.
+     * @param rowCount Número de filas esperado.
+     */
+    void reserve(int rowCount);
+
+    /**
+     * @brief Elimina todas las filas conservando las columnas y su tipo.
+     */
+    void clearRows();
+
     /**
      * @brief Añade una nueva fila a la tabla.
+     *
+     * Los valores se reparten entre las columnas en orden; las columnas sin valor quedan vacías.
      * @param rowData Lista de valores a insertar.
      */
     void addRow(const QList<QVariant>& rowData);
@@ -112,13 +181,45 @@ public:
     friend class TestDBTable;
 
 private:
+    /// Datos de una columna. Solo se usa el vector que corresponde a `kind`.
+    struct Column {
+        /// Tipo de almacenamiento.
+        enum class Kind : quint8 {
+            Unset,    ///< Sin valores válidos todavía.
+            Integer,  ///< int o qlonglong (`integers`).
+            Real,     ///< double (`reals`).
+            Text,     ///< QString (`texts`).
+            Generic   ///< Tipos mixtos u otros tipos (`generic`).
+        };
+
+        Kind kind = Kind::Unset;
+        int typeId = QMetaType::UnknownType; ///< Tipo exacto de los valores en las columnas tipadas.
+        QList<qint64> integers;
+        QList<double> reals;
+        QList<QString> texts;
+        QList<QVariant> generic;
+        QList<quint8> cells;                 ///< Estado de cada celda en las columnas no genéricas (CellState).
+    };
+
+    /// Estado de una celda de una columna tipada.
+    enum CellState : quint8 {
+        CellValue = 0,  ///< Contiene un valor.
+        CellInvalid,    ///< QVariant inválido.
+        CellNull        ///< Nulo del tipo de la columna (NULL de SQL).
+    };
+
     QString tableName;                     ///< Nombre lógico de la tabla.
     QStringList columns;                   ///< Lista de nombres de columnas.
-    QList<QList<QVariant>> rows;           ///< Datos tabulares: filas con valores ordenados por columna.
-
-    // Alternativas futuras:
-    // QList<QHash<QString, QVariant>> rows;
-    // QHash<int, QHash<QString, QVariant>> rows;
+    QHash<QString, int> columnIndexes;     ///< Nombre (original y en minúsculas) → índice de columna.
+    QList<Column> data;                    ///< Datos por columnas.
+    int rowTotal = 0;                      ///< Número de filas.
+
+    static Column::Kind kindOf(int typeId);
+    static QVariant cell(const Column& column, int row);
+    static void append(Column& column, const QVariant& value);
+    static void assign(Column& column, int row, const QVariant& value);
+    static void promote(Column& column, const QVariant& value, int rowCount);
+    static void makeGeneric(Column& column, int rowCount);
 };
 
 #endif // DBTABLE_H
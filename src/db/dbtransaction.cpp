@@ -0,0 +1,37 @@
+/**
+ * @file dbtransaction.cpp
+ * @brief Implementación de la clase DBTransaction.
+ */
+
+#include "dbtransaction.h"
+#include "core/dbmanager.h"
+
+DBTransaction::DBTransaction(DBManager* db)
+    : db(db)
+{
+    active = db && db->beginTransaction();
+}
+
+DBTransaction::~DBTransaction()
+{
+    if (active) rollback();
+}
+
+bool DBTransaction::commit()
+{
+    if (!active) return true;
+    active = false;
+    return db->commitTransaction();
+}
+
+void DBTransaction::rollback()
+{
+    if (!active) return;
+    active = false;
+    db->rollbackTransaction();
+}
+
+bool DBTransaction::isActive() const
+{
+    return active;
+}
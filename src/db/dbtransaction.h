@@ -0,0 +1,71 @@
+/**
+ * @file dbtransaction.h
+ * @brief Declaración de la clase DBTransaction, transacción de base de datos con ámbito (RAII).
+ *
+ * Agrupa varias escrituras en una única transacción SQLite, de modo que se confirman con un solo
+ * commit (y una sola sincronización a disco) o se deshacen juntas si alguna falla.
+ */
+
+#ifndef DBTRANSACTION_H
+#define DBTRANSACTION_H
+
+class DBManager;
+
+/**
+ * @class DBTransaction
+ * @brief Abre una transacción al construirse y la deshace al destruirse si no se ha confirmado.
+ *
+ * Las transacciones se pueden anidar: la más externa usa BEGIN/COMMIT y las internas se implementan con
+ * SAVEPOINT/RELEASE, por lo que un repositorio puede abrir su propia transacción aunque quien lo llama ya
+ * tenga otra abierta. Deshacer una transacción interna solo descarta sus propios cambios.
+ *
+ * Uso típico:
+ * @code
+ * DBTransaction tx(dbManager);
+ * if (!dbManager->save(...)) return -1;   // el destructor deshace los cambios
+ * if (!dbManager->save(...)) return -1;
+ * return tx.commit() ? id : -1;
+ * @endcode
+ */
+class DBTransaction
+{
+public:
+    /**
+     * @brief Abre una transacción (o un savepoint si ya hay una abierta).
+     * @param db Gestor de base de datos sobre el que se abre.
+     */
+    explicit DBTransaction(DBManager* db);
+
+    /**
+     * @brief Deshace la transacción si sigue abierta.
+     */
+    ~DBTransaction();
+
+    DBTransaction(const DBTransaction&) = delete;
+    DBTransaction& operator=(const DBTransaction&) = delete;
+
+    /**
+     * @brief Confirma la transacción.
+     *
+     * Si no se pudo abrir (por ejemplo, con la base de datos cerrada), las escrituras ya se han aplicado
+     * individualmente y se devuelve true.
+     * @return false si el COMMIT o el RELEASE fallan.
+     */
+    bool commit();
+
+    /**
+     * @brief Deshace los cambios realizados desde que se abrió la transacción.
+     */
+    void rollback();
+
+    /**
+     * @brief Indica si la transacción está abierta.
+     */
+    bool isActive() const;
+
+private:
+    DBManager* db;       ///< Gestor de base de datos.
+    bool active = false; ///< true mientras la transacción no se haya confirmado ni deshecho.
+};
+
+#endif // DBTRANSACTION_H
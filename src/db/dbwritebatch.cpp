@@ -0,0 +1,70 @@
+/**
+ * @file dbwritebatch.cpp
+ * @brief Implementación de la serialización de DBWriteBatch.
+ */
+
+#include "dbwritebatch.h"
+#include <QDataStream>
+
+namespace {
+constexpr quint32 kBatchMagic = 0x44425742; // "DBWB"
+constexpr quint16 kBatchVersion = 1;
+}
+
+/**
+ * @brief Formato: magic, versión, id, descripción, número de tablas y, por tabla, su tipo, nombre, columnas y filas.
+ */
+QByteArray DBWriteBatch::toBinary() const
+{
+    QByteArray out;
+    QDataStream stream(&out, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << kBatchMagic << kBatchVersion << id << description << quint32(tables.size());
+
+    for (const auto& entry : tables) {
+        const DBTable& table = entry.second;
+        stream << qint32(entry.first) << table.getTableName() << table.getColumnsNames() << quint32(table.rowCount());
+        for (int row = 0; row < table.rowCount(); ++row)
+            stream << table.getRow(row);
+    }
+    return out;
+}
+
+bool DBWriteBatch::fromBinary(const QByteArray& data)
+{
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    quint32 count = 0;
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok || magic != kBatchMagic || version != kBatchVersion) return false;
+
+    QString newId, newDescription;
+    stream >> newId >> newDescription >> count;
+
+    QList<QPair<TypeBDEnum, DBTable>> newTables;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        qint32 tipo = 0;
+        QString tableName;
+        QStringList columns;
+        quint32 rows = 0;
+        stream >> tipo >> tableName >> columns >> rows;
+
+        DBTable table(tableName);
+        table.setColumns(columns);
+        for (quint32 row = 0; row < rows && stream.status() == QDataStream::Ok; ++row) {
+            QList<QVariant> values;
+            stream >> values;
+            table.addRow(values);
+        }
+        newTables.append(qMakePair(static_cast<TypeBDEnum>(tipo), table));
+    }
+    if (stream.status() != QDataStream::Ok) return false;
+
+    id = newId;
+    description = newDescription;
+    tables = newTables;
+    return true;
+}
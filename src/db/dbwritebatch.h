@@ -0,0 +1,47 @@
+/**
+ * @file dbwritebatch.h
+ * @brief Declaración de DBWriteBatch, conjunto de escrituras que se confirman en una sola transacción.
+ */
+
+#ifndef DBWRITEBATCH_H
+#define DBWRITEBATCH_H
+
+#include <QByteArray>
+#include <QList>
+#include <QMetaType>
+#include <QPair>
+#include <QString>
+#include "db/dbtable.h"
+#include "enums/TypeBDEnum.h"
+
+/**
+ * @struct DBWriteBatch
+ * @brief Instantánea inmutable de las filas a guardar en varias tablas.
+ *
+ * Se construye en el hilo de la interfaz con los datos ya convertidos a DBTable, de modo que se puede pasar a
+ * otro hilo (los contenedores de Qt se comparten de forma segura entre hilos) y guardarse en disco como
+ * entrada del diario de escrituras pendientes. Guardar dos veces el mismo lote produce el mismo resultado,
+ * porque las filas llevan ya sus claves primarias y se escriben con REPLACE.
+ */
+struct DBWriteBatch {
+    QString id;                                   ///< Identificador del lote (nombre de su entrada en el diario).
+    QString description;                          ///< Descripción para los logs y los mensajes de error.
+    QList<QPair<TypeBDEnum, DBTable>> tables;     ///< Tablas a guardar, en orden.
+
+    /**
+     * @brief Serializa el lote (QDataStream, Qt 6.0).
+     * @return Bloque binario con el lote.
+     */
+    QByteArray toBinary() const;
+
+    /**
+     * @brief Carga un lote serializado con toBinary().
+     * @param data Bloque binario.
+     * @return false si el bloque no es un lote válido.
+     */
+    bool fromBinary(const QByteArray& data);
+};
+
+Q_DECLARE_METATYPE(DBWriteBatch)
+
+#endif // DBWRITEBATCH_H
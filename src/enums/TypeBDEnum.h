@@ -40,6 +40,10 @@ enum class TypeBDEnum {
     TrainingSesion,          ///< Sesión de entrenamiento realizada.
     ExerciseSummary,         ///< Resumen de ejecución para un ejercicio específico.
     SesionReport,            ///< Informe completo de una sesión.
+    SesionSummary,           ///< Resumen compacto de una sesión para las tendencias de progreso.
+    SesionRollupDaily,       ///< Acumulado diario de los resúmenes de sesión por cliente y ejercicio.
+    SesionRollupWeekly,      ///< Acumulado semanal de los resúmenes de sesión por cliente y ejercicio.
+    UserPicture,             ///< Imagen de perfil y miniatura de un usuario.
     Unknown                  ///< Valor no reconocido o sin clasificar.
 };
 
@@ -71,6 +75,10 @@ inline QString TypeBDEnumToString(TypeBDEnum tipo) {
     case TypeBDEnum::TrainingSesion: return "TrainingSesion";
     case TypeBDEnum::ExerciseSummary: return "ExerciseSummary";
     case TypeBDEnum::SesionReport: return "SesionReport";
+    case TypeBDEnum::SesionSummary: return "SesionSummary";
+    case TypeBDEnum::SesionRollupDaily: return "SesionRollupDaily";
+    case TypeBDEnum::SesionRollupWeekly: return "SesionRollupWeekly";
+    case TypeBDEnum::UserPicture: return "UserPicture";
 
 
     default: return "Unknown";
@@ -106,6 +114,10 @@ inline TypeBDEnum TypeBDEnumFromString(const QString& str) {
     if (s == "trainingsesion") return TypeBDEnum::TrainingSesion;
     if (s == "exercisesummary") return TypeBDEnum::ExerciseSummary;
     if (s == "sesionreport") return TypeBDEnum::SesionReport;
+    if (s == "sesionsummary") return TypeBDEnum::SesionSummary;
+    if (s == "sesionrollupdaily") return TypeBDEnum::SesionRollupDaily;
+    if (s == "sesionrollupweekly") return TypeBDEnum::SesionRollupWeekly;
+    if (s == "userpicture") return TypeBDEnum::UserPicture;
 
     return TypeBDEnum::Unknown;
 }
@@ -0,0 +1,248 @@
+/*!
+ * \file angleaccumulator.cpp
+ * \brief Implementación de la clase AngleAccumulator.
+ *
+ * Los tres arrays (mínimos, máximos y sobrecargas) comparten la misma disposición:
+ * offset = ((((serie·R + rep)·N + estado)·V + vista)·L + línea), con la línea como índice más interno
+ * para que las líneas de un mismo frame queden contiguas en memoria.
+ */
+
+#include "angleaccumulator.h"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+const double kUnset = std::numeric_limits<double>::quiet_NaN();
+}
+
+/*!
+ * \brief Constructor por defecto: tensor vacío que crece bajo demanda.
+ */
+AngleAccumulator::AngleAccumulator() {}
+
+/*!
+ * \brief Preasigna el tensor. Las series y repeticiones se indexan por su número (empiezan en 1), por lo
+ * que se reserva una posición adicional en cada dimensión.
+ */
+AngleAccumulator::AngleAccumulator(int series, int repetitions, const QList<int>& stateIds, const QStringList& lines)
+{
+    for (int id : stateIds) {
+        if (stateIndex.contains(id)) continue;
+        stateIndex.insert(id, this->stateIds.size());
+        this->stateIds.append(id);
+    }
+    for (const QString& line : lines) {
+        if (lineIds.contains(line)) continue;
+        lineIds.insert(line, lineNames.size());
+        lineNames.append(line);
+    }
+    reshape(qMax(series, 0) + 1, qMax(repetitions, 0) + 1, this->stateIds.size(), lineNames.size());
+}
+
+/*!
+ * \brief Offset del primer elemento (línea 0) de una celda [serie][rep][estado][vista].
+ */
+size_t AngleAccumulator::cellOffset(int serie, int rep, int state, int view) const
+{
+    return ((((static_cast<size_t>(serie) * repsDim + rep) * statesDim + state) * VIEW_COUNT + view) * linesDim);
+}
+
+/*!
+ * \brief Redimensiona el tensor copiando los valores existentes a su nueva posición.
+ */
+void AngleAccumulator::reshape(int newSeries, int newReps, int newStates, int newLines)
+{
+    size_t newSize = static_cast<size_t>(newSeries) * newReps * newStates * VIEW_COUNT * newLines;
+    std::vector<double> newMins(newSize, kUnset);
+    std::vector<double> newMaxs(newSize, kUnset);
+    std::vector<double> newOverloads(newSize, kUnset);
+
+    if (linesDim > 0) {
+        for (int s = 0; s < seriesDim; ++s)
+            for (int r = 0; r < repsDim; ++r)
+                for (int n = 0; n < statesDim; ++n)
+                    for (int v = 0; v < VIEW_COUNT; ++v) {
+                        size_t from = cellOffset(s, r, n, v);
+                        size_t to = ((((static_cast<size_t>(s) * newReps + r) * newStates + n) * VIEW_COUNT + v) * newLines);
+                        std::copy_n(mins.begin() + from, linesDim, newMins.begin() + to);
+                        std::copy_n(maxs.begin() + from, linesDim, newMaxs.begin() + to);
+                        std::copy_n(overloads.begin() + from, linesDim, newOverloads.begin() + to);
+                    }
+    }
+
+    mins.swap(newMins);
+    maxs.swap(newMaxs);
+    overloads.swap(newOverloads);
+    seriesDim = newSeries;
+    repsDim = newReps;
+    statesDim = newStates;
+    linesDim = newLines;
+}
+
+/*!
+ * \brief Devuelve el índice compacto de un estado, registrándolo si es nuevo.
+ */
+int AngleAccumulator::stateSlot(int stateId)
+{
+    auto it = stateIndex.constFind(stateId);
+    if (it != stateIndex.constEnd()) return it.value();
+
+    int slot = stateIds.size();
+    stateIndex.insert(stateId, slot);
+    stateIds.append(stateId);
+    reshape(seriesDim, repsDim, statesDim + 1, linesDim);
+    return slot;
+}
+
+/*!
+ * \brief Devuelve el índice compacto de una línea, registrándola si es nueva.
+ */
+int AngleAccumulator::lineSlot(const QString& line)
+{
+    auto it = lineIds.constFind(line);
+    if (it != lineIds.constEnd()) return it.value();
+
+    int slot = lineNames.size();
+    lineIds.insert(line, slot);
+    lineNames.append(line);
+    reshape(seriesDim, repsDim, statesDim, linesDim + 1);
+    return slot;
+}
+
+/*!
+ * \brief Garantiza que la celda [serie][rep][estado] existe, ampliando el tensor si es necesario.
+ * \return false si la serie o la repetición son negativas.
+ */
+bool AngleAccumulator::ensureCell(int serie, int rep, int stateId, int& stateSlotOut)
+{
+    if (serie < 0 || rep < 0) {
+        qWarning() << "[AngleAccumulator] Índice no válido, serie:" << serie << "rep:" << rep;
+        return false;
+    }
+    if (serie >= seriesDim || rep >= repsDim)
+        reshape(qMax(seriesDim, serie + 1), qMax(repsDim, rep + 1), statesDim, linesDim);
+
+    stateSlotOut = stateSlot(stateId);
+    return true;
+}
+
+/*!
+ * \brief Actualiza el mínimo y el máximo de cada línea del frame.
+ */
+void AngleAccumulator::addAngles(int serie, int rep, int stateId, PoseView view, const QHash<QString, double>& angles)
+{
+    int state;
+    if (angles.isEmpty() || !ensureCell(serie, rep, stateId, state)) return;
+
+    const int v = static_cast<int>(view);
+    size_t base = cellOffset(serie, rep, state, v);
+    for (auto it = angles.constBegin(); it != angles.constEnd(); ++it) {
+        int l = lineIds.value(it.key(), -1);
+        if (l < 0) {
+            l = lineSlot(it.key());
+            base = cellOffset(serie, rep, state, v);
+        }
+        const double angle = it.value();
+        double& mn = mins[base + l];
+        double& mx = maxs[base + l];
+        if (std::isnan(mn) || angle < mn) mn = angle;
+        if (std::isnan(mx) || angle > mx) mx = angle;
+    }
+    hasData = true;
+}
+
+/*!
+ * \brief Registra la sobrecarga de una línea en la celda indicada.
+ */
+void AngleAccumulator::setOverload(int serie, int rep, int stateId, PoseView view, const QString& line, double value)
+{
+    int state;
+    if (!ensureCell(serie, rep, stateId, state)) return;
+    int l = lineSlot(line);
+    overloads[cellOffset(serie, rep, state, static_cast<int>(view)) + l] = value;
+    hasData = true;
+}
+
+/*!
+ * \brief Sobrescribe el rango de una línea en la celda indicada.
+ */
+void AngleAccumulator::setRange(int serie, int rep, int stateId, PoseView view, const QString& line, double min, double max)
+{
+    int state;
+    if (!ensureCell(serie, rep, stateId, state)) return;
+    int l = lineSlot(line);
+    size_t idx = cellOffset(serie, rep, state, static_cast<int>(view)) + l;
+    mins[idx] = min;
+    maxs[idx] = max;
+    hasData = true;
+}
+
+bool AngleAccumulator::isEmpty() const
+{
+    return !hasData;
+}
+
+void AngleAccumulator::clear()
+{
+    std::fill(mins.begin(), mins.end(), kUnset);
+    std::fill(maxs.begin(), maxs.end(), kUnset);
+    std::fill(overloads.begin(), overloads.end(), kUnset);
+    hasData = false;
+}
+
+void AngleAccumulator::clearRanges()
+{
+    std::fill(mins.begin(), mins.end(), kUnset);
+    std::fill(maxs.begin(), maxs.end(), kUnset);
+    hasData = std::any_of(overloads.begin(), overloads.end(), [](double v) { return !std::isnan(v); });
+}
+
+void AngleAccumulator::clearOverloads()
+{
+    std::fill(overloads.begin(), overloads.end(), kUnset);
+    hasData = std::any_of(mins.begin(), mins.end(), [](double v) { return !std::isnan(v); });
+}
+
+/*!
+ * \brief Construye el mapa anidado de rangos con las celdas que tienen datos.
+ */
+QMap<int, QMap<int, QMap<int, QHash<PoseView, QHash<QString, QPair<double, double>>>>>> AngleAccumulator::toRangeMap() const
+{
+    QMap<int, QMap<int, QMap<int, QHash<PoseView, QHash<QString, QPair<double, double>>>>>> result;
+    if (!hasData) return result;
+
+    for (int s = 0; s < seriesDim; ++s)
+        for (int r = 0; r < repsDim; ++r)
+            for (int n = 0; n < statesDim; ++n)
+                for (int v = 0; v < VIEW_COUNT; ++v) {
+                    size_t base = cellOffset(s, r, n, v);
+                    for (int l = 0; l < linesDim; ++l) {
+                        if (std::isnan(mins[base + l])) continue;
+                        result[s][r][stateIds[n]][static_cast<PoseView>(v)][lineNames[l]] = qMakePair(mins[base + l], maxs[base + l]);
+                    }
+                }
+    return result;
+}
+
+/*!
+ * \brief Construye el mapa anidado de sobrecargas con las celdas que tienen datos.
+ */
+QMap<int, QMap<int, QMap<int, QHash<PoseView, QHash<QString, double>>>>> AngleAccumulator::toOverloadMap() const
+{
+    QMap<int, QMap<int, QMap<int, QHash<PoseView, QHash<QString, double>>>>> result;
+    if (!hasData) return result;
+
+    for (int s = 0; s < seriesDim; ++s)
+        for (int r = 0; r < repsDim; ++r)
+            for (int n = 0; n < statesDim; ++n)
+                for (int v = 0; v < VIEW_COUNT; ++v) {
+                    size_t base = cellOffset(s, r, n, v);
+                    for (int l = 0; l < linesDim; ++l) {
+                        if (std::isnan(overloads[base + l])) continue;
+                        result[s][r][stateIds[n]][static_cast<PoseView>(v)][lineNames[l]] = overloads[base + l];
+                    }
+                }
+    return result;
+}
@@ -0,0 +1,113 @@
+/*!
+ * \file angleaccumulator.h
+ * \brief Declaración de la clase AngleAccumulator.
+ *
+ * AngleAccumulator guarda el ángulo mínimo, el máximo y la última sobrecarga de cada línea, indexados por
+ * serie, repetición, estado y vista, en arrays contiguos preasignados al inicio del ejercicio. Sustituye a
+ * los mapas anidados de cinco niveles que se indexaban en cada frame.
+ */
+
+#ifndef ANGLEACCUMULATOR_H
+#define ANGLEACCUMULATOR_H
+
+#include <QHash>
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <vector>
+#include "enums/PoseViewEnum.h"
+
+/*!
+ * \class AngleAccumulator
+ * \brief Tensor denso [serie][repetición][estado][vista][línea] de rangos angulares y sobrecargas.
+ *
+ * Los estados y las líneas se traducen a índices compactos; las celdas sin datos se marcan con NaN. Si
+ * llega una serie, repetición, estado o línea fuera de las dimensiones iniciales, el tensor crece
+ * conservando los datos ya acumulados, de forma que el coste habitual por frame es un almacenamiento en
+ * array por línea.
+ *
+ * Las estructuras anidadas que consumen la interfaz y la serialización JSON se generan bajo demanda con
+ * toRangeMap() y toOverloadMap().
+ */
+class AngleAccumulator
+{
+public:
+    AngleAccumulator();
+
+    /*!
+     * \brief Constructor que preasigna el tensor para las dimensiones conocidas del ejercicio.
+     * \param series Número de series previstas.
+     * \param repetitions Número de repeticiones por serie.
+     * \param stateIds Identificadores de los estados de la máquina.
+     * \param lines Líneas conocidas de antemano (por ejemplo, las de las restricciones).
+     */
+    AngleAccumulator(int series, int repetitions, const QList<int>& stateIds, const QStringList& lines = {});
+
+    /*!
+     * \brief Actualiza mínimo y máximo de todas las líneas de un frame.
+     */
+    void addAngles(int serie, int rep, int stateId, PoseView view, const QHash<QString, double>& angles);
+
+    /*!
+     * \brief Registra el valor de sobrecarga de una línea (se conserva el último).
+     */
+    void setOverload(int serie, int rep, int stateId, PoseView view, const QString& line, double value);
+
+    /*!
+     * \brief Fija directamente el rango de una línea. Se usa al cargar desde JSON o desde mapas.
+     */
+    void setRange(int serie, int rep, int stateId, PoseView view, const QString& line, double min, double max);
+
+    /*!
+     * \brief Devuelve true si no se ha acumulado ningún valor.
+     */
+    bool isEmpty() const;
+
+    /*!
+     * \brief Descarta todos los valores manteniendo dimensiones e índices.
+     */
+    void clear();
+
+    /// Descarta solo los rangos (mínimos y máximos).
+    void clearRanges();
+
+    /// Descarta solo las sobrecargas.
+    void clearOverloads();
+
+    /*!
+     * \brief Genera la vista anidada de rangos [serie][rep][estado][vista][línea] → {min, max}.
+     */
+    QMap<int, QMap<int, QMap<int, QHash<PoseView, QHash<QString, QPair<double, double>>>>>> toRangeMap() const;
+
+    /*!
+     * \brief Genera la vista anidada de sobrecargas [serie][rep][estado][vista][línea] → valor.
+     */
+    QMap<int, QMap<int, QMap<int, QHash<PoseView, QHash<QString, double>>>>> toOverloadMap() const;
+
+private:
+    static constexpr int VIEW_COUNT = 5;
+
+    int seriesDim = 0;
+    int repsDim = 0;
+    int statesDim = 0;
+    int linesDim = 0;
+    bool hasData = false;
+
+    QList<int> stateIds;
+    QHash<int, int> stateIndex;
+    QStringList lineNames;
+    QHash<QString, int> lineIds;
+
+    std::vector<double> mins;
+    std::vector<double> maxs;
+    std::vector<double> overloads;
+
+    size_t cellOffset(int serie, int rep, int state, int view) const;
+    int stateSlot(int stateId);
+    int lineSlot(const QString& line);
+    bool ensureCell(int serie, int rep, int stateId, int& stateSlotOut);
+    void reshape(int newSeries, int newReps, int newStates, int newLines);
+};
+
+#endif // ANGLEACCUMULATOR_H
@@ -0,0 +1,475 @@
+/*!
+ * \file angleseriesrecorder.cpp
+ * \brief Implementación de la clase AngleSeriesRecorder.
+ *
+ * Formato de un frame dentro de un bloque:
+ * - incremento de tiempo respecto al frame anterior (varint),
+ * - incremento de serie y de repetición (varint zigzag),
+ * - un byte de presencia: 0 si están todas las líneas del bloque, 1 si sigue un mapa de bits con las presentes,
+ * - por cada línea presente, la diferencia del valor cuantizado respecto al anterior de esa línea (varint zigzag).
+ *
+ * El primer frame de cada bloque se codifica respecto a cero, por lo que guarda valores absolutos.
+ */
+
+#include "angleseriesrecorder.h"
+#include <QDebug>
+#include <QDataStream>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+void putVarint(QByteArray& out, uint64_t v)
+{
+    while (v >= 0x80) {
+        out.append(static_cast<char>((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    out.append(static_cast<char>(v));
+}
+
+uint64_t getVarint(const char*& p, const char* end)
+{
+    uint64_t v = 0;
+    int shift = 0;
+    while (p < end && shift < 64) {
+        uint8_t byte = static_cast<uint8_t>(*p++);
+        v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) break;
+        shift += 7;
+    }
+    return v;
+}
+
+uint64_t zigzag(int64_t v)
+{
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+int64_t unzigzag(uint64_t v)
+{
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+}
+
+/*!
+ * \brief Constructor. Ajusta los parámetros a valores válidos.
+ */
+AngleSeriesRecorder::AngleSeriesRecorder(qint64 memoryBudget, int blockFrames, double resolution)
+    : memoryBudget(memoryBudget), blockFrames(qMax(blockFrames, 1)), resolution(resolution > 0 ? resolution : 0.01)
+{
+}
+
+/*!
+ * \brief Copia las vistas y el estado del codificador; los bloques volcados pasan a memoria antes de aplicar el
+ * presupuesto de la copia.
+ */
+AngleSeriesRecorder::AngleSeriesRecorder(const AngleSeriesRecorder& other)
+    : memoryBudget(other.memoryBudget), blockFrames(other.blockFrames), resolution(other.resolution),
+      inMemoryBytes(other.inMemoryBytes), views(other.views), sealedOrder(other.sealedOrder)
+{
+    for (ViewSeries& vs : views) {
+        for (Block& block : vs.blocks) {
+            if (block.fileOffset < 0) continue;
+            block.data = other.blockData(block);
+            block.fileOffset = -1;
+            block.fileSize = 0;
+            inMemoryBytes += block.data.size();
+        }
+    }
+    spillIfNeeded();
+}
+
+AngleSeriesRecorder& AngleSeriesRecorder::operator=(const AngleSeriesRecorder& other)
+{
+    if (this != &other) *this = AngleSeriesRecorder(other);
+    return *this;
+}
+
+/*!
+ * \brief Codifica un frame en el bloque abierto de la vista, abriendo uno nuevo si es necesario.
+ */
+void AngleSeriesRecorder::record(PoseView view, int serie, int rep, int64_t time, const QHash<QString, double>& angles)
+{
+    if (angles.isEmpty()) return;
+
+    ViewSeries& vs = views[static_cast<int>(view)];
+    if (vs.frameCount > 0 && time < vs.lastTime) {
+        qWarning() << "[AngleSeriesRecorder] Frame fuera de orden descartado, time:" << time << "último:" << vs.lastTime;
+        return;
+    }
+
+    bool newLines = false;
+    for (auto it = angles.constBegin(); it != angles.constEnd(); ++it) {
+        if (vs.lineIds.contains(it.key())) continue;
+        vs.lineIds.insert(it.key(), vs.lineNames.size());
+        vs.lineNames.append(it.key());
+        newLines = true;
+    }
+
+    // Un bloque tiene un número fijo de líneas: si aparece una nueva se cierra el bloque en curso
+    if (!vs.blocks.empty() && !vs.blocks.back().sealed
+        && (newLines || vs.blocks.back().frames >= blockFrames))
+        sealBlock(vs);
+
+    if (vs.blocks.empty() || vs.blocks.back().sealed) {
+        Block block;
+        block.firstTime = time;
+        block.firstSerie = serie;
+        block.firstRep = rep;
+        block.lineCount = vs.lineNames.size();
+        vs.blocks.push_back(block);
+        vs.prevQ.assign(block.lineCount, 0);
+        vs.lastTime = time;
+        vs.lastSerie = serie;
+        vs.lastRep = rep;
+    }
+
+    const int blockIndex = static_cast<int>(vs.blocks.size()) - 1;
+    Block& block = vs.blocks.back();
+    QByteArray& out = block.data;
+    const qsizetype before = out.size();
+
+    putVarint(out, static_cast<uint64_t>(time - vs.lastTime));
+    putVarint(out, zigzag(serie - vs.lastSerie));
+    putVarint(out, zigzag(rep - vs.lastRep));
+
+    const bool complete = angles.size() == block.lineCount;
+    out.append(static_cast<char>(complete ? 0 : 1));
+    if (!complete) {
+        QByteArray bitmap((block.lineCount + 7) / 8, 0);
+        for (auto it = angles.constBegin(); it != angles.constEnd(); ++it) {
+            int l = vs.lineIds.value(it.key());
+            bitmap[l / 8] = static_cast<char>(bitmap[l / 8] | (1 << (l % 8)));
+        }
+        out.append(bitmap);
+    }
+
+    // Las líneas se escriben en orden de id para que el decodificador no necesite sus nombres
+    std::vector<int64_t> q(block.lineCount, 0);
+    std::vector<char> present(block.lineCount, 0);
+    for (auto it = angles.constBegin(); it != angles.constEnd(); ++it) {
+        int l = vs.lineIds.value(it.key());
+        q[l] = std::llround(it.value() / resolution);
+        present[l] = 1;
+    }
+    for (int l = 0; l < block.lineCount; ++l) {
+        if (!present[l]) continue;
+        putVarint(out, zigzag(q[l] - vs.prevQ[l]));
+        vs.prevQ[l] = q[l];
+    }
+
+    inMemoryBytes += out.size() - before;
+
+    QList<int>& repIndex = vs.repBlocks[qMakePair(serie, rep)];
+    if (repIndex.isEmpty() || repIndex.last() != blockIndex) repIndex.append(blockIndex);
+
+    block.frames++;
+    block.lastTime = time;
+    vs.lastTime = time;
+    vs.lastSerie = serie;
+    vs.lastRep = rep;
+    vs.frameCount++;
+}
+
+/*!
+ * \brief Cierra el bloque abierto de la vista y comprueba el presupuesto de memoria.
+ */
+void AngleSeriesRecorder::sealBlock(ViewSeries& vs)
+{
+    Block& block = vs.blocks.back();
+    block.sealed = true;
+    block.data.squeeze();
+
+    int view = static_cast<int>(&vs - views.data());
+    sealedOrder.push_back(qMakePair(view, static_cast<int>(vs.blocks.size()) - 1));
+    spillIfNeeded();
+}
+
+/*!
+ * \brief Vuelca a disco los bloques cerrados más antiguos mientras se supere el presupuesto.
+ *
+ * Si el fichero temporal no se puede abrir, los bloques permanecen en memoria.
+ */
+void AngleSeriesRecorder::spillIfNeeded()
+{
+    while (inMemoryBytes > memoryBudget && nextSpill < sealedOrder.size()) {
+        if (!spillFile) {
+            spillFile = std::make_unique<QTemporaryFile>();
+            if (!spillFile->open()) {
+                qWarning() << "[AngleSeriesRecorder] No se pudo crear el fichero de volcado:" << spillFile->errorString();
+                spillFile.reset();
+                memoryBudget = std::numeric_limits<qint64>::max();
+                return;
+            }
+        }
+
+        const QPair<int, int> ref = sealedOrder[nextSpill++];
+        Block& block = views[ref.first].blocks[ref.second];
+
+        qint64 offset = spillFile->size();
+        spillFile->seek(offset);
+        if (spillFile->write(block.data) != block.data.size()) {
+            qWarning() << "[AngleSeriesRecorder] Error al volcar bloque:" << spillFile->errorString();
+            return;
+        }
+
+        block.fileOffset = offset;
+        block.fileSize = block.data.size();
+        inMemoryBytes -= block.fileSize;
+        spilledBytes += block.fileSize;
+        block.data = QByteArray();
+    }
+}
+
+/*!
+ * \brief Devuelve los datos codificados de un bloque, leyéndolos del fichero si fue volcado.
+ */
+QByteArray AngleSeriesRecorder::blockData(const Block& block) const
+{
+    if (block.fileOffset < 0) return block.data;
+
+    if (!spillFile || !spillFile->seek(block.fileOffset)) {
+        qWarning() << "[AngleSeriesRecorder] No se pudo leer el bloque en la posición" << block.fileOffset;
+        return QByteArray();
+    }
+    QByteArray data = spillFile->read(block.fileSize);
+    spillFile->seek(spillFile->size());
+    return data;
+}
+
+/*!
+ * \brief Decodifica todos los frames de un bloque.
+ */
+QList<AngleFrame> AngleSeriesRecorder::decodeBlock(const ViewSeries& vs, const Block& block) const
+{
+    QList<AngleFrame> result;
+    const QByteArray data = blockData(block);
+    if (data.isEmpty()) return result;
+
+    // Cada frame ocupa al menos un byte, así que un recuento corrupto no puede reservar más que el bloque
+    result.reserve(qMin(block.frames, int(data.size())));
+    const char* p = data.constData();
+    const char* end = p + data.size();
+
+    std::vector<int64_t> prev(block.lineCount, 0);
+    std::vector<char> present(block.lineCount, 1);
+    int64_t time = block.firstTime;
+    int serie = block.firstSerie;
+    int rep = block.firstRep;
+
+    for (int f = 0; f < block.frames && p < end; ++f) {
+        time += static_cast<int64_t>(getVarint(p, end));
+        serie += static_cast<int>(unzigzag(getVarint(p, end)));
+        rep += static_cast<int>(unzigzag(getVarint(p, end)));
+
+        const bool complete = p < end && *p++ == 0;
+        if (complete) {
+            std::fill(present.begin(), present.end(), 1);
+        } else {
+            const int bitmapBytes = (block.lineCount + 7) / 8;
+            if (end - p < bitmapBytes) {
+                qWarning() << "[AngleSeriesRecorder] Bloque truncado en el frame" << f;
+                break;
+            }
+            const char* bitmap = p;
+            p += bitmapBytes;
+            for (int l = 0; l < block.lineCount; ++l)
+                present[l] = (static_cast<uint8_t>(bitmap[l / 8]) >> (l % 8)) & 1;
+        }
+
+        AngleFrame frame;
+        frame.time = time;
+        frame.serie = serie;
+        frame.rep = rep;
+        for (int l = 0; l < block.lineCount; ++l) {
+            if (!present[l]) continue;
+            prev[l] += unzigzag(getVarint(p, end));
+            frame.angles.insert(vs.lineNames[l], prev[l] * resolution);
+        }
+        result.append(frame);
+    }
+
+    return result;
+}
+
+/*!
+ * \brief Localiza el bloque por búsqueda binaria sobre su primer timestamp y decodifica solo ese bloque.
+ */
+bool AngleSeriesRecorder::frameAt(PoseView view, int64_t time, AngleFrame& out) const
+{
+    const ViewSeries& vs = views[static_cast<int>(view)];
+    auto it = std::upper_bound(vs.blocks.begin(), vs.blocks.end(), time,
+                               [](int64_t t, const Block& b) { return t < b.firstTime; });
+    if (it == vs.blocks.begin()) return false;
+    --it;
+
+    const QList<AngleFrame> decoded = decodeBlock(vs, *it);
+    for (int i = decoded.size() - 1; i >= 0; --i) {
+        if (decoded[i].time <= time) {
+            out = decoded[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+QList<AngleFrame> AngleSeriesRecorder::frames(PoseView view, int64_t from, int64_t to) const
+{
+    QList<AngleFrame> result;
+    const ViewSeries& vs = views[static_cast<int>(view)];
+
+    for (const Block& block : vs.blocks) {
+        if (block.lastTime < from) continue;
+        if (block.firstTime > to) break;
+        for (const AngleFrame& frame : decodeBlock(vs, block)) {
+            if (frame.time >= from && frame.time <= to) result.append(frame);
+        }
+    }
+    return result;
+}
+
+QList<AngleFrame> AngleSeriesRecorder::framesFor(PoseView view, int serie, int rep) const
+{
+    QList<AngleFrame> result;
+    const ViewSeries& vs = views[static_cast<int>(view)];
+
+    for (int index : vs.repBlocks.value(qMakePair(serie, rep))) {
+        for (const AngleFrame& frame : decodeBlock(vs, vs.blocks[index])) {
+            if (frame.serie == serie && frame.rep == rep) result.append(frame);
+        }
+    }
+    return result;
+}
+
+QStringList AngleSeriesRecorder::getLines(PoseView view) const
+{
+    return views[static_cast<int>(view)].lineNames;
+}
+
+int AngleSeriesRecorder::frameCount(PoseView view) const
+{
+    return views[static_cast<int>(view)].frameCount;
+}
+
+qint64 AngleSeriesRecorder::compressedSize() const
+{
+    return inMemoryBytes + spilledBytes;
+}
+
+qint64 AngleSeriesRecorder::memoryUsage() const
+{
+    return inMemoryBytes;
+}
+
+bool AngleSeriesRecorder::isEmpty() const
+{
+    return std::all_of(views.begin(), views.end(), [](const ViewSeries& vs) { return vs.frameCount == 0; });
+}
+
+void AngleSeriesRecorder::clear()
+{
+    for (ViewSeries& vs : views) vs = ViewSeries();
+    sealedOrder.clear();
+    nextSpill = 0;
+    inMemoryBytes = 0;
+    spilledBytes = 0;
+    spillFile.reset();
+}
+
+/*!
+ * \brief Escribe, por vista, el diccionario de líneas, el índice de repeticiones y los bloques tal como
+ * están codificados (los volcados a disco se leen del fichero).
+ */
+QByteArray AngleSeriesRecorder::serialize() const
+{
+    QByteArray out;
+    QDataStream stream(&out, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    stream << quint16(1) << resolution << qint32(blockFrames);
+    for (const ViewSeries& vs : views) {
+        stream << vs.lineNames << vs.repBlocks << qint32(vs.frameCount) << quint32(vs.blocks.size());
+        for (const Block& block : vs.blocks) {
+            stream << qint64(block.firstTime) << qint64(block.lastTime)
+                   << qint32(block.firstSerie) << qint32(block.firstRep)
+                   << qint32(block.frames) << qint32(block.lineCount)
+                   << blockData(block);
+        }
+    }
+    return out;
+}
+
+/*!
+ * \brief Reconstruye las vistas a partir de serialize(), aplicando el presupuesto de memoria.
+ */
+bool AngleSeriesRecorder::deserialize(const QByteArray& data)
+{
+    clear();
+
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint16 version;
+    qint32 frames;
+    stream >> version >> resolution >> frames;
+    if (stream.status() != QDataStream::Ok || version != 1 || resolution <= 0) {
+        qWarning() << "[AngleSeriesRecorder] Datos serializados no válidos, versión:" << version;
+        clear();
+        return false;
+    }
+    blockFrames = qMax(int(frames), 1);
+
+    for (int v = 0; v < VIEW_COUNT; ++v) {
+        ViewSeries& vs = views[v];
+        quint32 blockCount;
+        qint32 frameCount;
+        stream >> vs.lineNames >> vs.repBlocks >> frameCount >> blockCount;
+        vs.frameCount = frameCount;
+        for (int l = 0; l < vs.lineNames.size(); ++l) vs.lineIds.insert(vs.lineNames[l], l);
+
+        for (quint32 b = 0; b < blockCount && stream.status() == QDataStream::Ok; ++b) {
+            Block block;
+            qint64 firstTime, lastTime;
+            qint32 firstSerie, firstRep, blockFramesRead, lineCount;
+            stream >> firstTime >> lastTime >> firstSerie >> firstRep >> blockFramesRead >> lineCount >> block.data;
+            block.firstTime = firstTime;
+            block.lastTime = lastTime;
+            block.firstSerie = firstSerie;
+            block.firstRep = firstRep;
+            block.frames = blockFramesRead;
+            block.lineCount = lineCount;
+            block.sealed = true;
+            if (blockFramesRead < 0 || lineCount < 0 || lineCount > vs.lineNames.size()) {
+                qWarning() << "[AngleSeriesRecorder] Bloque no válido, frames:" << blockFramesRead
+                           << "líneas:" << lineCount << "de" << vs.lineNames.size();
+                clear();
+                return false;
+            }
+            inMemoryBytes += block.data.size();
+            vs.blocks.push_back(block);
+            sealedOrder.push_back(qMakePair(v, int(b)));
+        }
+        if (!vs.blocks.empty()) vs.lastTime = vs.blocks.back().lastTime;
+
+        for (const QList<int>& indices : std::as_const(vs.repBlocks)) {
+            for (int index : indices) {
+                if (index >= 0 && index < int(vs.blocks.size())) continue;
+                qWarning() << "[AngleSeriesRecorder] Índice de bloque no válido:" << index << "de" << vs.blocks.size();
+                clear();
+                return false;
+            }
+        }
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "[AngleSeriesRecorder] Datos serializados truncados";
+        clear();
+        return false;
+    }
+
+    spillIfNeeded();
+    return true;
+}
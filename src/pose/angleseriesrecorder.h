@@ -0,0 +1,172 @@
+/*!
+ * \file angleseriesrecorder.h
+ * \brief Declaración de la clase AngleSeriesRecorder.
+ *
+ * AngleSeriesRecorder conserva la serie temporal completa de ángulos de cada vista durante una sesión, de
+ * forma comprimida, para poder dibujar o analizar la evolución de cada línea y no solo su rango.
+ */
+
+#ifndef ANGLESERIESRECORDER_H
+#define ANGLESERIESRECORDER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryFile>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "enums/PoseViewEnum.h"
+
+/*!
+ * \struct AngleFrame
+ * \brief Ángulos de una vista en un frame analizado.
+ */
+struct AngleFrame {
+    int64_t time = 0;               ///< Timestamp del frame en milisegundos.
+    int serie = 0;                  ///< Serie en curso.
+    int rep = 0;                    ///< Repetición en curso.
+    QHash<QString, double> angles;  ///< Ángulo por línea (solo las líneas detectadas en el frame).
+};
+
+/*!
+ * \class AngleSeriesRecorder
+ * \brief Registro comprimido de los ángulos de todos los frames de una sesión.
+ *
+ * Cada vista guarda sus frames en bloques de tamaño fijo. Dentro de un bloque los ángulos se cuantizan en
+ * punto fijo (centésimas de grado por defecto) y se codifican como diferencia respecto al valor anterior de
+ * la misma línea en un entero de longitud variable, de modo que un ángulo que apenas cambia ocupa uno o
+ * dos bytes. Cada bloque empieza con valores absolutos y se decodifica de forma independiente.
+ *
+ * Cuando los bloques cerrados superan el presupuesto de memoria, los más antiguos se vuelcan a un fichero
+ * temporal y se leen de él bajo demanda. Un índice por timestamp y por (serie, repetición) permite
+ * recuperar un frame o una repetición decodificando solo los bloques implicados.
+ */
+class AngleSeriesRecorder
+{
+public:
+    /*!
+     * \brief Constructor.
+     * \param memoryBudget Bytes comprimidos que se mantienen en memoria antes de volcar a disco.
+     * \param blockFrames Número de frames por bloque.
+     * \param resolution Resolución de la cuantización en grados.
+     */
+    explicit AngleSeriesRecorder(qint64 memoryBudget = 4 * 1024 * 1024, int blockFrames = 256, double resolution = 0.01);
+
+    /*!
+     * \brief Constructor de copia.
+     *
+     * La copia lee los bloques volcados del fichero del original y, si supera el presupuesto, los vuelca a un
+     * fichero propio, de modo que ambos registros son independientes. Como cualquier lectura, debe hacerse desde
+     * el hilo que usa el original.
+     */
+    AngleSeriesRecorder(const AngleSeriesRecorder& other);
+    AngleSeriesRecorder& operator=(const AngleSeriesRecorder& other);
+    AngleSeriesRecorder(AngleSeriesRecorder&&) = default;
+    AngleSeriesRecorder& operator=(AngleSeriesRecorder&&) = default;
+
+    /*!
+     * \brief Añade los ángulos de un frame de una vista.
+     *
+     * Los frames deben llegar en orden de timestamp; los anteriores al último registrado se descartan.
+     */
+    void record(PoseView view, int serie, int rep, int64_t time, const QHash<QString, double>& angles);
+
+    /*!
+     * \brief Recupera el último frame con timestamp menor o igual que `time`.
+     * \return false si la vista no tiene frames anteriores a ese instante.
+     */
+    bool frameAt(PoseView view, int64_t time, AngleFrame& out) const;
+
+    /*!
+     * \brief Devuelve los frames de una vista en el intervalo [from, to].
+     */
+    QList<AngleFrame> frames(PoseView view, int64_t from, int64_t to) const;
+
+    /*!
+     * \brief Devuelve todos los frames de una repetición en una vista.
+     */
+    QList<AngleFrame> framesFor(PoseView view, int serie, int rep) const;
+
+    /// Líneas registradas en la vista, en el orden de aparición.
+    QStringList getLines(PoseView view) const;
+
+    /// Número de frames registrados en la vista.
+    int frameCount(PoseView view) const;
+
+    /// Bytes comprimidos de todas las vistas, incluidos los volcados a disco.
+    qint64 compressedSize() const;
+
+    /// Bytes comprimidos que permanecen en memoria.
+    qint64 memoryUsage() const;
+
+    /// true si no se ha registrado ningún frame.
+    bool isEmpty() const;
+
+    /// Descarta todos los frames y el fichero de volcado.
+    void clear();
+
+    /*!
+     * \brief Serializa los bloques de todas las vistas sin decodificarlos.
+     * \return Datos binarios para deserialize().
+     */
+    QByteArray serialize() const;
+
+    /*!
+     * \brief Sustituye el contenido por el de serialize(). Los bloques cargados se consideran cerrados.
+     * \return false si los datos no tienen un formato válido.
+     */
+    bool deserialize(const QByteArray& data);
+
+private:
+    static constexpr int VIEW_COUNT = 5;
+
+    /// Bloque de frames consecutivos de una vista.
+    struct Block {
+        int64_t firstTime = 0;
+        int64_t lastTime = 0;
+        int firstSerie = 0;
+        int firstRep = 0;
+        int frames = 0;
+        int lineCount = 0;
+        bool sealed = false;
+        QByteArray data;        ///< Datos codificados (vacío si el bloque está en disco).
+        qint64 fileOffset = -1; ///< Posición en el fichero de volcado.
+        int fileSize = 0;
+    };
+
+    /// Frames de una vista y estado del codificador del bloque abierto.
+    struct ViewSeries {
+        QStringList lineNames;
+        QHash<QString, int> lineIds;
+        std::vector<Block> blocks;
+        QMap<QPair<int, int>, QList<int>> repBlocks; ///< Bloques que contienen cada (serie, repetición).
+        std::vector<int64_t> prevQ;
+        int64_t lastTime = 0;
+        int lastSerie = 0;
+        int lastRep = 0;
+        int frameCount = 0;
+    };
+
+    qint64 memoryBudget;
+    int blockFrames;
+    double resolution;
+    qint64 inMemoryBytes = 0;
+    qint64 spilledBytes = 0;
+    std::array<ViewSeries, VIEW_COUNT> views;
+    std::vector<QPair<int, int>> sealedOrder; ///< (vista, bloque) en el orden en que se cerraron.
+    size_t nextSpill = 0;
+    std::unique_ptr<QTemporaryFile> spillFile;
+
+    void sealBlock(ViewSeries& vs);
+    void spillIfNeeded();
+    QByteArray blockData(const Block& block) const;
+    QList<AngleFrame> decodeBlock(const ViewSeries& vs, const Block& block) const;
+};
+
+#endif // ANGLESERIESRECORDER_H
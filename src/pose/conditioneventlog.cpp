@@ -0,0 +1,182 @@
+/*!
+ * \file conditioneventlog.cpp
+ * \brief Implementación de la clase ConditionEventLog.
+ */
+
+#include "conditioneventlog.h"
+#include <QDataStream>
+#include <QDebug>
+
+ConditionEventLog::ConditionEventLog() {}
+
+/*!
+ * \brief Inserta la condición al final de cada columna, registrando la línea en el diccionario si es nueva.
+ */
+void ConditionEventLog::append(int64_t time, int serie, int rep, int stateId, const Condition& cond)
+{
+    int lineId;
+    auto it = lineIndex.constFind(cond.keypointLine);
+    if (it != lineIndex.constEnd()) {
+        lineId = it.value();
+    } else {
+        lineId = lineNames.size();
+        lineIndex.insert(cond.keypointLine, lineId);
+        lineNames.append(cond.keypointLine);
+    }
+
+    times.push_back(time);
+    series.push_back(serie);
+    reps.push_back(rep);
+    states.push_back(stateId);
+    types.push_back(static_cast<uint8_t>(cond.type));
+    views.push_back(static_cast<uint8_t>(cond.view));
+    lineIds.push_back(lineId);
+
+    switch (cond.value.typeId()) {
+    case QMetaType::Double:
+    case QMetaType::Float:
+        values.push_back(cond.value.toDouble());
+        valueKinds.push_back(Real);
+        break;
+    case QMetaType::Int:
+    case QMetaType::LongLong:
+    case QMetaType::UInt:
+    case QMetaType::ULongLong:
+        values.push_back(cond.value.toDouble());
+        valueKinds.push_back(Integer);
+        break;
+    default:
+        values.push_back(0);
+        valueKinds.push_back(Other);
+        otherValues.insert(static_cast<int>(times.size()) - 1, cond.value);
+        break;
+    }
+}
+
+int ConditionEventLog::size() const
+{
+    return static_cast<int>(times.size());
+}
+
+bool ConditionEventLog::isEmpty() const
+{
+    return times.empty();
+}
+
+void ConditionEventLog::clear()
+{
+    times.clear();
+    series.clear();
+    reps.clear();
+    states.clear();
+    types.clear();
+    views.clear();
+    lineIds.clear();
+    values.clear();
+    valueKinds.clear();
+    lineNames.clear();
+    lineIndex.clear();
+    otherValues.clear();
+}
+
+int64_t ConditionEventLog::time(int i) const { return times[i]; }
+int ConditionEventLog::serie(int i) const { return series[i]; }
+int ConditionEventLog::rep(int i) const { return reps[i]; }
+int ConditionEventLog::state(int i) const { return states[i]; }
+ConditionType ConditionEventLog::type(int i) const { return static_cast<ConditionType>(types[i]); }
+PoseView ConditionEventLog::view(int i) const { return static_cast<PoseView>(views[i]); }
+const QString& ConditionEventLog::line(int i) const { return lineNames[lineIds[i]]; }
+
+QVariant ConditionEventLog::value(int i) const
+{
+    switch (valueKinds[i]) {
+    case Real:
+        return values[i];
+    case Integer:
+        return static_cast<qlonglong>(values[i]);
+    default:
+        return otherValues.value(i);
+    }
+}
+
+Condition ConditionEventLog::condition(int i) const
+{
+    return Condition(type(i), line(i), value(i), view(i));
+}
+
+/*!
+ * \brief Formato (QDataStream, Qt 6.0): versión, diccionario de líneas, número de eventos, cada columna completa
+ * y los valores no numéricos indexados por evento.
+ */
+QByteArray ConditionEventLog::serialize() const
+{
+    QByteArray out;
+    QDataStream stream(&out, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    const quint32 n = static_cast<quint32>(times.size());
+    stream << quint16(1) << lineNames << n;
+    for (quint32 i = 0; i < n; ++i) stream << qint64(times[i]);
+    for (quint32 i = 0; i < n; ++i) stream << qint32(series[i]);
+    for (quint32 i = 0; i < n; ++i) stream << qint32(reps[i]);
+    for (quint32 i = 0; i < n; ++i) stream << qint32(states[i]);
+    for (quint32 i = 0; i < n; ++i) stream << quint8(types[i]);
+    for (quint32 i = 0; i < n; ++i) stream << quint8(views[i]);
+    for (quint32 i = 0; i < n; ++i) stream << qint32(lineIds[i]);
+    for (quint32 i = 0; i < n; ++i) stream << values[i];
+    for (quint32 i = 0; i < n; ++i) stream << quint8(valueKinds[i]);
+    stream << otherValues;
+    return out;
+}
+
+bool ConditionEventLog::deserialize(const QByteArray& data)
+{
+    clear();
+
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint16 version;
+    quint32 n;
+    stream >> version >> lineNames >> n;
+    if (stream.status() != QDataStream::Ok || version != 1) {
+        qWarning() << "[ConditionEventLog] Datos serializados no válidos, versión:" << version;
+        clear();
+        return false;
+    }
+    for (int l = 0; l < lineNames.size(); ++l) lineIndex.insert(lineNames[l], l);
+
+    // n viene de los datos: antes de reservar la columna se comprueba que quedan bytes para todas sus filas
+    auto readColumn = [&](auto& column, auto wire) {
+        if (stream.status() != QDataStream::Ok) return;
+        if (qint64(n) * qint64(sizeof(wire)) > stream.device()->bytesAvailable()) {
+            stream.setStatus(QDataStream::ReadPastEnd);
+            return;
+        }
+        column.resize(n);
+        for (quint32 i = 0; i < n && stream.status() == QDataStream::Ok; ++i) {
+            stream >> wire;
+            column[i] = wire;
+        }
+    };
+    readColumn(times, qint64(0));
+    readColumn(series, qint32(0));
+    readColumn(reps, qint32(0));
+    readColumn(states, qint32(0));
+    readColumn(types, quint8(0));
+    readColumn(views, quint8(0));
+    readColumn(lineIds, qint32(0));
+    readColumn(values, double(0));
+    readColumn(valueKinds, quint8(0));
+    stream >> otherValues;
+
+    bool valid = stream.status() == QDataStream::Ok;
+    for (quint32 i = 0; valid && i < n; ++i)
+        valid = lineIds[i] >= 0 && lineIds[i] < lineNames.size();
+    if (!valid) {
+        qWarning() << "[ConditionEventLog] Tabla de eventos incompleta o corrupta";
+        clear();
+        return false;
+    }
+    return true;
+}
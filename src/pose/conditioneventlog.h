@@ -0,0 +1,104 @@
+/*!
+ * \file conditioneventlog.h
+ * \brief Declaración de la clase ConditionEventLog.
+ *
+ * ConditionEventLog es la tabla de eventos de solo inserción en la que SesionReport registra cada condición
+ * detectada. Cada campo se guarda en su propio array (tiempo, serie, repetición, estado, tipo, línea, vista
+ * y valor) y las líneas se codifican con un diccionario, de modo que registrar una condición en un frame
+ * es una inserción al final de cada columna, sin formatear texto ni indexar mapas anidados.
+ */
+
+#ifndef CONDITIONEVENTLOG_H
+#define CONDITIONEVENTLOG_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <vector>
+#include <cstdint>
+#include "condition.h"
+
+/*!
+ * \class ConditionEventLog
+ * \brief Almacén columnar de las condiciones registradas durante una sesión.
+ *
+ * Los valores numéricos se guardan como double junto a un byte que indica su tipo original (entero o
+ * real), para reconstruir el mismo QVariant al leerlos. Los valores de otro tipo (mapas, texto) son raros y
+ * se guardan aparte, indexados por la posición del evento.
+ */
+class ConditionEventLog
+{
+public:
+    ConditionEventLog();
+
+    /*!
+     * \brief Añade un evento al final de la tabla.
+     * \param time Timestamp del frame en milisegundos.
+     * \param serie Serie en curso.
+     * \param rep Repetición en curso.
+     * \param stateId ID del estado activo.
+     * \param cond Condición detectada.
+     */
+    void append(int64_t time, int serie, int rep, int stateId, const Condition& cond);
+
+    /// Número de eventos registrados.
+    int size() const;
+
+    /// true si no hay eventos.
+    bool isEmpty() const;
+
+    /// Descarta todos los eventos y el diccionario de líneas.
+    void clear();
+
+    int64_t time(int i) const;
+    int serie(int i) const;
+    int rep(int i) const;
+    int state(int i) const;
+    ConditionType type(int i) const;
+    PoseView view(int i) const;
+    const QString& line(int i) const;
+
+    /*!
+     * \brief Reconstruye el valor del evento con su tipo original.
+     */
+    QVariant value(int i) const;
+
+    /*!
+     * \brief Reconstruye la condición completa del evento.
+     */
+    Condition condition(int i) const;
+
+    /*!
+     * \brief Serializa la tabla en binario, columna a columna, junto con el diccionario de líneas.
+     * \return Bloque binario con formato propio y versionado.
+     */
+    QByteArray serialize() const;
+
+    /*!
+     * \brief Reemplaza el contenido por el de un bloque generado con serialize().
+     * \param data Bloque binario.
+     * \return true si el bloque es válido; si no, la tabla queda vacía.
+     */
+    bool deserialize(const QByteArray& data);
+
+private:
+    enum ValueKind : uint8_t { Real = 0, Integer = 1, Other = 2 };
+
+    std::vector<int64_t> times;
+    std::vector<int32_t> series;
+    std::vector<int32_t> reps;
+    std::vector<int32_t> states;
+    std::vector<uint8_t> types;
+    std::vector<uint8_t> views;
+    std::vector<int32_t> lineIds;
+    std::vector<double> values;
+    std::vector<uint8_t> valueKinds;
+
+    QStringList lineNames;                 //!< Diccionario id → línea.
+    QHash<QString, int> lineIndex;         //!< Diccionario línea → id.
+    QHash<int, QVariant> otherValues;      //!< Valores no numéricos por índice de evento.
+};
+
+#endif // CONDITIONEVENTLOG_H
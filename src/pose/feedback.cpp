@@ -2,240 +2,85 @@
  * @file feedback.cpp
  * @brief Implementación de la clase FeedBack para clasificar condiciones y generar mensajes personalizados.
  *
- * Este archivo define cómo se procesan las condiciones detectadas durante un ejercicio físico, generando
- * mensajes clasificados por severidad (crítica, alerta, informativa) que serán usados en tiempo real
- * para proporcionar retroalimentación al usuario.
+ * Este archivo define cómo se registran las condiciones detectadas durante un ejercicio físico. Los mensajes
+ * clasificados por severidad (crítica, alerta, informativa) se obtienen de la tabla de mensajes del ejercicio
+ * al consultarlos.
  */
 
 #include "feedback.h"
-/// Constructor que recibe una lista de condiciones y las procesa para generar entradas clasificadas.
 
-FeedBack::FeedBack(QList<Condition> conds) {
+static_assert(FeedbackMessageTable::TYPE_COUNT <= 32, "La máscara de tipos de FeedBack es de 32 bits");
 
-    conditionsMap.resize(static_cast<int>(ConditionType::ExerciseOvertime) + 1);
-    conditionsMap.fill(false);
-    processConditions(conds);
+/// Constructor que marca cada tipo de condición recibido y guarda el ID de su línea; si un tipo se repite,
+/// prevalece la última condición. Las condiciones activas solo se guardan como máscara de tipos.
+
+FeedBack::FeedBack(const QList<Condition>& conds, const QList<Condition>& active,
+                   QSharedPointer<const FeedbackMessageTable> table, int64_t time)
+    : table(table ? table : FeedbackMessageTable::defaultTable()), time(time) {
+
+    for (const Condition &cond : conds) {
+        const int index = static_cast<int>(cond.type);
+        if (index < 0 || index >= FeedbackMessageTable::TYPE_COUNT) continue;
+        typeMask |= (1u << index);
+        lineIds[index] = static_cast<quint16>(this->table->lineId(cond.keypointLine));
+    }
+    for (const Condition &cond : active) {
+        const int index = static_cast<int>(cond.type);
+        if (index >= 0 && index < FeedbackMessageTable::TYPE_COUNT) activeMask |= (1u << index);
+    }
+}
+
+QList<QString> FeedBack::messagesOf(ConditionCategory category) const
+{
+    QList<QString> result;
+    for (int i = 0; i < FeedbackMessageTable::TYPE_COUNT; ++i) {
+        const ConditionType type = static_cast<ConditionType>(i);
+        if ((typeMask & (1u << i)) && table->category(type) == category)
+            result.append(table->message(type, lineIds[i]));
+    }
+    return result;
 }
 
 QList<QString> FeedBack::getCriticalMessages() const
 {
-    return criticalMessages;
+    return messagesOf(ConditionCategory::critical);
 }
 
 QList<QString> FeedBack::getInfoMessages() const
 {
-    return infoMessages;
+    return messagesOf(ConditionCategory::info);
 }
 
 QList<QString> FeedBack::getAlerts() const
 {
-    return alerts;
+    return messagesOf(ConditionCategory::alert);
 }
 
-/// Procesa cada condición recibida, clasificándola y generando su mensaje asociado.
-
-void FeedBack::processConditions(QList<Condition> &conds) {
-    for (const Condition &cond : conds) {
-        switch (cond.type) {
-        case ConditionType::MaxAngle:
-            entries[ConditionType::MaxAngle] = {
-                QString("ángulo óptimo máximo alcanzado(%1)").arg(cond.keypointLine),
-                ConditionCategory::info
-            };
-            break;
-        case ConditionType::MinAngle:
-            entries[ConditionType::MinAngle] = {
-                QString("ángulo óptimo mínimo alcanzado(%1)").arg(cond.keypointLine),
-                 ConditionCategory::info
-            };
-            break;
-        case ConditionType::Increase:
-            entries[ConditionType::Increase] = {
-                QString("Has cambiado el sentido del movimiento en el eje %1.").arg(cond.keypointLine),
-                 ConditionCategory::alert
-            };
-            break;
-        case ConditionType::Decrease:
-            entries[ConditionType::Decrease] = {
-                QString("Has cambiado el sentido del movimiento en el eje %1.").arg(cond.keypointLine),
-                 ConditionCategory::alert
-            };
-            break;
-        case ConditionType::Has_Stopped:
-            entries[ConditionType::Has_Stopped] = {
-                QString("Has interrumpido el movimiento en el eje %1.").arg(cond.keypointLine),
-                ConditionCategory::alert
-            };
-            break;
-        case ConditionType::OpositeDirection:
-            entries[ConditionType::OpositeDirection] = {
-                QString("Has cambiado el sentido del movimiento en el eje %1.").arg(cond.keypointLine),
-                ConditionCategory::alert
-            };
-            break;
-        case ConditionType::Not_Steady:
-            entries[ConditionType::Not_Steady] = {
-                QString("Debes mantener la posición en %1 más estable.").arg(cond.keypointLine),
-                 ConditionCategory::alert
-            };
-            break;
-        case ConditionType::is_Steady:
-            entries[ConditionType::is_Steady] = {
-                QString("Estas manteniendo la posicion en %1 correctamente.").arg(cond.keypointLine),
-                ConditionCategory::info
-            };
-            break;
-        case ConditionType::MaxStateTimeout:
-            entries[ConditionType::MaxStateTimeout] = {
-                "Has estado demasiado tiempo en esta posición.",
-                 ConditionCategory::alert
-            };
-            break;
-        case ConditionType::MinStateTimeout:
-            entries[ConditionType::MinStateTimeout] = {
-                "Has cambiado de posición demasiado rápido.",
-               ConditionCategory::alert
-            };
-            break;
-        case ConditionType::OptimalForm:
-            entries[ConditionType::OptimalForm] = {
-                "¡Buena técnica! Sigue así.",
-                ConditionCategory::info
-            };
-            break;
-        case ConditionType::FastMovement:
-            entries[ConditionType::FastMovement] = {
-                "El movimiento es demasiado rápido. Controla la velocidad.",
-                ConditionCategory::alert
-            };
-            break;
-        case ConditionType::SlowMovement:
-            entries[ConditionType::SlowMovement] = {
-                "El movimiento es demasiado lento. Acelera un poco.",
-                 ConditionCategory::alert
-            };
-            break;
-        case ConditionType::JointOverload:
-            entries[ConditionType::JointOverload] = {
-                QString("Estas forzando la articulación en la línea %1").arg(cond.keypointLine),
-                 ConditionCategory::critical
-            };
-            break;
-        case ConditionType::symmetryDeviation:
-            entries[ConditionType::symmetryDeviation] = {
-                QString("Mantén la simetría en el eje %1.").arg(cond.keypointLine),
-                ConditionCategory::alert
-            };
-            break;
-        case ConditionType::exerciseInit:
-            entries[ConditionType::exerciseInit] = {
-                "Ejercicio iniciado!!",
-               ConditionCategory::info
-            };
-            break;
-        case ConditionType::InitSet:
-            entries[ConditionType::InitSet] = {
-                "serie iniciada!!",
-                ConditionCategory::info
-            };
-            break;
-        case ConditionType::InitRepetition:
-            entries[ConditionType::InitRepetition] = {
-                "repetición iniciada!!",
-                ConditionCategory::info
-            };
-            break;
-        case ConditionType::EndOfRepetition:
-            entries[ConditionType::EndOfRepetition] = {
-                "Repetición Completada!!",
-                ConditionCategory::info
-            };
-            break;
-        case ConditionType::EndOfSet:
-            entries[ConditionType::EndOfSet] = {
-                "Serie Completada!!",
-                ConditionCategory::info
-            };
-            break;
-        case ConditionType::EndOfExercise:
-            entries[ConditionType::EndOfExercise] = {
-                "Ejercicio Completado!!",
-                ConditionCategory::info
-            };
-        case ConditionType::EndOfMovementPhase:
-            entries[ConditionType::EndOfMovementPhase] = {
-                "Fase del movimiento completada!!",
-                ConditionCategory::info
-            };
-            break;
-        case ConditionType::SetTime:
-            entries[ConditionType::SetTime] = {
-                "Se ha alcanzado el tiempo máximo para realizar la serie!!",
-                ConditionCategory::info
-            };
-            break;
-        case ConditionType::RestTime:
-            entries[ConditionType::RestTime] = {
-                "Tiempo de descanso finalizado. ¡Prepárate!!",
-                ConditionCategory::info
-            };
-            break;
-        case ConditionType::RestOverTime:
-            entries[ConditionType::RestOverTime] = {
-                "Tiempo de descanso sobrepasado. ¡Prepárate!!",
-                ConditionCategory::alert
-            };
-            break;
-        case ConditionType::AccelerationSpikes:
-            entries[ConditionType::AccelerationSpikes] = {
-                QString("Aceleraciones no controladas en la articulación %1").arg(cond.keypointLine),
-                ConditionCategory::alert
-            };
-            break;
-        case ConditionType::RangeOfMotionDeficit:
-            entries[ConditionType::RangeOfMotionDeficit] = {
-                QString("Rango de movimiento insuficiente en la articulación %1").arg(cond.keypointLine),
-               ConditionCategory::alert
-            };
-            break;
-        case ConditionType::IncorrectExecution:
-            entries[ConditionType::IncorrectExecution] = {
-                "No se ha realizado el  movimiento de forma correcta.",
-                ConditionCategory::alert
-            };
-        case ConditionType::ExerciseOvertime:
-            entries[ConditionType::ExerciseOvertime] = {
-                "Se ha superado el tiempo máximo para realizar el ejercicio.",
-                ConditionCategory::alert
-            };
-            break;
-        default:
-            break;
-        }
-    }
+QString FeedBack::getMessage(ConditionType type) const {
+    return contains(type) ? table->message(type, lineIds[static_cast<int>(type)]) : "";
 }
 
-QString FeedBack::getMessage(ConditionType type) const {
-    return entries.contains(type) ? entries[type].message : "";
+int FeedBack::getLineId(ConditionType type) const {
+    return contains(type) ? lineIds[static_cast<int>(type)] : 0;
 }
 
 ConditionCategory FeedBack::getCategory(ConditionType type) const {
-    return entries.contains(type) ? entries[type].category :ConditionCategory::none;
+    return contains(type) ? table->category(type) : ConditionCategory::none;
 }
 
 bool FeedBack::isCritical(ConditionType type)const
 {
-    return entries[type].category==ConditionCategory::critical;
+    return getCategory(type)==ConditionCategory::critical;
 }
 
 bool FeedBack::isAlert(ConditionType type) const
 {
-     return entries[type].category==ConditionCategory::alert;
+     return getCategory(type)==ConditionCategory::alert;
 }
 
 bool FeedBack::isInfo(ConditionType type) const
 {
-     return entries[type].category==ConditionCategory::info;
+     return getCategory(type)==ConditionCategory::info;
 }
 
 bool FeedBack::isOptimal(ConditionType type) const
@@ -245,11 +90,33 @@ bool FeedBack::isOptimal(ConditionType type) const
 
 QList<ConditionType> FeedBack::getEntriesList() const
 {
-    return entries.keys();
+    QList<ConditionType> result;
+    for (int i = 0; i < FeedbackMessageTable::TYPE_COUNT; ++i) {
+        if (typeMask & (1u << i)) result.append(static_cast<ConditionType>(i));
+    }
+    return result;
 }
 
+QList<ConditionType> FeedBack::getActiveList() const
+{
+    QList<ConditionType> result;
+    for (int i = 0; i < FeedbackMessageTable::TYPE_COUNT; ++i) {
+        if (activeMask & (1u << i)) result.append(static_cast<ConditionType>(i));
+    }
+    return result;
+}
 
+ConditionCategory FeedBack::categoryOf(ConditionType type) const
+{
+    return table->category(type);
+}
+
+int64_t FeedBack::getTime() const
+{
+    return time;
+}
 
 bool FeedBack::contains(ConditionType cond) const {
-    return entries.contains(cond);
+    const int index = static_cast<int>(cond);
+    return index >= 0 && index < FeedbackMessageTable::TYPE_COUNT && (typeMask & (1u << index));
 }
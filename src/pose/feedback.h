@@ -10,23 +10,32 @@
 #define FEEDBACK_H
 
 #include <QList>
+#include <QSharedPointer>
+#include <array>
+#include <cstdint>
 #include "condition.h"
+#include "feedbackmessagetable.h"
 
 /**
  * @class FeedBack
  * @brief Clase que procesa una lista de condiciones y genera mensajes clasificados para retroalimentación al usuario.
  *
- * Al recibir una lista de condiciones detectadas durante el ejercicio, esta clase se encarga de analizarlas,
- * clasificarlas según su severidad (crítica, alerta, informativa) y generar los mensajes correspondientes.
+ * Al recibir una lista de condiciones detectadas durante el ejercicio, esta clase guarda qué tipos están
+ * presentes en una máscara de bits y, por cada tipo, el ID de la línea afectada. Los mensajes y las categorías
+ * se consultan en la FeedbackMessageTable del ejercicio solo cuando se muestran.
  */
 class FeedBack
 {
 public:
     /**
      * @brief Constructor que inicializa el objeto con una lista de condiciones.
-     * @param conds Lista de condiciones detectadas por el sistema.
+     * @param conds Lista de condiciones que se acaban de activar.
+     * @param active Condiciones activas tras este frame; las liberadas ya no aparecen.
+     * @param table Tabla de mensajes del ejercicio; si es nula se usa la tabla por defecto.
+     * @param time Timestamp del frame en milisegundos.
      */
-    explicit FeedBack(QList<Condition> conds);
+    explicit FeedBack(const QList<Condition>& conds, const QList<Condition>& active = {},
+                      QSharedPointer<const FeedbackMessageTable> table = nullptr, int64_t time = 0);
 
     /**
      * @brief Devuelve los mensajes clasificados como críticos.
@@ -60,6 +69,13 @@ public:
      */
     QString getMessage(ConditionType type) const;
 
+    /**
+     * @brief Devuelve el ID de la línea asociada a una condición en la tabla de mensajes.
+     * @param type Tipo de condición.
+     * @return ID de línea, o 0 si la condición es global o no está presente.
+     */
+    int getLineId(ConditionType type) const;
+
     /**
      * @brief Devuelve la categoría asociada a una condición.
      * @param type Tipo de condición.
@@ -101,29 +117,37 @@ public:
      */
     QList<ConditionType> getEntriesList() const;
 
-private:
-    QList<QString> criticalMessages; ///< Mensajes críticos acumulados.
-    QList<QString> infoMessages;     ///< Mensajes informativos acumulados.
-    QList<QString> alerts;           ///< Mensajes de alerta acumulados.
+    /**
+     * @brief Devuelve los tipos con alguna condición activa tras este frame.
+     * @return Lista de tipos activos; no incluye los eventos puntuales.
+     */
+    QList<ConditionType> getActiveList() const;
 
-    QVector<bool> conditionsMap;     ///< Mapa interno para verificar condiciones detectadas.
+    /**
+     * @brief Devuelve la categoría de un tipo de condición según la tabla del ejercicio, esté o no presente.
+     * @param type Tipo de condición.
+     * @return Categoría del tipo.
+     */
+    ConditionCategory categoryOf(ConditionType type) const;
 
     /**
-     * @struct FeedbackEntry
-     * @brief Estructura que almacena un mensaje y su categoría asociada.
+     * @brief Devuelve el instante del frame que generó el feedback.
+     * @return Timestamp en milisegundos.
      */
-    struct FeedbackEntry {
-        QString message;                 ///< Texto del mensaje.
-        ConditionCategory category;     ///< Severidad de la condición.
-    };
+    int64_t getTime() const;
 
-    QHash<ConditionType, FeedbackEntry> entries; ///< Mapa de entradas clasificadas por condición.
+private:
+    quint32 typeMask = 0;                                         ///< Bit i activo si el tipo i está presente.
+    quint32 activeMask = 0;                                       ///< Bit i activo si el tipo i sigue activo.
+    std::array<quint16, FeedbackMessageTable::TYPE_COUNT> lineIds{}; ///< ID de línea por tipo.
+    QSharedPointer<const FeedbackMessageTable> table;            ///< Tabla de mensajes del ejercicio.
+    int64_t time = 0;                                             ///< Timestamp del frame.
 
     /**
-     * @brief Procesa la lista de condiciones y genera mensajes correspondientes.
-     * @param conds Lista de condiciones a procesar.
+     * @brief Devuelve los mensajes de los tipos presentes con la categoría indicada.
+     * @param category Categoría a filtrar.
      */
-    void processConditions(QList<Condition> &conds);
+    QList<QString> messagesOf(ConditionCategory category) const;
 };
 
 #endif // FEEDBACK_H
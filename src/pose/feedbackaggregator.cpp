@@ -0,0 +1,102 @@
+/**
+ * @file feedbackaggregator.cpp
+ * @brief Implementación de la clase FeedbackAggregator.
+ */
+
+#include "feedbackaggregator.h"
+
+/// Tiempos por defecto: las condiciones continuas necesitan 100 ms presentes para activarse y 500 ms
+/// ausentes para liberarse; las sobrecargas y los tiempos agotados se activan al instante, y estos últimos se
+/// recuerdan cada pocos segundos; los eventos puntuales no tienen histéresis.
+FeedbackAggregator::FeedbackAggregator()
+{
+    timings.resize(static_cast<int>(ConditionType::ExerciseOvertime) + 1);
+
+    const QList<ConditionType> continuous = {
+        ConditionType::MaxAngle, ConditionType::MinAngle, ConditionType::Increase, ConditionType::Decrease,
+        ConditionType::OpositeDirection, ConditionType::Has_Stopped, ConditionType::is_Steady,
+        ConditionType::Not_Steady, ConditionType::OptimalForm, ConditionType::FastMovement,
+        ConditionType::SlowMovement, ConditionType::symmetryDeviation, ConditionType::AccelerationSpikes
+    };
+    for (ConditionType type : continuous)
+        setTiming(type, 100, 500);
+
+    setTiming(ConditionType::JointOverload, 0, 300);
+    setTiming(ConditionType::MaxStateTimeout, 0, 500, 5000);
+    setTiming(ConditionType::MinStateTimeout, 0, 500, 5000);
+    setTiming(ConditionType::SetTime, 0, 1000, 10000);
+}
+
+void FeedbackAggregator::setTiming(ConditionType type, int holdMs, int releaseMs, int repeatMs)
+{
+    int index = static_cast<int>(type);
+    if (index < 0 || index >= timings.size()) return;
+    timings[index] = {qMax(holdMs, 0), qMax(releaseMs, 0), qMax(repeatMs, 0)};
+}
+
+const FeedbackAggregator::Timing& FeedbackAggregator::timing(ConditionType type) const
+{
+    return timings[static_cast<int>(type)];
+}
+
+/// Actualiza el seguimiento con las condiciones presentes y recorre después las ausentes para liberarlas.
+FeedbackDelta FeedbackAggregator::update(const QList<Condition>& conds, int64_t time)
+{
+    FeedbackDelta delta;
+
+    for (const Condition& cond : conds) {
+        const Timing& t = timing(cond.type);
+
+        // Eventos puntuales: se notifican siempre y no se siguen
+        if (t.holdMs == 0 && t.releaseMs == 0) {
+            delta.onsets.append(cond);
+            continue;
+        }
+
+        auto it = tracks.find(cond);
+        if (it == tracks.end())
+            it = tracks.insert(cond, {cond, time, time, time, false});
+
+        Track& track = it.value();
+        // Una condición que estuvo ausente más que su tiempo de liberación vuelve a empezar
+        if (!track.active && time - track.lastSeen > t.releaseMs)
+            track.firstSeen = time;
+        track.lastSeen = time;
+        track.condition = cond;
+
+        if (!track.active && time - track.firstSeen >= t.holdMs) {
+            track.active = true;
+            track.lastNotified = time;
+            delta.onsets.append(cond);
+        } else if (track.active && t.repeatMs > 0 && time - track.lastNotified >= t.repeatMs) {
+            track.lastNotified = time;
+            delta.onsets.append(cond);
+        }
+    }
+
+    for (auto it = tracks.begin(); it != tracks.end();) {
+        const Track& track = it.value();
+        if (time - track.lastSeen > timing(track.condition.type).releaseMs) {
+            if (track.active) delta.offsets.append(track.condition);
+            it = tracks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    return delta;
+}
+
+QList<Condition> FeedbackAggregator::getActive() const
+{
+    QList<Condition> result;
+    for (const Track& track : tracks) {
+        if (track.active) result.append(track.condition);
+    }
+    return result;
+}
+
+void FeedbackAggregator::reset()
+{
+    tracks.clear();
+}
@@ -0,0 +1,103 @@
+/**
+ * @file feedbackaggregator.h
+ * @brief Declara la clase FeedbackAggregator, que reduce las condiciones de cada frame a cambios de estado.
+ *
+ * La máquina de estados devuelve en cada frame todas las condiciones vigentes, por lo que una misma alerta
+ * continua (por ejemplo, "mantén la posición") se repetiría decenas de veces por segundo. El agregador
+ * mantiene el conjunto de condiciones activas y solo informa de las que se activan o se liberan.
+ */
+
+#ifndef FEEDBACKAGGREGATOR_H
+#define FEEDBACKAGGREGATOR_H
+
+#include <QHash>
+#include <QList>
+#include <QVector>
+#include <cstdint>
+#include "condition.h"
+
+/**
+ * @struct FeedbackDelta
+ * @brief Condiciones que han cambiado de estado en un frame.
+ */
+struct FeedbackDelta {
+    QList<Condition> onsets;   ///< Condiciones que pasan a estar activas.
+    QList<Condition> offsets;  ///< Condiciones que dejan de estar activas.
+
+    /// true si no hay cambios que notificar.
+    bool isEmpty() const { return onsets.isEmpty() && offsets.isEmpty(); }
+};
+
+/**
+ * @class FeedbackAggregator
+ * @brief Etapa de histéresis entre la máquina de estados y el feedback al usuario.
+ *
+ * Cada condición, identificada por tipo, línea y vista, se activa cuando lleva presente al menos su tiempo
+ * de mantenimiento y se libera cuando lleva ausente su tiempo de liberación, de forma que una detección
+ * intermitente no genera mensajes repetidos.
+ *
+ * Las alertas de tiempo agotado (en el estado o en la serie) siguen presentes en cada frame mientras dura el
+ * exceso: se notifican al activarse y después se recuerdan con un intervalo de repetición.
+ *
+ * Las condiciones que representan eventos puntuales (fin de repetición, inicio de serie...) tienen ambos
+ * tiempos a cero y se notifican cada vez que aparecen.
+ */
+class FeedbackAggregator
+{
+public:
+    /**
+     * @brief Constructor. Asigna los tiempos por defecto de cada tipo de condición.
+     */
+    FeedbackAggregator();
+
+    /**
+     * @brief Incorpora las condiciones de un frame.
+     * @param conds Condiciones devueltas por la máquina de estados.
+     * @param time Timestamp del frame en milisegundos.
+     * @return Activaciones y liberaciones producidas en este frame.
+     */
+    FeedbackDelta update(const QList<Condition>& conds, int64_t time);
+
+    /**
+     * @brief Configura la histéresis de un tipo de condición.
+     * @param type Tipo de condición.
+     * @param holdMs Tiempo que debe estar presente para activarse.
+     * @param releaseMs Tiempo que debe estar ausente para liberarse.
+     * @param repeatMs Intervalo con el que se vuelve a notificar mientras sigue activa (0: solo al activarse).
+     */
+    void setTiming(ConditionType type, int holdMs, int releaseMs, int repeatMs = 0);
+
+    /**
+     * @brief Devuelve las condiciones activas en este momento.
+     */
+    QList<Condition> getActive() const;
+
+    /**
+     * @brief Olvida todas las condiciones, sin notificar liberaciones. Se usa al iniciar una nueva serie.
+     */
+    void reset();
+
+private:
+    /// Seguimiento de una condición.
+    struct Track {
+        Condition condition;
+        int64_t firstSeen = 0;
+        int64_t lastSeen = 0;
+        int64_t lastNotified = 0;
+        bool active = false;
+    };
+
+    /// Tiempos de histéresis de un tipo.
+    struct Timing {
+        int holdMs = 0;
+        int releaseMs = 0;
+        int repeatMs = 0;
+    };
+
+    QVector<Timing> timings;            ///< Tiempos indexados por tipo de condición.
+    QHash<Condition, Track> tracks;     ///< Condiciones presentes o activas.
+
+    const Timing& timing(ConditionType type) const;
+};
+
+#endif // FEEDBACKAGGREGATOR_H
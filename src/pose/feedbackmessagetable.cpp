@@ -0,0 +1,104 @@
+/**
+ * @file feedbackmessagetable.cpp
+ * @brief Implementación de la clase FeedbackMessageTable.
+ */
+
+#include "feedbackmessagetable.h"
+
+namespace {
+
+/// Plantilla de mensaje y categoría de un tipo de condición. `%1` se sustituye por la línea.
+struct MessageTemplate {
+    ConditionType type;
+    const char* text;
+    ConditionCategory category;
+};
+
+const MessageTemplate kTemplates[] = {
+    {ConditionType::MaxAngle, "ángulo óptimo máximo alcanzado(%1)", ConditionCategory::info},
+    {ConditionType::MinAngle, "ángulo óptimo mínimo alcanzado(%1)", ConditionCategory::info},
+    {ConditionType::Increase, "Has cambiado el sentido del movimiento en el eje %1.", ConditionCategory::alert},
+    {ConditionType::Decrease, "Has cambiado el sentido del movimiento en el eje %1.", ConditionCategory::alert},
+    {ConditionType::OpositeDirection, "Has cambiado el sentido del movimiento en el eje %1.", ConditionCategory::alert},
+    {ConditionType::Has_Stopped, "Has interrumpido el movimiento en el eje %1.", ConditionCategory::alert},
+    {ConditionType::is_Steady, "Estas manteniendo la posicion en %1 correctamente.", ConditionCategory::info},
+    {ConditionType::Not_Steady, "Debes mantener la posición en %1 más estable.", ConditionCategory::alert},
+    {ConditionType::MaxStateTimeout, "Has estado demasiado tiempo en esta posición.", ConditionCategory::alert},
+    {ConditionType::MinStateTimeout, "Has cambiado de posición demasiado rápido.", ConditionCategory::alert},
+    {ConditionType::OptimalForm, "¡Buena técnica! Sigue así.", ConditionCategory::info},
+    {ConditionType::FastMovement, "El movimiento es demasiado rápido. Controla la velocidad.", ConditionCategory::alert},
+    {ConditionType::SlowMovement, "El movimiento es demasiado lento. Acelera un poco.", ConditionCategory::alert},
+    {ConditionType::JointOverload, "Estas forzando la articulación en la línea %1", ConditionCategory::critical},
+    {ConditionType::symmetryDeviation, "Mantén la simetría en el eje %1.", ConditionCategory::alert},
+    {ConditionType::exerciseInit, "Ejercicio iniciado!!", ConditionCategory::info},
+    {ConditionType::InitRepetition, "repetición iniciada!!", ConditionCategory::info},
+    {ConditionType::EndOfRepetition, "Repetición Completada!!", ConditionCategory::info},
+    {ConditionType::InitSet, "serie iniciada!!", ConditionCategory::info},
+    {ConditionType::EndOfSet, "Serie Completada!!", ConditionCategory::info},
+    {ConditionType::EndOfExercise, "Ejercicio Completado!!", ConditionCategory::info},
+    {ConditionType::SetTime, "Se ha alcanzado el tiempo máximo para realizar la serie!!", ConditionCategory::info},
+    {ConditionType::RestTime, "Tiempo de descanso finalizado. ¡Prepárate!!", ConditionCategory::info},
+    {ConditionType::RestOverTime, "Tiempo de descanso sobrepasado. ¡Prepárate!!", ConditionCategory::alert},
+    {ConditionType::EndOfMovementPhase, "Fase del movimiento completada!!", ConditionCategory::info},
+    {ConditionType::AccelerationSpikes, "Aceleraciones no controladas en la articulación %1", ConditionCategory::alert},
+    {ConditionType::RangeOfMotionDeficit, "Rango de movimiento insuficiente en la articulación %1", ConditionCategory::alert},
+    {ConditionType::IncorrectExecution, "No se ha realizado el  movimiento de forma correcta.", ConditionCategory::alert},
+    {ConditionType::ExerciseOvertime, "Se ha superado el tiempo máximo para realizar el ejercicio.", ConditionCategory::alert},
+};
+
+}
+
+/// Resuelve todas las plantillas para cada línea del ejercicio; las plantillas sin `%1` se comparten.
+FeedbackMessageTable::FeedbackMessageTable(const QStringList& lines)
+{
+    lineNames.append(QString());
+    for (const QString& line : lines) {
+        if (line.isEmpty() || lineIds.contains(line)) continue;
+        lineIds.insert(line, lineNames.size());
+        lineNames.append(line);
+    }
+
+    const int lineCount = lineNames.size();
+    categories.fill(ConditionCategory::none, TYPE_COUNT);
+    messages.resize(TYPE_COUNT * lineCount);
+
+    for (const MessageTemplate& t : kTemplates) {
+        const int type = static_cast<int>(t.type);
+        const QString text = QString::fromUtf8(t.text);
+        const bool perLine = text.contains(QLatin1String("%1"));
+
+        categories[type] = t.category;
+        for (int l = 0; l < lineCount; ++l)
+            messages[type * lineCount + l] = perLine ? text.arg(lineNames[l]) : text;
+    }
+}
+
+int FeedbackMessageTable::lineId(const QString& line) const
+{
+    return lineIds.value(line, 0);
+}
+
+QString FeedbackMessageTable::lineName(int lineId) const
+{
+    return lineNames.value(lineId);
+}
+
+const QString& FeedbackMessageTable::message(ConditionType type, int lineId) const
+{
+    static const QString empty;
+    const int index = static_cast<int>(type);
+    if (index < 0 || index >= TYPE_COUNT || lineId < 0 || lineId >= lineNames.size()) return empty;
+    return messages[index * lineNames.size() + lineId];
+}
+
+ConditionCategory FeedbackMessageTable::category(ConditionType type) const
+{
+    const int index = static_cast<int>(type);
+    return (index >= 0 && index < TYPE_COUNT) ? categories[index] : ConditionCategory::none;
+}
+
+QSharedPointer<const FeedbackMessageTable> FeedbackMessageTable::defaultTable()
+{
+    static const QSharedPointer<const FeedbackMessageTable> table = QSharedPointer<const FeedbackMessageTable>::create();
+    return table;
+}
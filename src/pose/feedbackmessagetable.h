@@ -0,0 +1,75 @@
+/**
+ * @file feedbackmessagetable.h
+ * @brief Declara la clase FeedbackMessageTable, tabla precalculada de mensajes de feedback de un ejercicio.
+ *
+ * Los mensajes dependen solo del tipo de condición y de la línea de keypoints afectada, y las líneas de un
+ * ejercicio se conocen al cargar su especificación. La tabla resuelve todas las combinaciones una vez, de
+ * modo que el feedback de cada frame solo guarda índices y el texto se obtiene al mostrarlo.
+ */
+
+#ifndef FEEDBACKMESSAGETABLE_H
+#define FEEDBACKMESSAGETABLE_H
+
+#include <QHash>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "condition.h"
+
+/**
+ * @class FeedbackMessageTable
+ * @brief Tabla densa de mensajes y categorías indexada por (tipo de condición, ID de línea).
+ *
+ * El ID de línea 0 se reserva para las condiciones globales y para las líneas que no pertenecen al ejercicio;
+ * las líneas del ejercicio reciben IDs consecutivos a partir de 1 en el orden en que se pasan al constructor.
+ * La tabla no cambia tras construirse y puede compartirse entre hilos.
+ */
+class FeedbackMessageTable
+{
+public:
+    /// Número de tipos de condición.
+    static constexpr int TYPE_COUNT = static_cast<int>(ConditionType::ExerciseOvertime) + 1;
+
+    /**
+     * @brief Construye la tabla para las líneas de un ejercicio.
+     * @param lines Líneas de keypoints que aparecen en las restricciones del ejercicio.
+     */
+    explicit FeedbackMessageTable(const QStringList& lines = {});
+
+    /**
+     * @brief Devuelve el ID de una línea.
+     * @param line Nombre de la línea.
+     * @return ID de la línea, o 0 si no pertenece al ejercicio.
+     */
+    int lineId(const QString& line) const;
+
+    /**
+     * @brief Devuelve el nombre de una línea a partir de su ID.
+     * @return Nombre de la línea, o cadena vacía para el ID 0.
+     */
+    QString lineName(int lineId) const;
+
+    /**
+     * @brief Devuelve el mensaje ya resuelto para un tipo y una línea.
+     */
+    const QString& message(ConditionType type, int lineId) const;
+
+    /**
+     * @brief Devuelve la categoría de un tipo de condición.
+     */
+    ConditionCategory category(ConditionType type) const;
+
+    /**
+     * @brief Tabla compartida sin líneas, usada cuando el feedback se crea sin una tabla del ejercicio.
+     */
+    static QSharedPointer<const FeedbackMessageTable> defaultTable();
+
+private:
+    QStringList lineNames;                  ///< Nombre por ID de línea (el 0 es la cadena vacía).
+    QHash<QString, int> lineIds;            ///< ID por nombre de línea.
+    QVector<ConditionCategory> categories;  ///< Categoría por tipo.
+    QVector<QString> messages;              ///< Mensaje por [tipo · número de líneas + línea].
+};
+
+#endif // FEEDBACKMESSAGETABLE_H
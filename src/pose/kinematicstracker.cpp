@@ -0,0 +1,240 @@
+/*!
+ * \file kinematicstracker.cpp
+ * \brief Implementación de la clase KinematicsTracker.
+ *
+ * El filtro utilizado es un Savitzky–Golay causal de orden 2: en cada frame se ajusta una parábola por
+ * mínimos cuadrados a los últimos `window` ángulos y se evalúa en el instante más reciente. Como la ventana
+ * es fija, el ajuste se reduce a tres combinaciones lineales con coeficientes precalculados, lo que da un
+ * coste constante por frame y por línea.
+ */
+
+#include "kinematicstracker.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+Q_LOGGING_CATEGORY(KinematicsLog, "kinematics")
+
+/*!
+ * \brief Constructor. Ajusta la ventana a un valor válido y precalcula los coeficientes del filtro.
+ * \param window Número de frames de la ventana.
+ */
+KinematicsTracker::KinematicsTracker(int window)
+    : window(window)
+{
+    if (this->window < 5) this->window = 5;
+    if (this->window % 2 == 0) this->window++;
+    if (this->window != window)
+        qWarning(KinematicsLog) << "Ventana de filtrado no válida:" << window << "se usará" << this->window;
+
+    for (ViewBuffer& vb : views) vb.times.assign(this->window, 0);
+    computeCoefficients();
+}
+
+/*!
+ * \brief Calcula los coeficientes de suavizado, primera y segunda derivada del ajuste cuadrático.
+ *
+ * Con t_k = k-(N-1) (el frame más reciente en t=0) se invierte la matriz normal AᵀA de 3x3 y se obtienen
+ * los pesos h_j[k] tales que a_j = Σ h_j[k]·y_k. El ángulo suavizado es a0, la velocidad a1 y la
+ * aceleración 2·a2, todas en unidades de frame.
+ */
+void KinematicsTracker::computeCoefficients()
+{
+    double s[5] = {0, 0, 0, 0, 0};
+    for (int k = 0; k < window; ++k) {
+        double t = k - (window - 1);
+        double p = 1;
+        for (int i = 0; i < 5; ++i) { s[i] += p; p *= t; }
+    }
+
+    double m[3][3] = {{s[0], s[1], s[2]}, {s[1], s[2], s[3]}, {s[2], s[3], s[4]}};
+    double det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+               - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+               + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+
+    double inv[3][3];
+    inv[0][0] =  (m[1][1] * m[2][2] - m[1][2] * m[2][1]) / det;
+    inv[0][1] = -(m[0][1] * m[2][2] - m[0][2] * m[2][1]) / det;
+    inv[0][2] =  (m[0][1] * m[1][2] - m[0][2] * m[1][1]) / det;
+    inv[1][0] = -(m[1][0] * m[2][2] - m[1][2] * m[2][0]) / det;
+    inv[1][1] =  (m[0][0] * m[2][2] - m[0][2] * m[2][0]) / det;
+    inv[1][2] = -(m[0][0] * m[1][2] - m[0][2] * m[1][0]) / det;
+    inv[2][0] =  (m[1][0] * m[2][1] - m[1][1] * m[2][0]) / det;
+    inv[2][1] = -(m[0][0] * m[2][1] - m[0][1] * m[2][0]) / det;
+    inv[2][2] =  (m[0][0] * m[1][1] - m[0][1] * m[1][0]) / det;
+
+    smoothCoef.assign(window, 0);
+    velocityCoef.assign(window, 0);
+    accelerationCoef.assign(window, 0);
+    for (int k = 0; k < window; ++k) {
+        double t = k - (window - 1);
+        double powers[3] = {1, t, t * t};
+        for (int i = 0; i < 3; ++i) {
+            smoothCoef[k]       += inv[0][i] * powers[i];
+            velocityCoef[k]     += inv[1][i] * powers[i];
+            accelerationCoef[k] += 2 * inv[2][i] * powers[i];
+        }
+    }
+}
+
+/*!
+ * \brief Asigna un identificador compacto a una línea nueva y amplía los buffers de todas las vistas.
+ * \return Identificador asignado.
+ */
+int KinematicsTracker::registerLine(const QString& line)
+{
+    int id = lineCount;
+    lineIds.insert(line, id);
+    resizeBuffers(lineCount + 1);
+    qDebug(KinematicsLog) << "Línea registrada:" << line << "id:" << id;
+    return id;
+}
+
+/*!
+ * \brief Reubica los buffers circulares para un nuevo número de líneas conservando las muestras previas.
+ *
+ * Solo ocurre cuando aparece una línea desconocida, normalmente en los primeros frames de la sesión.
+ */
+void KinematicsTracker::resizeBuffers(int newLineCount)
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (ViewBuffer& vb : views) {
+        std::vector<double> relocated(static_cast<size_t>(window) * newLineCount, nan);
+        for (int slot = 0; slot < window && lineCount > 0; ++slot) {
+            std::copy_n(vb.samples.begin() + static_cast<size_t>(slot) * lineCount, lineCount,
+                        relocated.begin() + static_cast<size_t>(slot) * newLineCount);
+        }
+        vb.samples.swap(relocated);
+        vb.smooth.resize(newLineCount, 0);
+        vb.velocity.resize(newLineCount, 0);
+        vb.acceleration.resize(newLineCount, 0);
+        vb.nextAcceleration.resize(newLineCount, 0);
+        vb.jerk.resize(newLineCount, 0);
+        vb.valid.resize(newLineCount, 0);
+    }
+    lineCount = newLineCount;
+}
+
+/*!
+ * \brief Añade un frame a la ventana de la vista y recalcula las estimaciones de todas sus líneas.
+ *
+ * Las líneas que no llegan en el frame conservan el último valor conocido. Los frames con un timestamp
+ * igual o anterior al último procesado se ignoran.
+ */
+void KinematicsTracker::update(PoseView view, const QHash<QString, double>& angles, int64_t time)
+{
+    if (angles.isEmpty()) return;
+
+    for (auto it = angles.constBegin(); it != angles.constEnd(); ++it) {
+        if (!lineIds.contains(it.key())) registerLine(it.key());
+    }
+
+    ViewBuffer& vb = views[static_cast<int>(view)];
+    if (vb.filled > 0 && time <= vb.lastTime) return;
+
+    const int slot = vb.head;
+    const int prevSlot = (slot + window - 1) % window;
+    double* row = vb.samples.data() + static_cast<size_t>(slot) * lineCount;
+    const double* prevRow = vb.samples.data() + static_cast<size_t>(prevSlot) * lineCount;
+    const double dtLast = (time - vb.lastTime) / 1000.0;
+
+    if (vb.filled > 0) std::copy_n(prevRow, lineCount, row);
+    else std::fill_n(row, lineCount, std::numeric_limits<double>::quiet_NaN());
+
+    for (auto it = angles.constBegin(); it != angles.constEnd(); ++it) {
+        int id = lineIds.value(it.key());
+        double angle = it.value();
+        if (vb.filled > 0 && !std::isnan(prevRow[id])) {
+            double delta = angle - prevRow[id];
+            delta -= 360.0 * std::round(delta / 360.0);
+            angle = prevRow[id] + delta;
+        }
+        row[id] = angle;
+    }
+
+    vb.times[slot] = time;
+    vb.lastTime = time;
+    vb.head = (slot + 1) % window;
+    vb.filled = std::min(vb.filled + 1, window);
+
+    if (vb.filled < window) return;
+
+    // vb.head apunta ahora al frame más antiguo de la ventana
+    const double dt = (time - vb.times[vb.head]) / 1000.0 / (window - 1);
+    if (dt <= 0) return;
+
+    std::fill(vb.nextAcceleration.begin(), vb.nextAcceleration.end(), 0);
+    std::fill(vb.smooth.begin(), vb.smooth.end(), 0);
+    std::fill(vb.velocity.begin(), vb.velocity.end(), 0);
+
+    double* sm = vb.smooth.data();
+    double* vel = vb.velocity.data();
+    double* ac = vb.nextAcceleration.data();
+    for (int k = 0; k < window; ++k) {
+        const double* r = vb.samples.data() + static_cast<size_t>((vb.head + k) % window) * lineCount;
+        const double cs = smoothCoef[k], cv = velocityCoef[k], ca = accelerationCoef[k];
+        for (int l = 0; l < lineCount; ++l) {
+            sm[l] += cs * r[l];
+            vel[l] += cv * r[l];
+            ac[l] += ca * r[l];
+        }
+    }
+
+    const double invDt = 1.0 / dt;
+    const double invDt2 = invDt * invDt;
+    for (int l = 0; l < lineCount; ++l) {
+        bool wasValid = vb.valid[l];
+        vb.valid[l] = !std::isnan(sm[l]);
+        if (!vb.valid[l]) continue;
+
+        vel[l] *= invDt;
+        ac[l] *= invDt2;
+        vb.jerk[l] = (wasValid && dtLast > 0) ? (ac[l] - vb.acceleration[l]) / dtLast : 0;
+        vb.acceleration[l] = ac[l];
+
+        sm[l] = std::fmod(sm[l], 360.0);
+        if (sm[l] < 0) sm[l] += 360.0;
+    }
+}
+
+/*!
+ * \brief Devuelve la última estimación disponible para la línea indicada.
+ */
+KinematicSample KinematicsTracker::sample(PoseView view, const QString& line) const
+{
+    KinematicSample out;
+    int id = lineIds.value(line, -1);
+    if (id < 0) return out;
+
+    const ViewBuffer& vb = views[static_cast<int>(view)];
+    if (id >= static_cast<int>(vb.valid.size()) || !vb.valid[id]) return out;
+
+    out.angle = vb.smooth[id];
+    out.velocity = vb.velocity[id];
+    out.acceleration = vb.acceleration[id];
+    out.jerk = vb.jerk[id];
+    out.valid = true;
+    return out;
+}
+
+/*!
+ * \brief Vacía las ventanas de todas las vistas. Se usa al reanudar tras un descanso para no mezclar
+ * muestras separadas en el tiempo.
+ */
+void KinematicsTracker::reset()
+{
+    for (ViewBuffer& vb : views) {
+        vb.head = 0;
+        vb.filled = 0;
+        vb.lastTime = 0;
+        std::fill(vb.valid.begin(), vb.valid.end(), 0);
+    }
+}
+
+/*!
+ * \brief Devuelve el número de frames de la ventana del filtro.
+ */
+int KinematicsTracker::getWindow() const
+{
+    return window;
+}
@@ -0,0 +1,102 @@
+/*!
+ * \file kinematicstracker.h
+ * \brief Declaración de la clase KinematicsTracker.
+ *
+ * KinematicsTracker mantiene, para cada vista y cada línea, una ventana circular con los últimos ángulos
+ * recibidos y estima en tiempo constante por frame el ángulo suavizado, la velocidad, la aceleración y el
+ * jerk angular mediante un filtro causal de Savitzky–Golay.
+ */
+
+#ifndef KINEMATICSTRACKER_H
+#define KINEMATICSTRACKER_H
+
+#include <QHash>
+#include <QString>
+#include <QLoggingCategory>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include "enums/PoseViewEnum.h"
+
+Q_DECLARE_LOGGING_CATEGORY(KinematicsLog)
+
+/*!
+ * \struct KinematicSample
+ * \brief Estimación cinemática de una línea en el último frame procesado.
+ */
+struct KinematicSample {
+    double angle = 0;        ///< Ángulo suavizado en grados.
+    double velocity = 0;     ///< Velocidad angular en grados/s (con signo).
+    double acceleration = 0; ///< Aceleración angular en grados/s².
+    double jerk = 0;         ///< Jerk angular en grados/s³.
+    bool valid = false;      ///< true cuando la ventana del filtro está completa para la línea.
+};
+
+/*!
+ * \class KinematicsTracker
+ * \brief Etapa cinemática en streaming para los ángulos de las líneas detectadas.
+ *
+ * Cada vista dispone de un buffer circular de `window` frames organizado por columnas (un valor por línea y
+ * frame) y de identificadores compactos de línea, de forma que el filtrado se reduce a recorrer la ventana
+ * acumulando productos sobre arrays contiguos de todas las líneas a la vez. Los coeficientes del ajuste
+ * cuadrático se calculan una sola vez en el constructor.
+ *
+ * Los ángulos se desenrollan respecto al frame anterior para que el paso 359° → 0° no se interprete como
+ * un salto de velocidad.
+ */
+class KinematicsTracker
+{
+public:
+    /*!
+     * \brief Constructor.
+     * \param window Número de frames de la ventana del filtro (impar, mínimo 5).
+     */
+    explicit KinematicsTracker(int window = 7);
+
+    /*!
+     * \brief Incorpora los ángulos de un frame para una vista y actualiza las estimaciones.
+     * \param view Vista a la que pertenecen los ángulos.
+     * \param angles Ángulos detectados por línea.
+     * \param time Timestamp del frame en milisegundos.
+     */
+    void update(PoseView view, const QHash<QString, double>& angles, int64_t time);
+
+    /*!
+     * \brief Devuelve la estimación cinemática de una línea en una vista.
+     * \return Muestra con `valid=false` si la línea no se conoce o la ventana aún no está completa.
+     */
+    KinematicSample sample(PoseView view, const QString& line) const;
+
+    /*!
+     * \brief Descarta todas las muestras almacenadas manteniendo los identificadores de línea.
+     */
+    void reset();
+
+    int getWindow() const;
+
+private:
+    static constexpr int VIEW_COUNT = 5;
+
+    /// Buffer circular de una vista. Los valores se guardan como `samples[slot * lineCount + línea]`.
+    struct ViewBuffer {
+        std::vector<int64_t> times;
+        std::vector<double> samples;
+        std::vector<double> smooth, velocity, acceleration, nextAcceleration, jerk;
+        std::vector<char> valid;
+        int head = 0;
+        int filled = 0;
+        int64_t lastTime = 0;
+    };
+
+    int window;
+    int lineCount = 0;
+    QHash<QString, int> lineIds;
+    std::array<ViewBuffer, VIEW_COUNT> views;
+    std::vector<double> smoothCoef, velocityCoef, accelerationCoef;
+
+    void computeCoefficients();
+    int registerLine(const QString& line);
+    void resizeBuffers(int newLineCount);
+};
+
+#endif // KINEMATICSTRACKER_H
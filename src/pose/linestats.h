@@ -0,0 +1,73 @@
+/**
+ * @file linestats.h
+ * @brief Acumulador incremental de estadísticas de ángulo por línea.
+ *
+ * Define la estructura `LineStats`, que mantiene mínimo, máximo, media y varianza de los ángulos de una
+ * línea mediante el algoritmo de Welford, de forma que cada muestra se incorpora en tiempo constante y
+ * sin almacenar el histórico.
+ */
+
+#ifndef LINESTATS_H
+#define LINESTATS_H
+
+#include <cmath>
+#include <nlohmann/json.hpp>
+
+/**
+ * @struct LineStats
+ * @brief Estadísticos de una línea (articulación) durante una repetición.
+ */
+struct LineStats {
+    int count = 0;      ///< Número de muestras acumuladas.
+    double min = 0;     ///< Ángulo mínimo observado.
+    double max = 0;     ///< Ángulo máximo observado.
+    double mean = 0;    ///< Media de los ángulos.
+    double m2 = 0;      ///< Suma de cuadrados de las desviaciones respecto a la media (Welford).
+
+    /**
+     * @brief Incorpora una nueva muestra actualizando todos los estadísticos.
+     * @param value Ángulo en grados.
+     */
+    void add(double value) {
+        if (count == 0) {
+            min = max = value;
+        } else {
+            if (value < min) min = value;
+            if (value > max) max = value;
+        }
+        ++count;
+        double delta = value - mean;
+        mean += delta / count;
+        m2 += delta * (value - mean);
+    }
+
+    /// Varianza muestral (0 con menos de dos muestras).
+    double variance() const { return count > 1 ? m2 / (count - 1) : 0; }
+
+    /// Desviación típica muestral.
+    double stdDev() const { return std::sqrt(variance()); }
+
+    /// Rango de movimiento recorrido (max - min).
+    double range() const { return count > 0 ? max - min : 0; }
+
+    /// true si no se ha acumulado ninguna muestra.
+    bool isEmpty() const { return count == 0; }
+
+    /// Serializa los estadísticos como objeto JSON compacto.
+    nlohmann::json toJson() const {
+        return {{"n", count}, {"min", min}, {"max", max}, {"mean", mean}, {"m2", m2}};
+    }
+
+    /// Reconstruye los estadísticos a partir de toJson().
+    static LineStats fromJson(const nlohmann::json& j) {
+        LineStats s;
+        s.count = j.value("n", 0);
+        s.min = j.value("min", 0.0);
+        s.max = j.value("max", 0.0);
+        s.mean = j.value("mean", 0.0);
+        s.m2 = j.value("m2", 0.0);
+        return s;
+    }
+};
+
+#endif // LINESTATS_H
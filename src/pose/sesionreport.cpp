@@ -6,27 +6,59 @@
  * Incluye soporte para condiciones categorizadas por serie, repetición y estado, además de rangos angulares y sobrecargas.
  */
 #include "sesionreport.h"
+#include "feedbackmessagetable.h"
+#include <QDataStream>
 /*!
  * \brief Constructor por defecto.
  */
 SesionReport::SesionReport() {}
 
+/*!
+ * \brief Constructor de copia. El registro de ángulos se duplica en lugar de compartir el puntero.
+ */
+SesionReport::SesionReport(const SesionReport& other)
+    : events(other.events), seriesData(other.seriesData), angleData(other.angleData),
+      repetitionStats(other.repetitionStats),
+      angleSeriesData(QSharedPointer<AngleSeriesRecorder>::create(*other.angleSeriesData)),
+      stateNames(other.stateNames), logText(other.logText), pendingSections(other.pendingSections),
+      idSesion(other.idSesion)
+{
+}
+
+SesionReport& SesionReport::operator=(const SesionReport& other)
+{
+    if (this != &other) *this = SesionReport(other);
+    return *this;
+}
+
 
 /*!
- * \brief Añade una condición a la estructura de datos de la sesión, organizándola por serie, repetición y estado.
- *
- * Si la condición ya existe, se actualiza su valor dependiendo del tipo:
- * - Se conserva el máximo, mínimo o se acumula el valor según el tipo de condición.
- * - Se incrementa el contador de ocurrencias.
+ * \brief Registra una condición en la tabla de eventos de la sesión.
  *
- * También se agrega una línea al log textual de eventos.
+ * La condición se incorpora en el momento al agregado por serie, repetición y estado y se inserta al final
+ * de cada columna de la tabla de eventos; el texto del log se genera a partir de los eventos cuando se consulta.
  *
  * \param serie Índice de la serie.
  * \param rep Índice de la repetición.
  * \param stateId ID del estado de la máquina al que pertenece la condición.
  * \param cond Objeto Condition con los detalles de la condición detectada.
+ * \param time Timestamp del frame en milisegundos.
  */
-void SesionReport::addCondition(int serie, int rep, int stateId, Condition cond)
+void SesionReport::addCondition(int serie, int rep, int stateId, const Condition& cond, int64_t time)
+{
+    ensureSection(SeriesSection);
+    mergeCondition(serie, rep, stateId, cond);
+    events.append(time, serie, rep, stateId, cond);
+}
+
+/*!
+ * \brief Incorpora una condición al agregado, organizándola por serie, repetición y estado.
+ *
+ * Si la condición ya existe, se actualiza su valor dependiendo del tipo:
+ * - Se conserva el máximo, mínimo o se acumula el valor según el tipo de condición.
+ * - Se incrementa el contador de ocurrencias.
+ */
+void SesionReport::mergeCondition(int serie, int rep, int stateId, const Condition& cond)
 {
     auto& condMap = seriesData[serie][rep][stateId];
 
@@ -95,17 +127,22 @@ void SesionReport::addCondition(int serie, int rep, int stateId, Condition cond)
         // No existe: insertar con contador 1
         condMap.insert(cond, 1);
     }
+}
 
-    QString stateName = stateNames.value(stateId, "unknown");
-    logText += QString("{View: %1}--[Serie %2, Repetición %3, Estado %4 (%5)]--Tipo: %6, Línea: %7, valor: %8 \n")
-                       .arg(PoseViewToString(cond.view))
-                       .arg(serie)
-                       .arg(rep)
-                       .arg(stateId)
-                       .arg(stateName)
-                       .arg(conditionTypeToString(cond.type))
-                       .arg(cond.keypointLine)
-                       .arg(cond.value.toString());
+/*!
+ * \brief Genera la línea de texto del log para un evento.
+ */
+QString SesionReport::formatEvent(int i) const
+{
+    return QString("{View: %1}--[Serie %2, Repetición %3, Estado %4 (%5)]--Tipo: %6, Línea: %7, valor: %8 \n")
+        .arg(PoseViewToString(events.view(i)))
+        .arg(events.serie(i))
+        .arg(events.rep(i))
+        .arg(events.state(i))
+        .arg(stateNames.value(events.state(i), "unknown"))
+        .arg(conditionTypeToString(events.type(i)))
+        .arg(events.line(i))
+        .arg(events.value(i).toString());
 }
 
 
@@ -128,6 +165,7 @@ void SesionReport::setStateName(int idState, const QString& name)
  */
 QList<Condition> SesionReport::getConditions(int serie, int rep, bool expand) const {
     QList<Condition> result;
+    ensureSection(SeriesSection);
     if (!seriesData.contains(serie) || !seriesData[serie].contains(rep))
         return result;
 
@@ -160,6 +198,7 @@ QList<Condition> SesionReport::getConditions(int serie, int rep, bool expand) co
 
  QList<QPair<Condition, int>> SesionReport::getRawConditions(int serie, int rep) const {
         QList<QPair<Condition, int>> list;
+        ensureSection(SeriesSection);
 
         if (!seriesData.contains(serie) || !seriesData[serie].contains(rep))
             return list;
@@ -182,8 +221,13 @@ QList<Condition> SesionReport::getConditions(int serie, int rep, bool expand) co
  */
 
 void SesionReport::reset() {
+    pendingSections.clear();
+    angleSeriesData = QSharedPointer<AngleSeriesRecorder>::create();
+    events.clear();
     seriesData.clear();
-    globalAngleRange.clear();
+    logText.clear();
+    angleData.clear();
+    repetitionStats.clear();
 }
 
 
@@ -208,6 +252,7 @@ void SesionReport::setIdSesion(int newIdSesion) {
  * \return Lista de índices de series.
  */
 QList<int> SesionReport::getStoredSeries() const {
+    ensureSection(SeriesSection);
     return seriesData.keys();
 }
 /*!
@@ -216,6 +261,7 @@ QList<int> SesionReport::getStoredSeries() const {
  * \return Lista de repeticiones.
  */
 QList<int> SesionReport::getStoredRepetitionsInSerie(int serie) const {
+    ensureSection(SeriesSection);
     return seriesData.value(serie).keys();
 }
 
@@ -225,7 +271,15 @@ QList<int> SesionReport::getStoredRepetitionsInSerie(int serie) const {
  * \param data Estructura anidada por serie, repetición, estado, vista, línea.
  */
 void SesionReport::setLineAngleRange(const QMap<int,QMap<int,QMap<int,QHash<PoseView,QHash<QString, QPair<double, double>>>>>> & data) {
-    globalAngleRange = data;
+    ensureSection(AnglesSection);
+    angleData.clearRanges();
+    for (auto itSerie = data.begin(); itSerie != data.end(); ++itSerie)
+        for (auto itRep = itSerie.value().begin(); itRep != itSerie.value().end(); ++itRep)
+            for (auto itState = itRep.value().begin(); itState != itRep.value().end(); ++itState)
+                for (auto itView = itState.value().begin(); itView != itState.value().end(); ++itView)
+                    for (auto itLine = itView.value().begin(); itLine != itView.value().end(); ++itLine)
+                        angleData.setRange(itSerie.key(), itRep.key(), itState.key(), itView.key(), itLine.key(),
+                                           itLine.value().first, itLine.value().second);
 }
 
 // QPair<double, double> SesionReport::getGlobalRange(const QString& line) const {
@@ -243,6 +297,7 @@ void SesionReport::setLineAngleRange(const QMap<int,QMap<int,QMap<int,QHash<Pose
 nlohmann::json SesionReport::toSeriesJson() const
 {
     nlohmann::json json;
+    ensureSection(SeriesSection);
 
     for (auto itSerie = seriesData.begin(); itSerie != seriesData.end(); ++itSerie) {
         int serie = itSerie.key();
@@ -302,6 +357,8 @@ nlohmann::json SesionReport::toSeriesJson() const
  */
 nlohmann::json SesionReport::toGlobalAnglesJson() const {
     nlohmann::json json;
+    ensureSection(AnglesSection);
+    const auto globalAngleRange = angleData.toRangeMap();
 
     for (auto itSerie = globalAngleRange.begin(); itSerie != globalAngleRange.end(); ++itSerie) {
         int serie = itSerie.key();
@@ -334,10 +391,14 @@ nlohmann::json SesionReport::toGlobalAnglesJson() const {
 
 /*!
  * \brief Deserializa el JSON que contiene condiciones organizadas por serie, repetición y estado.
+ *
+ * El JSON solo contiene el agregado, así que se carga directamente en él y se descartan los eventos.
  * \param json Objeto JSON con condiciones a cargar.
  */
 void SesionReport::fromSeriesJson(const nlohmann::json& json)
 {
+    pendingSections.remove(SeriesSection);
+    events.clear();
     seriesData.clear();
     stateNames.clear();
 
@@ -407,7 +468,8 @@ void SesionReport::fromSeriesJson(const nlohmann::json& json)
  * \param json Objeto JSON con rangos por estado y vista.
  */
 void SesionReport::fromGlobalAnglesJson(const nlohmann::json& json) {
-    globalAngleRange.clear();
+    ensureSection(AnglesSection);
+    angleData.clearRanges();
 
     for (auto& serieIt : json.items()) {
         int serie = QString::fromStdString(serieIt.key()).toInt();
@@ -429,7 +491,7 @@ void SesionReport::fromGlobalAnglesJson(const nlohmann::json& json) {
                         if (arr.is_array() && arr.size() == 2) {
                             double minVal = arr[0].get<double>();
                             double maxVal = arr[1].get<double>();
-                            globalAngleRange[serie][rep][state][view][line] = qMakePair(minVal, maxVal);
+                            angleData.setRange(serie, rep, state, view, line, minVal, maxVal);
                         } else {
                             qWarning() << "[fromGlobalAnglesJson] Formato inválido para línea:"
                                        << line << " en serie:" << serie << " rep:" << rep;
@@ -453,6 +515,8 @@ nlohmann::json SesionReport::toGlobalOverloadsJson() const {
     PoseView view;
     QString line,viewStr ;
     double value,maxVal;
+    ensureSection(AnglesSection);
+    const auto globalAngleOverloads = angleData.toOverloadMap();
 
     for (auto itSerie = globalAngleOverloads.begin(); itSerie != globalAngleOverloads.end(); ++itSerie) {
          serie = itSerie.key();
@@ -480,7 +544,8 @@ nlohmann::json SesionReport::toGlobalOverloadsJson() const {
  * \param json Objeto JSON con datos de sobrecarga.
  */
 void SesionReport::fromGlobalOverloadsJson(const nlohmann::json& json) {
-    globalAngleOverloads.clear();
+    ensureSection(AnglesSection);
+    angleData.clearOverloads();
 
     for (auto& serieIt : json.items()) {
         int serie = QString::fromStdString(serieIt.key()).toInt();
@@ -500,7 +565,7 @@ void SesionReport::fromGlobalOverloadsJson(const nlohmann::json& json) {
                         const auto& val = lineIt.value();
                         if (val.is_number()) {
                             double value = val.get<double>();
-                            globalAngleOverloads[serie][rep][state][view][line] = value;
+                            angleData.setOverload(serie, rep, state, view, line, value);
                         } else {
                             qWarning() << "[fromGlobalOverloadsJson] Formato inválido para línea:"
                                        << line << " en serie:" << serie << " rep:" << rep;
@@ -512,20 +577,107 @@ void SesionReport::fromGlobalOverloadsJson(const nlohmann::json& json) {
     }
 }
 
+/*!
+ * \brief Guarda los estadísticos de ángulo de una repetición completada.
+ * \param serie Serie de la repetición.
+ * \param rep Número de repetición.
+ * \param stats Estadísticos por vista y línea.
+ */
+void SesionReport::setRepetitionStats(int serie, int rep, const QHash<PoseView, QHash<QString, LineStats>>& stats)
+{
+    ensureSection(RepStatsSection);
+    repetitionStats[serie][rep] = stats;
+}
+
+/*!
+ * \brief Devuelve los estadísticos de ángulo de una repetición.
+ * \param serie Serie de la repetición.
+ * \param rep Número de repetición.
+ * \return Estadísticos por vista y línea.
+ */
+QHash<PoseView, QHash<QString, LineStats>> SesionReport::getRepetitionStats(int serie, int rep) const
+{
+    ensureSection(RepStatsSection);
+    return repetitionStats.value(serie).value(rep);
+}
+
+/*!
+ * \brief Serializa los estadísticos por repetición.
+ * \return Objeto JSON organizado por serie, repetición, vista y línea.
+ */
+nlohmann::json SesionReport::toRepetitionStatsJson() const
+{
+    nlohmann::json json = nlohmann::json::object();
+    ensureSection(RepStatsSection);
+
+    for (auto itSerie = repetitionStats.begin(); itSerie != repetitionStats.end(); ++itSerie) {
+        for (auto itRep = itSerie.value().begin(); itRep != itSerie.value().end(); ++itRep) {
+            for (auto itView = itRep.value().begin(); itView != itRep.value().end(); ++itView) {
+                std::string viewStr = PoseViewToString(itView.key()).toStdString();
+                for (auto itLine = itView.value().begin(); itLine != itView.value().end(); ++itLine) {
+                    json[std::to_string(itSerie.key())][std::to_string(itRep.key())][viewStr][itLine.key().toStdString()] = itLine.value().toJson();
+                }
+            }
+        }
+    }
+
+    return json;
+}
+
+/*!
+ * \brief Deserializa los estadísticos por repetición.
+ * \param json Objeto JSON generado por toRepetitionStatsJson().
+ */
+void SesionReport::fromRepetitionStatsJson(const nlohmann::json& json)
+{
+    pendingSections.remove(RepStatsSection);
+    repetitionStats.clear();
+
+    for (auto& serieIt : json.items()) {
+        int serie = QString::fromStdString(serieIt.key()).toInt();
+        for (auto& repIt : serieIt.value().items()) {
+            int rep = QString::fromStdString(repIt.key()).toInt();
+            for (auto& viewIt : repIt.value().items()) {
+                PoseView view = PoseViewFromString(QString::fromStdString(viewIt.key()));
+                for (auto& lineIt : viewIt.value().items()) {
+                    if (!lineIt.value().is_object()) {
+                        qWarning() << "[fromRepetitionStatsJson] Formato inválido para línea:"
+                                   << QString::fromStdString(lineIt.key()) << " en serie:" << serie << " rep:" << rep;
+                        continue;
+                    }
+                    repetitionStats[serie][rep][view][QString::fromStdString(lineIt.key())] = LineStats::fromJson(lineIt.value());
+                }
+            }
+        }
+    }
+}
+
 /*!
  * \brief Devuelve el texto completo del log de eventos generados durante la sesión.
+ *
+ * El texto se genera en este momento a partir de la tabla de eventos, precedido del log cargado con
+ * setLog() si lo hay.
  * \return Cadena de texto acumulado.
  */
 QString SesionReport::getLog() const
 {
-    return logText;
+    ensureSection(LogSection);
+    ensureSection(EventsSection);
+    QString log = logText;
+    for (int i = 0; i < events.size(); ++i)
+        log += formatEvent(i);
+    return log;
 }
 /*!
  * \brief Establece el contenido del log de eventos.
+ *
+ * Se usa al cargar sesiones guardadas, cuyo log solo existe como texto.
  * \param newLog Texto de log a asignar.
  */
 void SesionReport::setLog(const QString &newLog)
 {
+    ensureSection(EventsSection);
+    pendingSections.remove(LogSection);
     logText = newLog;
 }
 /*!
@@ -534,9 +686,75 @@ void SesionReport::setLog(const QString &newLog)
  */
 QHash<int, QHash<int, QHash<int, QHash<Condition, int> > > > SesionReport::getSeriesData() const
 {
+    ensureSection(SeriesSection);
     return seriesData;
 }
 
+/*!
+ * \brief Las repeticiones y el tiempo bajo tensión salen de las condiciones EndOfRepetition, cuyo valor es la
+ * duración de la repetición. El rango de cada línea se calcula por repetición y vista, uniendo los estados, y se
+ * conserva el mayor.
+ */
+SesionSummary SesionReport::summarize() const
+{
+    SesionSummary summary;
+    const QSharedPointer<const FeedbackMessageTable> messages = FeedbackMessageTable::defaultTable();
+
+    ensureSection(SeriesSection);
+    for (const auto& reps : std::as_const(seriesData)) {
+        for (const auto& states : reps) {
+            for (const auto& conditions : states) {
+                for (auto it = conditions.constBegin(); it != conditions.constEnd(); ++it) {
+                    const Condition& cond = it.key();
+                    const int count = it.value();
+                    switch (messages->category(cond.type)) {
+                    case ConditionCategory::critical: summary.criticalCount += count; break;
+                    case ConditionCategory::alert: summary.alertCount += count; break;
+                    case ConditionCategory::info: summary.infoCount += count; break;
+                    default: break;
+                    }
+                    if (cond.type == ConditionType::EndOfRepetition) {
+                        summary.repetitions += count;
+                        summary.timeUnderTension += cond.value.toLongLong();
+                    } else if (cond.type == ConditionType::JointOverload) {
+                        summary.overloadCount += count;
+                        summary.lineOverloads[cond.keypointLine] += count;
+                    }
+                }
+            }
+        }
+    }
+
+    const auto ranges = getGlobalAngleRange();
+    for (const auto& reps : ranges) {
+        for (const auto& states : reps) {
+            QHash<PoseView, QHash<QString, QPair<double, double>>> repRange;
+            for (const auto& views : states) {
+                for (auto v = views.constBegin(); v != views.constEnd(); ++v) {
+                    for (auto l = v.value().constBegin(); l != v.value().constEnd(); ++l) {
+                        auto& range = repRange[v.key()];
+                        auto found = range.find(l.key());
+                        if (found == range.end()) {
+                            range.insert(l.key(), l.value());
+                        } else {
+                            found->first = qMin(found->first, l.value().first);
+                            found->second = qMax(found->second, l.value().second);
+                        }
+                    }
+                }
+            }
+            for (const auto& lines : std::as_const(repRange)) {
+                for (auto l = lines.constBegin(); l != lines.constEnd(); ++l) {
+                    const double rom = l.value().second - l.value().first;
+                    double& best = summary.lineRom[l.key()];
+                    best = qMax(best, rom);
+                }
+            }
+        }
+    }
+    return summary;
+}
+
 /*!
  * \brief Devuelve una representación textual detallada de todas las condiciones registradas.
  * \return Cadena con la información formateada.
@@ -544,6 +762,7 @@ QHash<int, QHash<int, QHash<int, QHash<Condition, int> > > > SesionReport::getSe
 QString SesionReport::printSeriesData() const
 {
     QString str="";
+    ensureSection(SeriesSection);
     if (seriesData.isEmpty()) {
         return "No hay datos en seriesData.\n";
     }
@@ -610,7 +829,8 @@ void SesionReport::setStateNames(const QHash<int, QString> &newStateNames)
  */
 QMap<int, QMap<int, QMap<int, QHash<PoseView, QHash<QString, QPair<double, double> > > > > > SesionReport::getGlobalAngleRange() const
 {
-    return globalAngleRange;
+    ensureSection(AnglesSection);
+    return angleData.toRangeMap();
 }
 /*!
  * \brief Devuelve las sobrecargas angulares registradas.
@@ -618,7 +838,8 @@ QMap<int, QMap<int, QMap<int, QHash<PoseView, QHash<QString, QPair<double, doubl
  */
 QMap<int, QMap<int, QMap<int, QHash<PoseView, QHash<QString, double> > > > > SesionReport::getGlobalAngleOverloads() const
 {
-    return globalAngleOverloads;
+    ensureSection(AnglesSection);
+    return angleData.toOverloadMap();
 }
 /*!
  * \brief Establece los valores de sobrecarga angular.
@@ -626,7 +847,42 @@ QMap<int, QMap<int, QMap<int, QHash<PoseView, QHash<QString, double> > > > > Ses
  */
 void SesionReport::setGlobalAngleOverloads(const QMap<int, QMap<int, QMap<int,QHash<PoseView, QHash<QString, double> >>>> &newGlobalAngleOverloads)
 {
-    globalAngleOverloads = newGlobalAngleOverloads;
+    ensureSection(AnglesSection);
+    angleData.clearOverloads();
+    for (auto itSerie = newGlobalAngleOverloads.begin(); itSerie != newGlobalAngleOverloads.end(); ++itSerie)
+        for (auto itRep = itSerie.value().begin(); itRep != itSerie.value().end(); ++itRep)
+            for (auto itState = itRep.value().begin(); itState != itRep.value().end(); ++itState)
+                for (auto itView = itState.value().begin(); itView != itState.value().end(); ++itView)
+                    for (auto itLine = itView.value().begin(); itLine != itView.value().end(); ++itLine)
+                        angleData.setOverload(itSerie.key(), itRep.key(), itState.key(), itView.key(), itLine.key(), itLine.value());
+}
+
+/*!
+ * \brief Acceso directo al acumulador denso de rangos y sobrecargas. La máquina de estados escribe en él
+ * en cada frame sin pasar por estructuras intermedias.
+ */
+AngleAccumulator& SesionReport::angleAccumulator()
+{
+    ensureSection(AnglesSection);
+    return angleData;
+}
+
+/*!
+ * \brief Sustituye el acumulador de rangos y sobrecargas transfiriendo su contenido.
+ * \param accumulator Acumulador preasignado, normalmente con las dimensiones del ejercicio.
+ */
+void SesionReport::setAngleAccumulator(AngleAccumulator&& accumulator)
+{
+    pendingSections.remove(AnglesSection);
+    angleData = std::move(accumulator);
+}
+/*!
+ * \brief Devuelve el registro de ángulos por frame. La máquina de estados añade en él cada frame analizado.
+ */
+QSharedPointer<AngleSeriesRecorder> SesionReport::angleSeries() const
+{
+    ensureSection(AngleSeriesSection);
+    return angleSeriesData;
 }
 /*!
  * \brief Devuelve los encabezados de columna para representar el log en una vista tabular.
@@ -636,10 +892,37 @@ QStringList SesionReport::getLogColumnHeaders() const {
     return { "View", "Serie", "Repetición", "Estado", "Texto Completo" };
 }
 /*!
- * \brief Parsea el log acumulado en filas tabulares para mostrar en tablas de UI.
+ * \brief Construye las filas tabulares del log para mostrar en tablas de UI.
+ *
+ * Las filas de los eventos de la sesión se leen directamente de sus columnas; solo el log cargado como
+ * texto (sesiones guardadas) se analiza línea a línea.
  * \return Lista de filas, donde cada fila es una lista de celdas QVariant.
  */
 QList<QList<QVariant>> SesionReport::parseLog() const {
+    ensureSection(LogSection);
+    ensureSection(EventsSection);
+    QList<QList<QVariant>> rows = parseLogText(logText);
+    rows.reserve(rows.size() + events.size());
+
+    for (int i = 0; i < events.size(); ++i) {
+        QString text = formatEvent(i).trimmed();
+        int sepIndex = text.indexOf("]--");
+        rows.append({ PoseViewToString(events.view(i)),
+                      QString::number(events.serie(i)),
+                      QString::number(events.rep(i)),
+                      QString::number(events.state(i)),
+                      sepIndex != -1 ? text.mid(sepIndex + 3).trimmed() : text });
+    }
+
+    return rows;
+}
+
+/*!
+ * \brief Analiza un log en formato texto y lo convierte en filas tabulares.
+ * \param logText Texto del log con una línea por evento.
+ * \return Lista de filas con columnas: View, Serie, Repetición, Estado, Texto.
+ */
+QList<QList<QVariant>> SesionReport::parseLogText(const QString& logText) {
     QList<QList<QVariant>> rows;
 
     QStringList lines = logText.split("\n", Qt::SkipEmptyParts);
@@ -698,3 +981,308 @@ QList<QList<QVariant>> SesionReport::parseLog() const {
     return rows;
 }
 
+
+namespace {
+const quint32 kBinaryMagic = 0x53455352; // "SESR"
+const quint16 kBinaryVersion = 1;
+}
+
+/*!
+ * \brief Codifica el reporte en binario.
+ *
+ * Formato (QDataStream, Qt 6.0): magic, versión, número de secciones y, por sección, su identificador y su
+ * contenido como QByteArray con longitud. Las secciones cargadas que no se han llegado a decodificar se
+ * copian tal cual, salvo las que dependen de eventos registrados después de la carga.
+ * \return Bloque binario del reporte.
+ */
+QByteArray SesionReport::toBinary() const
+{
+    const QList<Section> sections = { SeriesSection, StateNamesSection, AnglesSection,
+                                      RepStatsSection, AngleSeriesSection, EventsSection };
+
+    QByteArray out;
+    QDataStream stream(&out, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << kBinaryMagic << kBinaryVersion << quint16(sections.size());
+
+    for (Section section : sections) {
+        const bool dependsOnEvents = section == SeriesSection || section == EventsSection;
+        const bool stale = (dependsOnEvents && !events.isEmpty())
+                           || (section == EventsSection && pendingSections.contains(LogSection));
+        auto it = pendingSections.constFind(section);
+        if (it != pendingSections.constEnd() && !stale)
+            stream << quint8(section) << it.value();
+        else
+            stream << quint8(section) << encodeSection(section);
+    }
+    return out;
+}
+
+/*!
+ * \brief Separa las secciones del bloque binario. Solo los nombres de estado se decodifican en el momento,
+ * porque los necesitan casi todas las vistas; el resto queda pendiente hasta su primera consulta.
+ *
+ * Los bloques antiguos guardan el log como texto (LogSection) en lugar de la tabla de eventos; ese texto se
+ * sigue leyendo y se conserva como log cargado.
+ */
+bool SesionReport::fromBinary(const QByteArray& data)
+{
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    quint16 count = 0;
+    stream >> magic >> version >> count;
+    if (stream.status() != QDataStream::Ok || magic != kBinaryMagic) {
+        qWarning() << "[SesionReport] Formato binario no reconocido";
+        return false;
+    }
+    if (version > kBinaryVersion) {
+        qWarning() << "[SesionReport] Versión de formato binario no soportada:" << version;
+        return false;
+    }
+
+    reset();
+    for (quint16 i = 0; i < count; ++i) {
+        quint8 id;
+        QByteArray payload;
+        stream >> id >> payload;
+        if (stream.status() != QDataStream::Ok) {
+            qWarning() << "[SesionReport] Bloque binario truncado en la sección" << i;
+            reset();
+            return false;
+        }
+        // Las secciones desconocidas (versiones posteriores) se ignoran
+        if (id >= SeriesSection && id <= EventsSection)
+            pendingSections.insert(id, payload);
+    }
+
+    QDataStream namesStream(pendingSections.take(StateNamesSection));
+    namesStream.setVersion(QDataStream::Qt_6_0);
+    QHash<int, QString> names;
+    namesStream >> names;
+    for (auto it = names.constBegin(); it != names.constEnd(); ++it)
+        stateNames.insert(it.key(), it.value());
+    return true;
+}
+
+/*!
+ * \brief Decodifica una sección pendiente, si la hay. Se retira antes de decodificarla para que las
+ * funciones que la consultan puedan usarse durante la decodificación.
+ */
+void SesionReport::ensureSection(Section section) const
+{
+    auto it = pendingSections.find(section);
+    if (it == pendingSections.end()) return;
+
+    QByteArray payload = it.value();
+    pendingSections.erase(it);
+    decodeSection(section, payload);
+}
+
+/*!
+ * \brief Codifica una sección a partir de las estructuras en memoria.
+ *
+ * Las condiciones, rangos y estadísticos se escriben como tuplas planas con campos numéricos, de modo que
+ * la lectura no tiene que convertir claves de texto.
+ */
+QByteArray SesionReport::encodeSection(Section section) const
+{
+    QByteArray out;
+    QDataStream stream(&out, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    switch (section) {
+    case SeriesSection: {
+        ensureSection(SeriesSection);
+        quint32 cells = 0;
+        for (const auto& reps : seriesData)
+            for (const auto& states : reps)
+                for (const auto& conds : states)
+                    cells += conds.size();
+
+        stream << cells;
+        for (auto itSerie = seriesData.constBegin(); itSerie != seriesData.constEnd(); ++itSerie)
+            for (auto itRep = itSerie.value().constBegin(); itRep != itSerie.value().constEnd(); ++itRep)
+                for (auto itState = itRep.value().constBegin(); itState != itRep.value().constEnd(); ++itState)
+                    for (auto itCond = itState.value().constBegin(); itCond != itState.value().constEnd(); ++itCond) {
+                        const Condition& c = itCond.key();
+                        stream << qint32(itSerie.key()) << qint32(itRep.key()) << qint32(itState.key())
+                               << quint8(c.type) << c.keypointLine << quint8(c.view) << c.value
+                               << qint32(itCond.value());
+                    }
+        break;
+    }
+    case StateNamesSection:
+        stream << stateNames;
+        break;
+    case AnglesSection: {
+        ensureSection(AnglesSection);
+        const auto ranges = angleData.toRangeMap();
+        const auto overloads = angleData.toOverloadMap();
+
+        QList<QPair<quint32, QByteArray>> parts;
+        for (int kind = 0; kind < 2; ++kind) {
+            QByteArray buffer;
+            QDataStream part(&buffer, QIODevice::WriteOnly);
+            part.setVersion(QDataStream::Qt_6_0);
+            quint32 n = 0;
+            auto writeCell = [&](int serie, int rep, int state, PoseView view, const QString& line) {
+                part << qint32(serie) << qint32(rep) << qint32(state) << quint8(view) << line;
+                ++n;
+            };
+            if (kind == 0) {
+                for (auto s = ranges.constBegin(); s != ranges.constEnd(); ++s)
+                    for (auto r = s.value().constBegin(); r != s.value().constEnd(); ++r)
+                        for (auto st = r.value().constBegin(); st != r.value().constEnd(); ++st)
+                            for (auto v = st.value().constBegin(); v != st.value().constEnd(); ++v)
+                                for (auto l = v.value().constBegin(); l != v.value().constEnd(); ++l) {
+                                    writeCell(s.key(), r.key(), st.key(), v.key(), l.key());
+                                    part << l.value().first << l.value().second;
+                                }
+            } else {
+                for (auto s = overloads.constBegin(); s != overloads.constEnd(); ++s)
+                    for (auto r = s.value().constBegin(); r != s.value().constEnd(); ++r)
+                        for (auto st = r.value().constBegin(); st != r.value().constEnd(); ++st)
+                            for (auto v = st.value().constBegin(); v != st.value().constEnd(); ++v)
+                                for (auto l = v.value().constBegin(); l != v.value().constEnd(); ++l) {
+                                    writeCell(s.key(), r.key(), st.key(), v.key(), l.key());
+                                    part << l.value();
+                                }
+            }
+            parts.append(qMakePair(n, buffer));
+        }
+        for (const auto& part : parts) {
+            stream << part.first;
+            stream.writeRawData(part.second.constData(), part.second.size());
+        }
+        break;
+    }
+    case RepStatsSection: {
+        ensureSection(RepStatsSection);
+        quint32 n = 0;
+        for (const auto& reps : repetitionStats)
+            for (const auto& views : reps)
+                for (const auto& lines : views)
+                    n += lines.size();
+
+        stream << n;
+        for (auto s = repetitionStats.constBegin(); s != repetitionStats.constEnd(); ++s)
+            for (auto r = s.value().constBegin(); r != s.value().constEnd(); ++r)
+                for (auto v = r.value().constBegin(); v != r.value().constEnd(); ++v)
+                    for (auto l = v.value().constBegin(); l != v.value().constEnd(); ++l) {
+                        const LineStats& st = l.value();
+                        stream << qint32(s.key()) << qint32(r.key()) << quint8(v.key()) << l.key()
+                               << qint32(st.count) << st.min << st.max << st.mean << st.m2;
+                    }
+        break;
+    }
+    case LogSection:
+        // Solo se escribe EventsSection; LogSection queda para leer bloques antiguos
+        break;
+    case EventsSection:
+        ensureSection(LogSection);
+        ensureSection(EventsSection);
+        stream << qCompress(logText.toUtf8()) << qCompress(events.serialize());
+        break;
+    case AngleSeriesSection:
+        stream << angleSeries()->serialize();
+        break;
+    }
+    return out;
+}
+
+/*!
+ * \brief Decodifica el contenido de una sección sobre las estructuras en memoria.
+ */
+void SesionReport::decodeSection(Section section, const QByteArray& payload) const
+{
+    QDataStream stream(payload);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    switch (section) {
+    case SeriesSection: {
+        quint32 cells = 0;
+        stream >> cells;
+        for (quint32 i = 0; i < cells && stream.status() == QDataStream::Ok; ++i) {
+            qint32 serie, rep, state, count;
+            quint8 type, view;
+            QString line;
+            QVariant value;
+            stream >> serie >> rep >> state >> type >> line >> view >> value >> count;
+            Condition cond(static_cast<ConditionType>(type), line, value, static_cast<PoseView>(view));
+            seriesData[serie][rep][state].insert(cond, count);
+        }
+        break;
+    }
+    case StateNamesSection:
+        // Se decodifica en fromBinary()
+        break;
+    case AnglesSection:
+        for (int kind = 0; kind < 2; ++kind) {
+            quint32 n = 0;
+            stream >> n;
+            for (quint32 i = 0; i < n && stream.status() == QDataStream::Ok; ++i) {
+                qint32 serie, rep, state;
+                quint8 view;
+                QString line;
+                stream >> serie >> rep >> state >> view >> line;
+                if (kind == 0) {
+                    double min, max;
+                    stream >> min >> max;
+                    angleData.setRange(serie, rep, state, static_cast<PoseView>(view), line, min, max);
+                } else {
+                    double value;
+                    stream >> value;
+                    angleData.setOverload(serie, rep, state, static_cast<PoseView>(view), line, value);
+                }
+            }
+        }
+        break;
+    case RepStatsSection: {
+        quint32 n = 0;
+        stream >> n;
+        for (quint32 i = 0; i < n && stream.status() == QDataStream::Ok; ++i) {
+            qint32 serie, rep, count;
+            quint8 view;
+            QString line;
+            LineStats st;
+            stream >> serie >> rep >> view >> line >> count >> st.min >> st.max >> st.mean >> st.m2;
+            st.count = count;
+            repetitionStats[serie][rep][static_cast<PoseView>(view)][line] = st;
+        }
+        break;
+    }
+    case LogSection: {
+        QByteArray compressed;
+        stream >> compressed;
+        logText = QString::fromUtf8(qUncompress(compressed)) + logText;
+        break;
+    }
+    case EventsSection: {
+        QByteArray text, table;
+        stream >> text >> table;
+        logText = QString::fromUtf8(qUncompress(text)) + logText;
+
+        // Los eventos cargados preceden a los registrados después de la carga y ya están en SeriesSection
+        ConditionEventLog loaded;
+        if (loaded.deserialize(qUncompress(table))) {
+            for (int i = 0; i < events.size(); ++i)
+                loaded.append(events.time(i), events.serie(i), events.rep(i), events.state(i), events.condition(i));
+            events = std::move(loaded);
+        }
+        break;
+    }
+    case AngleSeriesSection: {
+        QByteArray data;
+        stream >> data;
+        auto recorder = QSharedPointer<AngleSeriesRecorder>::create();
+        if (recorder->deserialize(data)) angleSeriesData = recorder;
+        break;
+    }
+    }
+
+    if (stream.status() != QDataStream::Ok)
+        qWarning() << "[SesionReport] Sección binaria" << int(section) << "incompleta o corrupta";
+}
@@ -6,7 +6,14 @@
 #include <QList>
 #include <QSet>
 #include <QPair>
+#include <QByteArray>
 #include "condition.h"
+#include "linestats.h"
+#include "angleaccumulator.h"
+#include "conditioneventlog.h"
+#include "angleseriesrecorder.h"
+#include "sesionsummary.h"
+#include <QSharedPointer>
 #include <nlohmann/json.hpp>
 
 /*!
@@ -14,7 +21,14 @@
  * \brief Declaración de la clase SesionReport para el almacenamiento estructurado de condiciones detectadas durante la ejecución del ejercicio.
  *
  * Esta clase permite almacenar, consultar y exportar en JSON todas las condiciones generadas durante una sesión de entrenamiento,
- * clasificadas por serie, repetición y estado de la máquina. También permite almacenar los ángulos globales y los valores de sobrecarga por línea.
+ * clasificadas por serie, repetición y estado de la máquina. Cada condición se incorpora al agregado al registrarse y se guarda
+ * en una tabla de eventos columnar, de la que se genera el texto del log bajo demanda. También permite almacenar los ángulos
+ * globales y los valores de sobrecarga por línea.
+ *
+ * Un reporte cargado con fromBinary() decodifica cada sección la primera vez que se consulta, también desde los métodos
+ * const, por lo que la clase no es segura entre hilos: un mismo reporte solo debe usarse desde un hilo a la vez. Para
+ * leerlo desde otro hilo (por ejemplo, al guardarlo mientras la interfaz lo muestra) se pasa una copia hecha en el hilo
+ * que lo usa; la copia no comparte ningún dato con el original, tampoco el registro de ángulos por frame.
  */
 
 class SesionReport
@@ -26,13 +40,23 @@ public:
     SesionReport();
 
     /*!
-     * \brief Agrega una condición a la estructura de datos de la sesión.
+     * \brief Constructor de copia. Copia también el registro de ángulos por frame, que la máquina de estados
+     * sigue ampliando en el original.
+     */
+    SesionReport(const SesionReport& other);
+    SesionReport& operator=(const SesionReport& other);
+    SesionReport(SesionReport&&) = default;
+    SesionReport& operator=(SesionReport&&) = default;
+
+    /*!
+     * \brief Registra una condición en la tabla de eventos de la sesión.
      * \param serie Número de serie del ejercicio.
      * \param rep Número de repetición dentro de la serie.
      * \param stateId ID del estado activo al registrar la condición.
      * \param cond Condición que se desea registrar.
+     * \param time Timestamp del frame en milisegundos.
      */
-    void addCondition(int serie, int rep, int stateId, Condition cond);
+    void addCondition(int serie, int rep, int stateId, const Condition& cond, int64_t time = 0);
 
     /*!
      * \brief Devuelve las series que contienen datos registrados.
@@ -160,6 +184,15 @@ public:
      */
     QHash<int, QHash<int, QHash<int, QHash<Condition, int>>>> getSeriesData() const;
 
+    /*!
+     * \brief Reduce el reporte a su resumen compacto para las tendencias de progreso.
+     *
+     * Solo usa el agregado de condiciones y los rangos angulares, por lo que también sirve para reportes
+     * cargados con fromBinary().
+     * \return Contadores por categoría, repeticiones, tiempo bajo tensión y datos por línea.
+     */
+    SesionSummary summarize() const;
+
     /*!
      * \brief Devuelve una representación en texto plano del contenido de seriesData.
      * \return Cadena de texto con los datos.
@@ -180,6 +213,8 @@ public:
 
     /*!
      * \brief Devuelve los rangos globales angulares por línea y estado.
+     *
+     * La estructura anidada se genera bajo demanda a partir del acumulador denso.
      * \return Estructura por serie, rep, estado, vista, línea.
      */
     QMap<int, QMap<int, QMap<int, QHash<PoseView, QHash<QString, QPair<double, double>>>>>> getGlobalAngleRange() const;
@@ -190,6 +225,67 @@ public:
      */
     QMap<int, QMap<int, QMap<int, QHash<PoseView, QHash<QString, double>>>>> getGlobalAngleOverloads() const;
 
+    /*!
+     * \brief Guarda los estadísticos de ángulo (min, max, media, varianza) de una repetición.
+     * \param serie Número de serie.
+     * \param rep Número de repetición.
+     * \param stats Estadísticos por vista y línea.
+     */
+    void setRepetitionStats(int serie, int rep, const QHash<PoseView, QHash<QString, LineStats>>& stats);
+
+    /*!
+     * \brief Devuelve los estadísticos de ángulo de una repetición.
+     * \return Estadísticos por vista y línea; vacío si la repetición no se completó.
+     */
+    QHash<PoseView, QHash<QString, LineStats>> getRepetitionStats(int serie, int rep) const;
+
+    /*!
+     * \brief Serializa los estadísticos por repetición en formato JSON.
+     * \return Objeto JSON organizado por serie, repetición, vista y línea.
+     */
+    nlohmann::json toRepetitionStatsJson() const;
+
+    /*!
+     * \brief Carga los estadísticos por repetición desde JSON.
+     * \param json Objeto JSON generado por toRepetitionStatsJson().
+     */
+    void fromRepetitionStatsJson(const nlohmann::json& json);
+
+    /*!
+     * \brief Devuelve el acumulador denso de rangos y sobrecargas para actualizarlo en cada frame.
+     * \return Referencia al acumulador interno.
+     */
+    AngleAccumulator& angleAccumulator();
+
+    /*!
+     * \brief Sustituye el acumulador de rangos y sobrecargas sin copiar sus datos.
+     * \param accumulator Acumulador a transferir.
+     */
+    void setAngleAccumulator(AngleAccumulator&& accumulator);
+
+    /*!
+     * \brief Devuelve el registro comprimido de los ángulos de todos los frames de la sesión.
+     *
+     * Cada copia del reporte tiene su propio registro.
+     * \return Puntero al registro de este reporte.
+     */
+    QSharedPointer<AngleSeriesRecorder> angleSeries() const;
+
+    /*!
+     * \brief Codifica el reporte completo en el formato binario versionado que se guarda en la base de datos.
+     * \return Bloque binario con una cabecera y una sección por tipo de dato.
+     */
+    QByteArray toBinary() const;
+
+    /*!
+     * \brief Carga el reporte desde el formato de toBinary().
+     *
+     * Las secciones solo se separan; cada una se decodifica la primera vez que se consulta.
+     * \param data Bloque binario.
+     * \return false si la cabecera o la versión no son válidas.
+     */
+    bool fromBinary(const QByteArray& data);
+
     /*!
      * \brief Devuelve los encabezados de columna para la visualización del log.
      * \return Lista de nombres de columnas.
@@ -203,12 +299,33 @@ public:
     QList<QList<QVariant>> parseLog() const;
 
 private:
-    QHash<int, QHash<int, QHash<int, QHash<Condition, int>>>> seriesData; //!< Condiciones por serie, repetición y estado.
-    QMap<int, QMap<int, QMap<int, QHash<PoseView, QHash<QString, QPair<double, double>>>>>> globalAngleRange; //!< Rango angular por línea.
-    QMap<int, QMap<int, QMap<int, QHash<PoseView, QHash<QString, double>>>>> globalAngleOverloads; //!< Sobrecarga angular.
+    /// Secciones del formato binario. Los identificadores no deben reutilizarse.
+    enum Section : quint8 {
+        SeriesSection = 1,
+        StateNamesSection = 2,
+        AnglesSection = 3,
+        RepStatsSection = 4,
+        LogSection = 5,         //!< Log como texto; solo en bloques antiguos, se sigue leyendo.
+        AngleSeriesSection = 6,
+        EventsSection = 7       //!< Tabla de eventos por columnas y log de texto cargado con setLog().
+    };
+
+    mutable ConditionEventLog events; //!< Tabla de eventos de la sesión, en orden de llegada. Los eventos de un bloque binario se cargan al consultarla.
+    mutable QHash<int, QHash<int, QHash<int, QHash<Condition, int>>>> seriesData; //!< Agregado de condiciones por serie, repetición y estado.
+    mutable AngleAccumulator angleData; //!< Rango angular y sobrecarga por serie, repetición, estado, vista y línea.
+    mutable QMap<int, QMap<int, QHash<PoseView, QHash<QString, LineStats>>>> repetitionStats; //!< Estadísticos de ángulo por repetición.
+    mutable QSharedPointer<AngleSeriesRecorder> angleSeriesData = QSharedPointer<AngleSeriesRecorder>::create(); //!< Ángulos por frame.
     QHash<int, QString> stateNames; //!< Nombre de estados.
-    QString logText; //!< Texto acumulado del log de condiciones.
+    mutable QString logText; //!< Log en formato texto cargado con setLog().
+    mutable QHash<quint8, QByteArray> pendingSections; //!< Secciones binarias cargadas y aún sin decodificar.
     int idSesion = -1; //!< ID de la sesión actual.
+
+    void mergeCondition(int serie, int rep, int stateId, const Condition& cond);
+    QString formatEvent(int i) const;
+    static QList<QList<QVariant>> parseLogText(const QString& logText);
+    void ensureSection(Section section) const;
+    QByteArray encodeSection(Section section) const;
+    void decodeSection(Section section, const QByteArray& payload) const;
 };
 
 
@@ -0,0 +1,58 @@
+/**
+ * @file sesionsummary.h
+ * @brief Resumen compacto de una sesión de entrenamiento para las tendencias de progreso.
+ *
+ * Define la estructura `SesionSummary`, que reduce el reporte de una sesión a unos pocos contadores y, por
+ * línea, al rango de movimiento alcanzado y al número de sobrecargas. Se calcula al guardar la sesión y se
+ * escribe en la tabla `SesionSummary`, de la que la base de datos deriva los acumulados diarios y semanales.
+ */
+
+#ifndef SESIONSUMMARY_H
+#define SESIONSUMMARY_H
+
+#include <QDate>
+#include <QHash>
+#include <QString>
+#include <nlohmann/json.hpp>
+
+/**
+ * @struct SesionSummary
+ * @brief Fila de resumen de una sesión: contadores por categoría, repeticiones, tiempo bajo tensión y datos por línea.
+ */
+struct SesionSummary {
+    int criticalCount = 0;              ///< Condiciones de categoría crítica.
+    int alertCount = 0;                 ///< Condiciones de categoría alerta.
+    int infoCount = 0;                  ///< Condiciones de categoría informativa.
+    int repetitions = 0;                ///< Repeticiones completadas.
+    qint64 timeUnderTension = 0;        ///< Duración sumada de las repeticiones completadas, en milisegundos.
+    int overloadCount = 0;              ///< Sobrecargas articulares en todas las líneas.
+    QHash<QString, double> lineRom;     ///< Mayor rango de movimiento (max - min) de una repetición, por línea.
+    QHash<QString, int> lineOverloads;  ///< Sobrecargas articulares por línea.
+
+    /// Media del rango de movimiento de las líneas (0 si no hay ninguna).
+    double meanRom() const {
+        if (lineRom.isEmpty()) return 0;
+        double sum = 0;
+        for (double rom : lineRom) sum += rom;
+        return sum / lineRom.size();
+    }
+
+    /// Serializa los datos por línea como objeto JSON compacto: línea → {"rom", "overloads"}.
+    nlohmann::json linesToJson() const {
+        nlohmann::json j = nlohmann::json::object();
+        for (auto it = lineRom.constBegin(); it != lineRom.constEnd(); ++it)
+            j[it.key().toStdString()]["rom"] = it.value();
+        for (auto it = lineOverloads.constBegin(); it != lineOverloads.constEnd(); ++it)
+            j[it.key().toStdString()]["overloads"] = it.value();
+        return j;
+    }
+
+    /// Clave de la semana ISO de una fecha (`2025-W07`), con la que se agrupan los acumulados semanales.
+    static QString weekKey(const QDate& date) {
+        int year = 0;
+        const int week = date.weekNumber(&year);
+        return QString("%1-W%2").arg(year).arg(week, 2, 10, QChar('0'));
+    }
+};
+
+#endif // SESIONSUMMARY_H
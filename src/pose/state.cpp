@@ -6,6 +6,8 @@
  * evaluar las condiciones detectadas según la pose capturada, y generar un reporte detallado con desviaciones y métricas.
  */
 #include "state.h"
+#include "kinematicstracker.h"
+#include <algorithm>
 #include <cmath>
 #include <opencv2/core/hal/interface.h>
 
@@ -62,11 +64,15 @@ int State::getEntryTime() const
 }
 /*!
  * \brief Establece el tiempo de entrada al estado.
+ *
+ * Entrar de nuevo en el estado empieza una fase nueva, así que se descartan las condiciones guardadas de la pose
+ * quieta.
  * \param entryTime Tiempo en milisegundos.
  */
 void State::setEntryTime(int entryTime)
 {
     this->entryTime = entryTime;
+    holdCache.clear();
 }
 
 
@@ -84,6 +90,7 @@ void State::addAngleConstraint(QString line,AngleConstraint constraint)
     constraint.setLinea(line);
     //qDebug()<<"Se ha agregado una constraint"<<line;
     constraints.insert(line, constraint);
+    holdCache.clear();
 }
 /*!
  * \brief Elimina la restricción asociada a una línea.
@@ -92,21 +99,10 @@ void State::addAngleConstraint(QString line,AngleConstraint constraint)
 void State::delAngleConstraint(QString line){
 
     constraints.remove(line);
+    holdCache.clear();
 }
 /*!
- * \brief Genera un reporte de condiciones sin actualizar acumuladores.
- * \param detectedAngles Ángulos detectados en la pose.
- * \param currentTime Tiempo actual en milisegundos.
- * \param view Vista (frontal/lateral).
- * \return Lista de condiciones detectadas.
- */
-QList<Condition> State::getReport(QHash<QString, double> detectedAngles, int currentTime, PoseView view) {
-    QHash<QString, QPair<double, double>> dummy;
-    QHash<QString, double> dummyO;
-    return getReport(detectedAngles, currentTime, view, dummy,dummyO);
-}
-/*!
- * \brief Genera un reporte detallado de condiciones, incluyendo actualización de acumuladores de rangos y sobrecargas.
+ * \brief Genera un reporte detallado de condiciones.
  *
  * Este método evalúa todas las restricciones angulares en función de:
  * - Evolución esperada del movimiento.
@@ -115,17 +111,19 @@ QList<Condition> State::getReport(QHash<QString, double> detectedAngles, int cur
  * - Estabilidad de la ejecución (variabilidad).
  * - Simetría esperada del movimiento.
  *
+ * Los rangos angulares y las sobrecargas los acumula la máquina de estados a partir de los ángulos del
+ * frame y de las condiciones JointOverload devueltas.
+ *
  * \param detectedAngles Ángulos detectados de la pose.
  * \param currentTime Tiempo actual en milisegundos.
  * \param view Vista (frontal/lateral).
- * \param rangeAccumulator Acumulador que guarda min/max global de cada línea.
- * \param overloadsAccumulator Acumulador que guarda valores de sobrecarga.
+ * \param kinematics Estimación cinemática suavizada de las líneas (puede ser nullptr). Cuando está disponible
+ * se usa para evaluar FastMovement/SlowMovement y detectar AccelerationSpikes.
  * \return Lista de condiciones detectadas en este estado.
  */
 
 QList<Condition> State::getReport(QHash<QString, double> detectedAngles, int currentTime,PoseView view,
-                                  QHash<QString, QPair<double, double>>& rangeAccumulator,
-                                  QHash<QString, double>& overloadsAccumulator)
+                                  const KinematicsTracker* kinematics)
 {
 
     QList<Condition> report={};
@@ -135,7 +133,6 @@ QList<Condition> State::getReport(QHash<QString, double> detectedAngles, int cur
     bool isOptimo=true;
     if (timeLastFrame==0) timeLastFrame=currentTime;
 
-    qDebug (stateLog)<<"ángulos detectados:"<<detectedAngles.size();
     int64_t timeDif=  currentTime-entryTime;
      if (maxTime>0 && timeDif>=maxTime){
         report.append(Condition(ConditionType::MaxStateTimeout,QString::number(id),timeDif- maxTime));
@@ -152,22 +149,30 @@ QList<Condition> State::getReport(QHash<QString, double> detectedAngles, int cur
                   <<"minTime:"<<minTime<<"dif"<<currentTime-entryTime;
      }
 
+    // Pose sin cambios relevantes: se reutilizan las condiciones de la última evaluación completa y solo
+    // se recalculan las condiciones temporales
+    auto cached = holdCache.constFind(view);
+    if (cached != holdCache.constEnd() && canReuseReport(cached.value(), detectedAngles, view, kinematics)) {
+        report.append(cached.value().conditions);
+        if (isOptimo && cached.value().optimal) report.append(Condition(ConditionType::OptimalForm,"",id, view));
+        timeLastFrame=currentTime;
+        if (detectedAngles.size()>0) previousAngles = detectedAngles;
+        return report;
+    }
+
+    qDebug (stateLog)<<"ángulos detectados:"<<detectedAngles.size();
+
+    const int timeConditions = report.size();
+    const bool timeOptimal = isOptimo;
+    isOptimo = true;
+    bool still = true;
+    QHash<QString, double> holdMargins;
 
     for (auto it = detectedAngles.constBegin(); it != detectedAngles.constEnd(); ++it) {
 
         QString lineName = it.key();
         double currentAngle = it.value();
 
-        // Actualizamos los ángulos detectados de tal forma que siempre tenemos el máximo y el mínimo
-        QPair<double, double>& range = rangeAccumulator[lineName];
-        if (range.first == 0 && range.second == 0) {
-            range.first = currentAngle;
-            range.second = currentAngle;
-        }
-        if (range.first > currentAngle) range.first = currentAngle;
-        if (range.second < currentAngle) range.second = currentAngle;
-
-
 
         for(AngleConstraint line:constraints){
 
@@ -205,29 +210,41 @@ QList<Condition> State::getReport(QHash<QString, double> detectedAngles, int cur
                 {
                     report.append(Condition(ConditionType::JointOverload,lineName ,currentAngle, view));
                     isOptimo=false;
-                    overloadsAccumulator.insert(lineName,currentAngle);
                     qDebug(stateLog)<<conditionTypeToString(ConditionType::JointOverload)<<"currentAngle:"
                              <<currentAngle<<"minSafeAngle:"<<line.getMinSafeAngle()
                              <<"toler:"<<toler<<"dif"<<dif;
                 }
 
-                //EL fastthrreshold lo tendremos en grados por segundo
-                if (line.getFastThreshold()!=-1 && (std::fabs(presviousAngle-currentAngle)/(currentTime-timeLastFrame)*1000)>line.getFastThreshold()){
-                    float vel= std::fabs(presviousAngle-currentAngle)/(currentTime-timeLastFrame)*1000;
+                //EL fastthrreshold lo tendremos en grados por segundo. Si hay estimación cinemática se usa la
+                //velocidad suavizada; si no, la diferencia entre los dos últimos frames
+                KinematicSample kin = kinematics ? kinematics->sample(view, lineName) : KinematicSample();
+                double vel = -1;
+                if (kin.valid) vel = std::fabs(kin.velocity);
+                else if (currentTime > timeLastFrame) vel = dif/(currentTime-timeLastFrame)*1000;
+
+                if (line.getFastThreshold()!=-1 && vel!=-1 && vel>line.getFastThreshold()){
                     report.append(Condition(ConditionType::FastMovement,lineName,vel-line.getFastThreshold(),view));
                     isOptimo=false;
+                    still=false;
                     qDebug(stateLog)<<conditionTypeToString(ConditionType::FastMovement)<<"currentAngle:"
                              <<currentAngle<<"presviousAngle:"<<presviousAngle
                                      <<"FastThreshold:"<<line.getFastThreshold()<<"dif"<<presviousAngle-currentAngle<<"vel"<<vel;
                 }
-                if (line.getSlowThreshold()!=-1 && (std::fabs(presviousAngle-currentAngle)/(currentTime-timeLastFrame)*1000)<line.getSlowThreshold()){
-                     float vel= std::fabs(presviousAngle-currentAngle)/(currentTime-timeLastFrame);
+                if (line.getSlowThreshold()!=-1 && vel!=-1 && vel<line.getSlowThreshold()){
                     report.append(Condition(ConditionType::SlowMovement,lineName,line.getSlowThreshold()-vel,view));
                     isOptimo=false;
                     qDebug(stateLog)<<conditionTypeToString(ConditionType::SlowMovement)<<"currentAngle:"
                              <<currentAngle<<"presviousAngle:"<<presviousAngle
                              <<"SlowThreshold:"<<line.getSlowThreshold()<<"dif"<<presviousAngle-currentAngle<<"vel"<<vel;
                 }
+                if (kin.valid && std::fabs(kin.acceleration)>ACCEL_SPIKE_THRESHOLD){
+                    report.append(Condition(ConditionType::AccelerationSpikes,lineName,std::fabs(kin.acceleration),view));
+                    isOptimo=false;
+                    still=false;
+                    qDebug(stateLog)<<conditionTypeToString(ConditionType::AccelerationSpikes)<<"currentAngle:"
+                             <<currentAngle<<"acceleration:"<<kin.acceleration
+                             <<"threshold:"<<ACCEL_SPIKE_THRESHOLD<<"jerk"<<kin.jerk;
+                }
 
                 switch(line.getEvolution()){
 
@@ -403,11 +420,34 @@ QList<Condition> State::getReport(QHash<QString, double> detectedAngles, int cur
                         break;
 
                 }
+
+                if (dif>toler) still=false;
+                holdMargins.insert(lineName, holdMargin(line, currentAngle, toler));
+        } else {
+            still=false;
         }
     }
 
     }
 
+    // Si la pose estaba quieta se guarda el resultado para reutilizarlo en los siguientes frames
+    HoldCache& cache = holdCache[view];
+    cache.valid = false;
+    if (still && !holdMargins.isEmpty()) {
+        int constrainedLines = 0;
+        for (const AngleConstraint& c : constraints) {
+            if (c.getView() == view) constrainedLines++;
+        }
+        if (holdMargins.size() == constrainedLines) {
+            cache.valid = true;
+            cache.optimal = isOptimo;
+            cache.conditions = report.mid(timeConditions);
+            cache.anchor = detectedAngles;
+            cache.margin = holdMargins;
+        }
+    }
+    isOptimo = isOptimo && timeOptimal;
+
     if (isOptimo){report.append(Condition(ConditionType::OptimalForm,"",id, view));}
 
 
@@ -416,6 +456,59 @@ QList<Condition> State::getReport(QHash<QString, double> detectedAngles, int cur
     return report;
 
 }
+/*!
+ * \brief Calcula cuánto puede variar el ángulo de una línea respecto a \p angle sin que cambie el resultado
+ * de su restricción.
+ *
+ * Es la menor distancia a cualquiera de los umbrales de la restricción (ángulos óptimos, límites seguros
+ * y rango de simetría) y, como máximo, la mitad de la tolerancia, para que la diferencia entre dos frames
+ * consecutivos dentro del margen nunca supere la tolerancia.
+ */
+double State::holdMargin(const AngleConstraint& c, double angle, double toler) const
+{
+    double margin = toler / 2;
+    auto limit = [&](double threshold) { margin = std::min(margin, std::fabs(angle - threshold)); };
+
+    if (c.getMinAngle() != -1) limit(c.getMinAngle());
+    if (c.getMaxAngle() != -1) limit(c.getMaxAngle());
+    if (c.getMaxSafeAngle() != -1) limit(c.getMaxSafeAngle() + toler);
+    if (c.getMinSafeAngle() != -1) limit(c.getMinSafeAngle() - toler);
+    if (c.getEvolution() == Direction::Symetrical) {
+        limit(c.getSymetricalAngle() + toler);
+        limit(c.getSymetricalAngle() - toler);
+    }
+    return margin;
+}
+
+/*!
+ * \brief Indica si el frame puede resolverse con las condiciones de la última evaluación completa.
+ *
+ * Requiere que todas las líneas con restricción sigan presentes, que ninguna se haya alejado del ángulo de
+ * referencia más que su margen y que la estimación cinemática no cambie el resultado de los umbrales de
+ * velocidad ni indique un pico de aceleración.
+ */
+bool State::canReuseReport(const HoldCache& cache, const QHash<QString, double>& detectedAngles,
+                           PoseView view, const KinematicsTracker* kinematics) const
+{
+    if (!cache.valid) return false;
+
+    for (auto it = cache.margin.constBegin(); it != cache.margin.constEnd(); ++it) {
+        auto angle = detectedAngles.constFind(it.key());
+        if (angle == detectedAngles.constEnd()) return false;
+        if (std::fabs(angle.value() - cache.anchor.value(it.key())) >= it.value()) return false;
+
+        if (kinematics) {
+            KinematicSample kin = kinematics->sample(view, it.key());
+            if (!kin.valid) continue;
+            if (std::fabs(kin.acceleration) > ACCEL_SPIKE_THRESHOLD) return false;
+            const AngleConstraint c = constraints.value(it.key());
+            if (c.getFastThreshold() != -1 && std::fabs(kin.velocity) > c.getFastThreshold()) return false;
+            if (c.getSlowThreshold() != -1 && std::fabs(kin.velocity) >= c.getSlowThreshold()) return false;
+        }
+    }
+    return true;
+}
+
 /*!
  * \brief Devuelve todas las restricciones angulares del estado.
  * \return QHash con las restricciones organizadas por línea.
@@ -432,6 +525,7 @@ QHash<QString, AngleConstraint> State::getConstraints() const
 void State::updateConstraint( QString key,  AngleConstraint& constraint)
 {
     constraints[key] = constraint;
+    holdCache.clear();
 }
 
 
@@ -496,6 +590,7 @@ void State::setId(int newId)
 void State::setConstraints(const QHash<QString, AngleConstraint>& newConstraints)
 {
     constraints = newConstraints;
+    holdCache.clear();
 }
 
 
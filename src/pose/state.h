@@ -10,6 +10,8 @@
 
 Q_DECLARE_LOGGING_CATEGORY(EstateLog);
 
+class KinematicsTracker;
+
 
 
 class State
@@ -29,16 +31,10 @@ public:
     void addAngleConstraint(QString line,AngleConstraint constraint);
     void delAngleConstraint(QString line);
 
-    QList<Condition> getReport(QHash<QString,
-                               double> detectedAngles,
-                               int currentTime,
-                               PoseView view=PoseView::Front);
-
     QList<Condition> getReport(QHash<QString, double> detectedAngles,
                                int currentTime,
-                               PoseView view,
-                               QHash<QString, QPair<double, double>>& rangeAccumulator,
-                               QHash<QString, double>& overloadsAccumulator);
+                               PoseView view=PoseView::Front,
+                               const KinematicsTracker* kinematics = nullptr);
 
 
 
@@ -59,7 +55,14 @@ public:
     QString getName() const;
     void setName(const QString &newName);
 
+    /// Aceleración angular (grados/s²) por encima de la cual una línea emite AccelerationSpikes. Equivale a ganar
+    /// o perder 100 grados/s en un frame de 33 ms (30 fps), muy por encima de un movimiento controlado; es común
+    /// a todos los estados porque la especificación del ejercicio no la define.
+    static constexpr double ACCEL_SPIKE_THRESHOLD = 3000;
+
 private:
+    friend class TestState;
+
     int id;
     int idEx;
     QString name="none";
@@ -68,6 +71,19 @@ private:
     int maxTime, minTime,entryTime;
     QHash<QString, double> previousAngles;
     QHash<QString, AngleConstraint> constraints;
+
+    /// Resultado de la última evaluación completa de una vista, reutilizable mientras la pose no cambie.
+    struct HoldCache {
+        bool valid = false;
+        bool optimal = true;
+        QList<Condition> conditions;      // condiciones no temporales
+        QHash<QString, double> anchor;    // ángulos con los que se evaluó
+        QHash<QString, double> margin;    // variación admisible por línea
+    };
+    QHash<PoseView, HoldCache> holdCache;
+    double holdMargin(const AngleConstraint& c, double angle, double toler) const;
+    bool canReuseReport(const HoldCache& cache, const QHash<QString, double>& detectedAngles,
+                        PoseView view, const KinematicsTracker* kinematics) const;
     double getAngle(QString line) const;
     bool isWithinToler(QString line) const;
 
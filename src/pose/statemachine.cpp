@@ -47,6 +47,119 @@ StateMachine::StateMachine(QSharedPointer<ExerciseEspec> espec)
     initSetTime=0,
     initRepTime=0;
     initStateTime=0;
+
+    compileRomTargets();
+
+    //El acumulador de rangos y sobrecargas se preasigna con las dimensiones del ejercicio y se escribe
+    //directamente en el reporte
+    QList<int> stateIds;
+    for (const State& s : states) {
+        stateIds.append(s.getId());
+        for (const AngleConstraint& c : s.getConstraints()) {
+            if (!lines.contains(c.getLinea())) lines.append(c.getLinea());
+        }
+    }
+    report.setAngleAccumulator(AngleAccumulator(series, repetitions, stateIds, lines));
+}
+
+/*!
+ * \brief Calcula, a partir de las restricciones de todos los estados, el rango de movimiento que debe
+ * recorrer cada línea en una repetición.
+ *
+ * Las fases de subida (Increase) fijan el ángulo alto a alcanzar (maxAngle, o minAngle si no hay máximo),
+ * las de bajada (Decrease) el ángulo bajo (minAngle, o maxAngle) y las simétricas con ambos límites
+ * aportan los dos extremos. La tolerancia es la mayor de las restricciones implicadas.
+ */
+void StateMachine::compileRomTargets()
+{
+    romTargets.clear();
+    for (const State& s : states) {
+        const QHash<QString, AngleConstraint> constraints = s.getConstraints();
+        for (const AngleConstraint& c : constraints) {
+            double min = c.getMinAngle();
+            double max = c.getMaxAngle();
+            double low = -1, high = -1;
+
+            switch (c.getEvolution()) {
+            case Direction::Increase:
+                high = (max != -1) ? max : min;
+                break;
+            case Direction::Decrease:
+                low = (min != -1) ? min : max;
+                break;
+            case Direction::Symetrical:
+                if (min != -1 && max != -1) { low = min; high = max; }
+                break;
+            default:
+                break;
+            }
+            if (low == -1 && high == -1) continue;
+
+            RomTarget& target = romTargets[c.getView()][c.getLinea()];
+            if (low != -1 && (target.low == -1 || low < target.low)) target.low = low;
+            if (high != -1 && (target.high == -1 || high > target.high)) target.high = high;
+            if (c.getToler() != -1 && c.getToler() > target.toler) target.toler = c.getToler();
+        }
+    }
+    qDebug(StateMachineLog) << "Objetivos de rango de movimiento compilados para" << romTargets.size() << "vistas";
+}
+
+/*!
+ * \brief Incorpora los ángulos del frame a los estadísticos de la repetición en curso.
+ */
+void StateMachine::accumulateRepStats(const QHash<PoseView, QHash<QString, double>>& anglesByView)
+{
+    for (auto itView = anglesByView.constBegin(); itView != anglesByView.constEnd(); ++itView) {
+        QHash<QString, LineStats>& stats = repStats[itView.key()];
+        for (auto itLine = itView.value().constBegin(); itLine != itView.value().constEnd(); ++itLine)
+            stats[itLine.key()].add(itLine.value());
+    }
+}
+
+/*!
+ * \brief Cierra los estadísticos de la repetición que acaba de terminar.
+ *
+ * Compara el rango recorrido por cada línea con su objetivo y emite RangeOfMotionDeficit cuando la suma
+ * de lo que falta en ambos extremos supera la tolerancia. Si la serie tiene duración, emite
+ * ExerciseOvertime cuando la repetición excede la parte proporcional que le corresponde. Por último
+ * guarda los estadísticos en el reporte.
+ *
+ * \param repTime Duración de la repetición en milisegundos.
+ * \param currentReport Lista de condiciones del frame a la que se añaden las nuevas.
+ */
+void StateMachine::closeRepetition(int64_t repTime, QList<Condition>& currentReport)
+{
+    for (auto itView = romTargets.constBegin(); itView != romTargets.constEnd(); ++itView) {
+        const QHash<QString, LineStats> stats = repStats.value(itView.key());
+        for (auto itLine = itView.value().constBegin(); itLine != itView.value().constEnd(); ++itLine) {
+            LineStats s = stats.value(itLine.key());
+            if (s.isEmpty()) continue;
+
+            const RomTarget& target = itLine.value();
+            double deficit = 0;
+            if (target.low != -1 && s.min > target.low) deficit += s.min - target.low;
+            if (target.high != -1 && s.max < target.high) deficit += target.high - s.max;
+
+            if (deficit > target.toler) {
+                currentReport.append(Condition(ConditionType::RangeOfMotionDeficit, itLine.key(), deficit, itView.key()));
+                qDebug(StateMachineLog) << conditionTypeToString(ConditionType::RangeOfMotionDeficit)
+                                        << "línea:" << itLine.key() << "min:" << s.min << "max:" << s.max
+                                        << "objetivo:" << target.low << target.high << "déficit:" << deficit;
+            }
+        }
+    }
+
+    if (duration > 0 && repetitions > 0) {
+        int64_t repLimit = duration / repetitions;
+        if (repTime > repLimit) {
+            currentReport.append(Condition(ConditionType::ExerciseOvertime, QString::number(currentRep), repTime - repLimit));
+            qDebug(StateMachineLog) << conditionTypeToString(ConditionType::ExerciseOvertime)
+                                    << "repetición:" << currentRep << "tiempo:" << repTime << "límite:" << repLimit;
+        }
+    }
+
+    report.setRepetitionStats(currentSet, currentRep, repStats);
+    repStats.clear();
 }
 
 
@@ -82,6 +195,8 @@ QList<Condition> StateMachine::run(QHash<PoseView, QHash<QString, double>> angle
             resting = false;
              currentReport.append(Condition(ConditionType::RestTime,"",restTime));
              hasEmittedRestTime = true;
+             //las ventanas del filtro no deben mezclar frames anteriores al descanso
+             kinematics.reset();
 
         } else {
             return currentReport;
@@ -89,14 +204,22 @@ QList<Condition> StateMachine::run(QHash<PoseView, QHash<QString, double>> angle
     }
      int currentId = currentState.getId();
 
-    // QHash<QString, QPair<double, double>> MinMaxByLine=globalMinMaxByLine[currentSet][currentRep][currentId];
-    // QHash<QString, double>>>>
-    for (PoseView view : anglesByView.keys()) {
-        QList<Condition> partial = currentState.getReport(anglesByView[view],
-                                                          time,
-                                                          view,
-                                                          globalMinMaxByLine[currentSet][currentRep][currentId][view],
-                                                          globalAngleOverloads[currentSet][currentRep][currentId][view]);
+    for (auto it = anglesByView.constBegin(); it != anglesByView.constEnd(); ++it)
+        kinematics.update(it.key(), it.value(), time);
+    accumulateRepStats(anglesByView);
+
+    AngleAccumulator& angleData = report.angleAccumulator();
+    AngleSeriesRecorder* angleSeries = report.angleSeries().data();
+    for (auto it = anglesByView.constBegin(); it != anglesByView.constEnd(); ++it) {
+        PoseView view = it.key();
+        QList<Condition> partial = currentState.getReport(it.value(), time, view, &kinematics);
+
+        angleData.addAngles(currentSet, currentRep, currentId, view, it.value());
+        angleSeries->record(view, currentSet, currentRep, time, it.value());
+        for (const Condition& c : partial) {
+            if (c.type == ConditionType::JointOverload)
+                angleData.setOverload(currentSet, currentRep, currentId, view, c.keypointLine, c.value.toDouble());
+        }
         currentReport.append(partial);
     }
 
@@ -186,6 +309,7 @@ QList<Condition> StateMachine::run(QHash<PoseView, QHash<QString, double>> angle
                 repCount++;
                 currentReport.append(Condition(ConditionType::EndOfRepetition,QString::number(repCount),time-initRepTime ));
                 qDebug(StateMachineLog) << "Repetición completada. Reps restantes:" << repetitions;
+                if (initRepTime > 0) closeRepetition(time-initRepTime, currentReport);
                 initRepTime=0;
                 //Serie completada
                 if (repCount > repetitions) {
@@ -242,6 +366,9 @@ QList<Condition> StateMachine::run(QHash<PoseView, QHash<QString, double>> angle
                 //initTime=time;
                 initRepTime=time;
                 initRestTime=0;
+                //los estadísticos de la repetición empiezan con el frame actual
+                repStats.clear();
+                accumulateRepStats(anglesByView);
             }
 
             // Si estamos en estado 1 y estábamos en descanso, salimos del modo resting
@@ -294,7 +421,7 @@ QList<Condition> StateMachine::run(QHash<PoseView, QHash<QString, double>> angle
     // Añadir al reporte acumulado
      qDebug(StateMachineLog) <<"==Report==";
     for (const Condition &cond : currentReport) {
-        report.addCondition(currentSet, currentRep, currentId,cond);
+        report.addCondition(currentSet, currentRep, currentId, cond, time);
         qDebug(StateMachineLog) << "Serie" << setCount
                                 << "Reps" << repCount
                                 << "View:" << PoseViewToString(cond.view)
@@ -328,13 +455,16 @@ bool StateMachine::isComplete()
  *
  * \return Reporte completo de la sesión.
  */
-SesionReport StateMachine::getReport()
+const SesionReport& StateMachine::getReport() const
 {
-    report.setLineAngleRange(globalMinMaxByLine);
-    report.setGlobalAngleOverloads(globalAngleOverloads);
     return report;
 }
 
+QStringList StateMachine::getLines() const
+{
+    return lines;
+}
+
 void StateMachine::newSerie() {
     setCount++;
     repCount = 1;
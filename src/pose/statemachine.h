@@ -16,6 +16,8 @@
 #include <QSharedPointer>
 #include <QDateTime>
 #include "state.h"
+#include "kinematicstracker.h"
+#include "linestats.h"
 #include "feedback.h"
 #include "workouts/exerciseespec.h"
 //#include "workouts/exercise.h"
@@ -62,9 +64,15 @@ public:
 
     /*!
      * \brief Devuelve el reporte completo de condiciones y métricas generadas durante la sesión.
-     * \return Objeto `SesionReport` con información detallada.
+     * \return Referencia al `SesionReport` de la máquina; es válida mientras exista la máquina de estados.
      */
-    SesionReport getReport();
+    const SesionReport& getReport() const;
+
+    /*!
+     * \brief Devuelve las líneas de keypoints que aparecen en las restricciones del ejercicio.
+     * \return Líneas en el orden en que aparecen en los estados.
+     */
+    QStringList getLines() const;
     /**
      * @brief Interrumpe la serie actual de forma manual y fuerza el inicio de una nueva serie.
      *
@@ -106,9 +114,22 @@ private:
     State initState;
     //QList<Condition>currentReport;
     QList<State> states;
+    QStringList lines;
     QHash<QPair<int,int>,QSet<Condition>> transitionTable;
-    QMap<int,QMap<int,QMap<int,QHash<PoseView,QHash<QString, QPair<double, double>>>>>> globalMinMaxByLine;
-    QMap<int,QMap<int,QMap<int,QHash<PoseView,QHash<QString, double>>>>> globalAngleOverloads;
+    KinematicsTracker kinematics;
+
+    /// Rango de movimiento objetivo de una línea: ángulo más bajo y más alto a alcanzar (-1 si no se define).
+    struct RomTarget {
+        double low = -1;
+        double high = -1;
+        double toler = 0;
+    };
+    QHash<PoseView, QHash<QString, RomTarget>> romTargets;
+    QHash<PoseView, QHash<QString, LineStats>> repStats;
+
+    void compileRomTargets();
+    void accumulateRepStats(const QHash<PoseView, QHash<QString, double>>& anglesByView);
+    void closeRepetition(int64_t repTime, QList<Condition>& currentReport);
 
 
 
@@ -6,9 +6,11 @@
  * incluyendo especificaciones de ejercicios, workouts completos, sesiones realizadas y sus reportes asociados.
  */
 #include "trainingrepository.h"
+#include "db/dbtransaction.h"
 #include "enums/ExEspecFieldEnum.h"
 #include "enums/WorkoutFieldEnum.h"
 #include <QString>
+#include <limits>
 
 
 
@@ -32,76 +34,120 @@ TrainingRepository::TrainingRepository(DBManager* dbManager, QObject* parent)
 QSharedPointer<ExerciseEspec> TrainingRepository::getEspec(int id) {
 
     if (id < 0) return nullptr;
+    return getEspecs({id}).value(id);
+}
 
-    QString idstr = QString::number(id);
-    DBTable table = dbManager->get(TypeBDEnum::ExerciseEspec, DBFilter::IdEx, idstr);
-    if (table.rowCount() == 0) {
+/*!
+ * \brief Carga varias especificaciones de ejercicio con una consulta por tabla.
+ *
+ * Se leen de una vez las filas de `exercise_espec`, `state`, `angle_constraint` y `transition` de todos los
+ * ejercicios pedidos (`WHERE idEx IN (...)`) y los objetos se montan en memoria, en lugar de hacer una consulta
+ * por ejercicio y por estado.
+ * \param ids Identificadores de los ejercicios.
+ * \return Especificaciones encontradas, indexadas por su ID. Los IDs que no existen no aparecen.
+ */
+QHash<int, QSharedPointer<ExerciseEspec>> TrainingRepository::getEspecs(const QList<int>& ids) {
+
+    QHash<int, QSharedPointer<ExerciseEspec>> especs;
+
+    QStringList idStrs;
+    for (int id : ids) {
+        QString idstr = QString::number(id);
+        if (id >= 0 && !idStrs.contains(idstr)) idStrs << idstr;
+    }
+    if (idStrs.isEmpty()) return especs;
+
+    DBTable table = dbManager->get(TypeBDEnum::ExerciseEspec, DBFilter::IdEx, idStrs);
+    for (int row = 0; row < table.rowCount(); ++row) {
+        QHash<ExEspecField, QVariant> data;
+        for (int col = 0; col < table.columnCount(); ++col) {
+            QString colName = table.getColumnName(col);
+            ExEspecField field = ExEspecFieldFromString(colName);
+            if (field != ExEspecField::Unknown) data[field] = table.value(row, colName);
+        }
+
+        int id = table.value(row, "idEx").toInt();
+        QSharedPointer<ExerciseEspec> espec(new ExerciseEspec(data));
+        espec->setIdEx(id);
+        especs.insert(id, espec);
+    }
+
+    for (const QString& idstr : idStrs) {
+        if (especs.contains(idstr.toInt())) continue;
         QString error=QString("No existe ese ejercicio con id : %1 en la base de datos").arg(idstr);
         qWarning(TrainingRepo) << error;
         emit ui_errorMessage(error,QtMsgType::QtWarningMsg);
-        return nullptr;}
-
-    QHash<ExEspecField, QVariant> data;
-    for (int col = 0; col < table.columnCount(); ++col) {
-        QString colName = table.getColumnName(col);
-        ExEspecField field = ExEspecFieldFromString(colName);
-        if (field != ExEspecField::Unknown) data[field] = table.value(0, colName);
     }
+    if (especs.isEmpty()) return especs;
 
-    QSharedPointer<ExerciseEspec> espec(new ExerciseEspec(data));
-    espec->setIdEx(id);
-
-    // Cargar states
-    DBTable statesTable = dbManager->get(TypeBDEnum::State, {{DBFilter::IdEx, id}});
+    // Cargar states de todos los ejercicios, conservando el orden en que llegan por ejercicio
+    QHash<int, QList<State>> states;
+    QHash<QPair<int, int>, int> statePos; // (idEx, idState) -> posición en states[idEx]
+    DBTable statesTable = dbManager->get(TypeBDEnum::State, DBFilter::IdEx, idStrs);
     for (int row = 0; row < statesTable.rowCount(); ++row) {
+        int idEx = statesTable.value(row, "idEx").toInt();
+        if (!especs.contains(idEx)) continue;
+
         int idState = statesTable.value(row, "idState").toInt();
         int minT = statesTable.value(row, "minTime").toInt();
         int maxT = statesTable.value(row, "maxTime").toInt();
-        int order = statesTable.value(row, "orderInList").toInt();
         QString name=statesTable.value(row, "name").toString();
-        State state(idState, id, minT, maxT,name);
-
-        // Cargar constraints para ese state
-        DBTable acTable = dbManager->get(TypeBDEnum::AngleConstraint, {{DBFilter::IdState, idState}, {DBFilter::IdEx, id}});
-        for (int j = 0; j < acTable.rowCount(); ++j) {
-            QString line = acTable.value(j, "line").toString();
-            AngleConstraint c(
-                acTable.value(j, "idConstraint").toInt(),
-                idState,
-                id,
-                acTable.value(j, "minAngle").toDouble(),
-                acTable.value(j, "maxAngle").toDouble(),
-                acTable.value(j, "maxSafeAngle").toDouble(),
-                acTable.value(j, "minSafeAngle").toDouble(),
-                acTable.value(j, "fastThreshold").toInt(),
-                acTable.value(j, "slowThreshold").toInt(),
-                acTable.value(j, "symetricalAngle").toDouble(),
-                directionFromString(acTable.value(j, "evolution").toString()),
-                acTable.value(j, "toler").toDouble(),
-                line,
-                PoseViewFromString(acTable.value(j,"view").toString())
-                );
-            //c.setLinea(line);
-            state.addAngleConstraint(line, c);
-            //qDebug(TrainingRepo)<<"Obtenida line: "<<line<<"para el estado:"<<idState;
-        }
-        espec->addState(state);
-        qDebug(TrainingRepo)<<"Se ha creado un nuevo estado para el ejercicio: "<<id;
+
+        QList<State>& list = states[idEx];
+        statePos.insert(qMakePair(idEx, idState), list.size());
+        list.append(State(idState, idEx, minT, maxT, name));
+    }
+
+    // Cargar constraints y asignarlas a su estado
+    DBTable acTable = dbManager->get(TypeBDEnum::AngleConstraint, DBFilter::IdEx, idStrs);
+    for (int j = 0; j < acTable.rowCount(); ++j) {
+        int idEx = acTable.value(j, "idEx").toInt();
+        int idState = acTable.value(j, "idState").toInt();
+        auto pos = statePos.constFind(qMakePair(idEx, idState));
+        if (pos == statePos.constEnd()) continue;
+
+        QString line = acTable.value(j, "line").toString();
+        AngleConstraint c(
+            acTable.value(j, "idConstraint").toInt(),
+            idState,
+            idEx,
+            acTable.value(j, "minAngle").toDouble(),
+            acTable.value(j, "maxAngle").toDouble(),
+            acTable.value(j, "maxSafeAngle").toDouble(),
+            acTable.value(j, "minSafeAngle").toDouble(),
+            acTable.value(j, "fastThreshold").toInt(),
+            acTable.value(j, "slowThreshold").toInt(),
+            acTable.value(j, "symetricalAngle").toDouble(),
+            directionFromString(acTable.value(j, "evolution").toString()),
+            acTable.value(j, "toler").toDouble(),
+            line,
+            PoseViewFromString(acTable.value(j,"view").toString())
+            );
+        states[idEx][pos.value()].addAngleConstraint(line, c);
+    }
+
+    for (auto it = states.constBegin(); it != states.constEnd(); ++it) {
+        QSharedPointer<ExerciseEspec>& espec = especs[it.key()];
+        for (const State& state : it.value()) espec->addState(state);
+        qDebug(TrainingRepo)<<"Cargados"<<it.value().size()<<"estados para el ejercicio: "<<it.key();
     }
 
     // Cargar transiciones
-    DBTable transitions = dbManager->get(TypeBDEnum::Transition, {{DBFilter::IdEx, id}});
+    DBTable transitions = dbManager->get(TypeBDEnum::Transition, DBFilter::IdEx, idStrs);
     for (int row = 0; row < transitions.rowCount(); ++row) {
+        auto espec = especs.constFind(transitions.value(row, "idEx").toInt());
+        if (espec == especs.constEnd()) continue;
+
         int from = transitions.value(row, "fromState").toInt();
         int to = transitions.value(row, "toState").toInt();
         QString type = transitions.value(row, "conditionType").toString();
         QString line = transitions.value(row, "keypointLine").toString();
         PoseView   view=PoseViewFromString(transitions.value(row, "view").toString());
         Condition cond(conditionTypeFromString(type), line,0,view);
-        espec->addTransition(qMakePair(from, to), cond);
+        espec.value()->addTransition(qMakePair(from, to), cond);
     }
 
-    return espec;
+    return especs;
 }
 
 
@@ -154,8 +200,14 @@ QSharedPointer<TrainingWorkout> TrainingRepository::getWorkout(int idWorkout) {
     }
 
     std::sort(exerciseOrder.begin(), exerciseOrder.end(), compareByOrder);
+
+    // Todos los ejercicios del workout se cargan en un único lote
+    QList<int> ids;
+    for (const auto& pair : exerciseOrder) ids.append(pair.second);
+    QHash<int, QSharedPointer<ExerciseEspec>> especs = getEspecs(ids);
+
     for (const auto& pair : exerciseOrder) {
-        QSharedPointer<ExerciseEspec> espec = getEspec(pair.second);
+        QSharedPointer<ExerciseEspec> espec = especs.value(pair.second);
         if (espec) {
             workout->addExercise(espec, pair.first);
         }
@@ -171,6 +223,7 @@ QSharedPointer<TrainingWorkout> TrainingRepository::getWorkout(int idWorkout) {
 
 bool TrainingRepository::deleteWorkoutfull(int idWorkout) {
     QString strId = QString::number(idWorkout);
+    DBTransaction tx(dbManager);
 
     // Obtener ids de ejercicios del workout
     DBTable rel = dbManager->get(TypeBDEnum::WorkoutExercises, DBFilter::IdWorkout, strId);
@@ -194,7 +247,9 @@ bool TrainingRepository::deleteWorkoutfull(int idWorkout) {
     if (!dbManager->deleteRow(TypeBDEnum::WorkoutExercises, DBFilter::IdWorkout, strId))
         return false;
 
-    return dbManager->deleteRow(TypeBDEnum::TrainingWorkout, DBFilter::IdWorkout, strId);
+    if (!dbManager->deleteRow(TypeBDEnum::TrainingWorkout, DBFilter::IdWorkout, strId))
+        return false;
+    return tx.commit();
 }
 
 /*!
@@ -208,6 +263,9 @@ int TrainingRepository::saveEspec(QSharedPointer<ExerciseEspec> espec)
     if (espec == nullptr) return -1;
     int idEx = espec->getIdEx();
 
+    // El borrado previo y todas las tablas del ejercicio se escriben en una única transacción
+    DBTransaction tx(dbManager);
+
     // Si ya existe, eliminar completamente
     if (idEx != -1) {
         if (!deleteEspec(idEx)) return -1;
@@ -231,7 +289,7 @@ int TrainingRepository::saveEspec(QSharedPointer<ExerciseEspec> espec)
     // Guardar estados
     const QList<State> stateList = espec->getStatesList();
     DBTable stateTable("State");
-    stateTable.setColumns(dbManager->get(TypeBDEnum::State).getColumnsNames());
+    stateTable.setColumns(dbManager->tableSchema(TypeBDEnum::State).getColumnsNames());
 
     for (int i = 0; i < stateList.size(); ++i) {
         State s = stateList[i];
@@ -256,7 +314,7 @@ int TrainingRepository::saveEspec(QSharedPointer<ExerciseEspec> espec)
     }
     // Guardar constraints
     DBTable acTable("AngleConstraint");
-    acTable.setColumns(dbManager->get(TypeBDEnum::AngleConstraint).getColumnsNames());
+    acTable.setColumns(dbManager->tableSchema(TypeBDEnum::AngleConstraint).getColumnsNames());
 
     for (const State& s : espec->getStatesList()) {
         for (const QString& line : s.getConstraints().keys()) {
@@ -294,7 +352,7 @@ int TrainingRepository::saveEspec(QSharedPointer<ExerciseEspec> espec)
     }
     // Guardar transiciones
     DBTable trTable("Transition");
-    trTable.setColumns(dbManager->get(TypeBDEnum::Transition).getColumnsNames());
+    trTable.setColumns(dbManager->tableSchema(TypeBDEnum::Transition).getColumnsNames());
 
     auto transitions = espec->getTransitionTable();
     qDebug(TrainingRepo) << "transitions en ejercicio: "<<transitions.size();
@@ -327,6 +385,12 @@ int TrainingRepository::saveEspec(QSharedPointer<ExerciseEspec> espec)
     }
     //qDebug(TrainingRepo)<<"Tabla generada: Transitions";
     //trTable.print();
+    if (!tx.commit()) {
+        QString error=QString("error guardando el ejercicio con id : %1 en la base de datos").arg(idEx);
+        qWarning(TrainingRepo) << error;
+        emit ui_errorMessage(error,QtMsgType::QtWarningMsg);
+        return -1;
+    }
     return idEx;
 }
 
@@ -339,6 +403,7 @@ int TrainingRepository::saveEspec(QSharedPointer<ExerciseEspec> espec)
 bool TrainingRepository::deleteEspec(int idEx)
 {
     QString idStr = QString::number(idEx);
+    DBTransaction tx(dbManager);
 
     // Obtener todos los estados asociados al ejercicio
     DBTable stateTable = dbManager->get(TypeBDEnum::State, DBFilter::IdEx, idStr);
@@ -382,7 +447,7 @@ bool TrainingRepository::deleteEspec(int idEx)
         return false;
     }
 
-    return true;
+    return tx.commit();
 }
 
 /*!
@@ -400,6 +465,7 @@ int TrainingRepository::saveWorkout(QSharedPointer<TrainingWorkout> workout) {
     }
 
     int idWorkout = workout->getIdWorkout();
+    DBTransaction tx(dbManager);
 
     if (idWorkout != -1) {
         // Si ya existe, eliminamos completamente el workout anterior
@@ -437,7 +503,7 @@ int TrainingRepository::saveWorkout(QSharedPointer<TrainingWorkout> workout) {
     QList<QSharedPointer<ExerciseEspec>> exs=workout->getExercises();
     if (exs.isEmpty()){
          qWarning(TrainingRepo) << "saveWorkout:Se grabó un workout sin ejercicios, id:"<<idWorkout;
-        return idWorkout;
+        return tx.commit() ? idWorkout : -1;
     }
     for (const QSharedPointer<ExerciseEspec>& espec : exs) {
          // Guardamos  o reemplazamos la especificación del ejercicio
@@ -467,6 +533,12 @@ int TrainingRepository::saveWorkout(QSharedPointer<TrainingWorkout> workout) {
         qWarning(TrainingRepo) << error;
         emit ui_errorMessage(error,QtMsgType::QtWarningMsg);
         return -1;
+    }
+    if (!tx.commit()) {
+        QString error=QString("error guardando el workout con id : %1 en la base de datos").arg(idWorkout);
+        qWarning(TrainingRepo) << error;
+        emit ui_errorMessage(error,QtMsgType::QtWarningMsg);
+        return -1;
     }
      qDebug(TrainingRepo) << "saveWorkout:Guardado Workout con id"<< idWorkout;
     return idWorkout;
@@ -478,6 +550,30 @@ int TrainingRepository::saveWorkout(QSharedPointer<TrainingWorkout> workout) {
  * \return true si se guardó con éxito.
  */
 bool TrainingRepository::SaveTrainingSesion(QSharedPointer<TrainingSesion> sesion)
+{
+    DBWriteBatch batch;
+    if (!buildSesionBatch(sesion, batch)) return false;
+
+    // Sesión, resumen y reporte se confirman juntos
+    if (!dbManager->writeBatch(batch)) {
+        QString error=QString("error guardando la sesión de entrenamiento en la base de datos");
+        qWarning(TrainingRepo) << error;
+        emit ui_errorMessage(error,QtMsgType::QtWarningMsg);
+        return false;
+    }
+    return true;
+}
+
+/*!
+ * \brief Convierte una sesión en el lote de filas de `TrainingSesion`, `ExerciseSummary`, `SesionReport` y `SesionSummary`.
+ *
+ * El ID de la sesión se asigna aquí, de modo que el lote ya contiene todas sus claves y puede guardarse más
+ * tarde, en otro hilo o varias veces, con el mismo resultado.
+ * \param sesion Objeto completo de sesión; recibe el ID asignado.
+ * \param batch Lote a completar.
+ * \return false si la sesión no es válida o no se pudo asignar un ID.
+ */
+bool TrainingRepository::buildSesionBatch(QSharedPointer<TrainingSesion> sesion, DBWriteBatch& batch)
 {
     if (sesion == nullptr || sesion->getExerciseSummary() == nullptr) {
         QString error=QString("Sesión o resumen nulos.");
@@ -486,47 +582,30 @@ bool TrainingRepository::SaveTrainingSesion(QSharedPointer<TrainingSesion> sesio
         return false;
     }
 
-    // Guardamos la sesión principal
-    DBTable sessionTable("TrainingSesion");
-    DBTable t=dbManager->get(TypeBDEnum::TrainingSesion);
-    sessionTable.setColumns(t.getColumnsNames());
     int idSesion = dbManager->generateID(TypeBDEnum::TrainingSesion);
+    if (idSesion < 0) {
+        QString error=QString("No se pudo asignar un identificador a la sesión de entrenamiento");
+        qWarning(TrainingRepo) << error;
+        emit ui_errorMessage(error,QtMsgType::QtWarningMsg);
+        return false;
+    }
     sesion->setIdSesion(idSesion);
 
-
-    //sessionTable.setColumns({"idSesion", "idClient", "idExercise", "date", "duration"});
+    // Sesión principal
+    DBTable sessionTable = dbManager->tableSchema(TypeBDEnum::TrainingSesion);
     sessionTable.addRow({
-
-        //QString::number(sesion->getIdSesion()),
         idSesion,
         sesion->getIdClient(),
         sesion->getIdWorkout(),
         sesion->getExerciseSummary()->getIdEx(),
         sesion->getDate().toString(Qt::ISODate),
         sesion->getDuration()
-
     });
 
-    if (!dbManager->save(TypeBDEnum::TrainingSesion, sessionTable)) {
-        QString error=QString("error guardando la sesión de entrenamiento en la base de datos");
-        qWarning(TrainingRepo) << error;
-        emit ui_errorMessage(error,QtMsgType::QtWarningMsg);
-        return false;
-    }
-
-    // Guardamos  el ExerciseSummary asociado
-
-    DBTable summaryTable("ExerciseSummary");
-
-    DBTable s=dbManager->get(TypeBDEnum::ExerciseSummary);
-
-    summaryTable.setColumns(s.getColumnsNames());
-
-   // summaryTable.setColumns({"idExercise", "name", "descricion","type", "targetMuscle"});
+    // ExerciseSummary asociado
     QSharedPointer<ExerciseSummary>summary = sesion->getExerciseSummary();
-
+    DBTable summaryTable = dbManager->tableSchema(TypeBDEnum::ExerciseSummary);
     summaryTable.addRow({
-
         summary->getIdEx(),
         summary->getIdWorkout(),
         summary->getName(),
@@ -538,50 +617,46 @@ bool TrainingRepository::SaveTrainingSesion(QSharedPointer<TrainingSesion> sesio
         summary->getDuration(),
         summary->getWeightPercentage(),
         summary->getRestTime()
-
     });
 
-    if (!dbManager->save(TypeBDEnum::ExerciseSummary, summaryTable)) {
-
-        QString error=QString("error guardando el resumen del ejercicio en la base de datos");
-        qWarning(TrainingRepo) << error;
-        emit ui_errorMessage(error,QtMsgType::QtWarningMsg);
-        return false;
-    }
-
-
-    SesionReport report = sesion->getReport();
-
-    nlohmann::json seriesJson = report.toSeriesJson();
-    nlohmann::json globalJson = report.toGlobalAnglesJson();
-    nlohmann::json overloadsJson = report.toGlobalOverloadsJson();
-
-    QString seriesStr = QString::fromStdString(seriesJson.dump());
-    QString globalStr = QString::fromStdString(globalJson.dump());
-    QString overloadsStr = QString::fromStdString(overloadsJson.dump());
-    //globalOverloadsJson
-    QString logText = report.getLog();
-
-    DBTable reportTable("SesionReport");
-    DBTable base = dbManager->get(TypeBDEnum::SesionReport);
-    reportTable.setColumns(base.getColumnsNames());
-
-    reportTable.addRow({
-        idSesion,
-        seriesStr,
-        globalStr,
-        overloadsStr,
-        logText
-    });
-    QString idStr = QString::number(idSesion);
-    if (!dbManager->save(TypeBDEnum::SesionReport, reportTable)) {
-    //if (!dbManager->save( TypeBDEnum::SesionReport,reportTable,DBFilter::IdSesion,idStr))
-        QString error = QString("error guardando el reporte de sesión de entrenamiento en la base de datos");
-        qWarning(TrainingRepo) << error;
-        emit ui_errorMessage(error, QtMsgType::QtWarningMsg);
-        return false;
-    }
-
+    // El reporte se guarda en un único bloque binario; las columnas JSON y de texto se mantienen vacías
+    // y solo se leen para sesiones guardadas con versiones anteriores. Las filas se rellenan por nombre de
+    // columna, que no depende del orden en que las migraciones las añadieron.
+    DBTable reportTable = dbManager->tableSchema(TypeBDEnum::SesionReport);
+    reportTable.addRow({});
+    reportTable.setValue(0, "idSesion", idSesion);
+    reportTable.setValue(0, "reportBlob", sesion->getReport().toBinary());
+
+    // Resumen para las tendencias de progreso; los acumulados diarios y semanales los recalcula la base de datos
+    // al insertar esta fila, dentro de la misma transacción
+    const SesionSummary trend = sesion->getReport().summarize();
+    const QDate day = sesion->getDate().date();
+    DBTable trendTable = dbManager->tableSchema(TypeBDEnum::SesionSummary);
+    trendTable.addRow({});
+    trendTable.setValue(0, "idSesion", idSesion);
+    trendTable.setValue(0, "idClient", sesion->getIdClient());
+    trendTable.setValue(0, "idWorkout", sesion->getIdWorkout());
+    trendTable.setValue(0, "idEx", summary->getIdEx());
+    trendTable.setValue(0, "date", sesion->getDate().toString(Qt::ISODate));
+    trendTable.setValue(0, "day", day.toString(Qt::ISODate));
+    trendTable.setValue(0, "week", SesionSummary::weekKey(day));
+    trendTable.setValue(0, "duration", sesion->getDuration());
+    trendTable.setValue(0, "repetitions", trend.repetitions);
+    trendTable.setValue(0, "timeUnderTension", trend.timeUnderTension);
+    trendTable.setValue(0, "criticalCount", trend.criticalCount);
+    trendTable.setValue(0, "alertCount", trend.alertCount);
+    trendTable.setValue(0, "infoCount", trend.infoCount);
+    trendTable.setValue(0, "overloadCount", trend.overloadCount);
+    trendTable.setValue(0, "romMean", trend.meanRom());
+    trendTable.setValue(0, "lineStats", QString::fromStdString(trend.linesToJson().dump()));
+
+    batch.description = QString("sesión %1").arg(idSesion);
+    batch.tables = {
+        qMakePair(TypeBDEnum::TrainingSesion, sessionTable),
+        qMakePair(TypeBDEnum::ExerciseSummary, summaryTable),
+        qMakePair(TypeBDEnum::SesionReport, reportTable),
+        qMakePair(TypeBDEnum::SesionSummary, trendTable)
+    };
     return true;
 }
 /*!
@@ -645,16 +720,27 @@ QSharedPointer<TrainingSesion> TrainingRepository::getTrainingSesion(int idSesio
     DBTable reportTable = dbManager->get(TypeBDEnum::SesionReport, DBFilter::IdSesion, strId);
     SesionReport report;
 
-    QString jsonSeries = reportTable.value(0, "seriesDataJson").toString();
-    QString jsonGlobal = reportTable.value(0, "globalAnglesJson").toString();
-     QString jsonOver = reportTable.value(0, "globalOverloadsJson").toString();
-    QString logText = reportTable.value(0, "log").toString();
-
     if (reportTable.rowCount() > 0) {
-        report.fromSeriesJson(nlohmann::json::parse(jsonSeries.toStdString()));
-        report.fromGlobalAnglesJson(nlohmann::json::parse(jsonGlobal.toStdString()));
-        report.fromGlobalOverloadsJson(nlohmann::json::parse(jsonGlobal.toStdString()));
-        report.setLog(logText);
+        QByteArray reportBlob = reportTable.value(0, "reportBlob").toByteArray();
+
+        if (reportBlob.isEmpty() || !report.fromBinary(reportBlob)) {
+            // Sesiones guardadas en formato JSON
+            QString jsonSeries = reportTable.value(0, "seriesDataJson").toString();
+            QString jsonGlobal = reportTable.value(0, "globalAnglesJson").toString();
+            QString jsonOver = reportTable.value(0, "globalOverloadsJson").toString();
+            QString logText = reportTable.value(0, "log").toString();
+            QString jsonRepStats = reportTable.value(0, "repStatsJson").toString();
+
+            if (!jsonSeries.isEmpty())
+                report.fromSeriesJson(nlohmann::json::parse(jsonSeries.toStdString()));
+            if (!jsonGlobal.isEmpty())
+                report.fromGlobalAnglesJson(nlohmann::json::parse(jsonGlobal.toStdString()));
+            if (!jsonOver.isEmpty())
+                report.fromGlobalOverloadsJson(nlohmann::json::parse(jsonOver.toStdString()));
+            report.setLog(logText);
+            if (!jsonRepStats.isEmpty())
+                report.fromRepetitionStatsJson(nlohmann::json::parse(jsonRepStats.toStdString()));
+        }
 
         report.setIdSesion(idSesion);
         sesion->setReport(report);
@@ -675,7 +761,7 @@ QSharedPointer<TrainingSesion> TrainingRepository::getTrainingSesion(int idSesio
 DBTable TrainingRepository::toDBTable_ExerciseEspec(QSharedPointer<ExerciseEspec> espec)
 {
     DBTable table("ExerciseEspec");
-    DBTable t=dbManager->get(TypeBDEnum::ExerciseEspec);
+    DBTable t=dbManager->tableSchema(TypeBDEnum::ExerciseEspec);
     table.setColumns(t.getColumnsNames());
     // table.setColumns({
     //     "idEx", "name", "description", "type", "targetMuscle", "equipment","series", "repetitions", "duration", "weightPercentage", "restTime"
@@ -704,7 +790,7 @@ DBTable TrainingRepository::toDBTable_ExerciseEspec(QSharedPointer<ExerciseEspec
 DBTable TrainingRepository::toDBTable_TrainingWorkout(QSharedPointer<TrainingWorkout> workout)
 {
     DBTable table("TrainingWorkout");
-    DBTable t=dbManager->get(TypeBDEnum::TrainingWorkout);
+    DBTable t=dbManager->tableSchema(TypeBDEnum::TrainingWorkout);
     table.setColumns(t.getColumnsNames());
 
     //table.setColumns({"idWorkout", "name", "description", "estimatedDuration" });
@@ -734,20 +820,55 @@ QMap<int, QDateTime> TrainingRepository::listSesionSummaries(int idClient, int i
     filtros.insert(DBFilter::IdWorkout, idWorkout);
     filtros.insert(DBFilter::IdEx,      idEx);
 
-    DBTable table = dbManager->get(TypeBDEnum::TrainingSesion, filtros);
-
-
+    // El historial se recorre por bloques: solo se conservan el ID y la fecha de cada sesión
     QMap<int,QDateTime> mapa;
-    for (int row = 0; row < table.rowCount(); ++row) {
-        int idSes = table.value(row, "idSesion").toInt();
-        // la columna "date" la guardas en ISO8601
-        QDateTime dt = QDateTime::fromString(table.value(row, "date").toString(),Qt::ISODate);
-        mapa.insert(idSes, dt);
-    }
+    dbManager->scan(TypeBDEnum::TrainingSesion, filtros, [&mapa](const DBTable& chunk) {
+        const int colId = chunk.columnIndex("idSesion");
+        const int colDate = chunk.columnIndex("date");
+        for (int row = 0; row < chunk.rowCount(); ++row) {
+            int idSes = chunk.intValue(row, colId);
+            // la columna "date" la guardas en ISO8601
+            QDateTime dt = QDateTime::fromString(chunk.stringValue(row, colDate),Qt::ISODate);
+            mapa.insert(idSes, dt);
+        }
+        return true;
+    });
 
     return mapa;
 }
 
+/*!
+ * \brief Devuelve la tendencia de progreso de un cliente en un ejercicio a partir de los acumulados por periodo.
+ *
+ * Es una única consulta sobre la clave primaria del acumulado (cliente, ejercicio, periodo), sin leer las sesiones.
+ * \param idClient ID del cliente.
+ * \param idEx ID del ejercicio.
+ * \param from Primer día incluido (nulo: sin límite).
+ * \param to Último día incluido (nulo: sin límite).
+ * \param weekly `true` para un punto por semana ISO, `false` para uno por día.
+ * \return Tabla con una fila por periodo con sesiones, ordenada por fecha.
+ */
+DBTable TrainingRepository::getProgressTrend(int idClient, int idEx, const QDate& from, const QDate& to, bool weekly)
+{
+    const QString periodo = weekly ? "week" : "day";
+    auto clave = [weekly](const QDate& fecha) -> QVariant {
+        if (!fecha.isValid()) return QVariant();
+        return weekly ? SesionSummary::weekKey(fecha) : fecha.toString(Qt::ISODate);
+    };
+
+    DBPageRequest peticion;
+    peticion.tipo = weekly ? TypeBDEnum::SesionRollupWeekly : TypeBDEnum::SesionRollupDaily;
+    peticion.equals.insert("idClient", idClient);
+    peticion.equals.insert("idEx", idEx);
+    peticion.between.insert(periodo, qMakePair(clave(from), clave(to)));
+    peticion.orderBy = periodo;
+    // Como mucho hay un periodo por fila, así que el rango de fechas acota la página
+    peticion.limit = (from.isValid() && to.isValid())
+                         ? qMax(static_cast<int>(from.daysTo(to) / (weekly ? 7 : 1)) + 2, 1)
+                         : std::numeric_limits<int>::max();
+    return dbManager->getPage(peticion);
+}
+
 
 /*!
  * \brief Lista los workouts según un filtro determinado.
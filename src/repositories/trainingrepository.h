@@ -11,6 +11,7 @@
 #define TRAININGREPOSITORY_H
 
 #include "core/dbmanager.h"
+#include "db/dbhandle.h"
 #include <QPointer>
 #include "workouts/exerciseespec.h"
 #include "workouts/trainingworkout.h"
@@ -44,6 +45,13 @@ public:
      */
     QSharedPointer<ExerciseEspec> getEspec(int id);
 
+    /*!
+     * \brief Recupera varias especificaciones de ejercicio con un número fijo de consultas.
+     * \param ids Identificadores de los ejercicios.
+     * \return Especificaciones encontradas, indexadas por ID.
+     */
+    QHash<int, QSharedPointer<ExerciseEspec>> getEspecs(const QList<int>& ids);
+
     /*!
      * \brief Recupera un workout completo (incluyendo ejercicios) desde la base de datos.
      * \param id Identificador único del workout.
@@ -99,6 +107,14 @@ public:
      */
     bool SaveTrainingSesion(QSharedPointer<TrainingSesion> sesion);
 
+    /*!
+     * \brief Prepara, sin escribirlo, el lote de filas de una sesión (sesión, resumen y reporte).
+     * \param sesion Puntero compartido a `TrainingSesion`; recibe el ID asignado.
+     * \param batch Lote a completar.
+     * \return `true` si el lote está listo para guardarse.
+     */
+    bool buildSesionBatch(QSharedPointer<TrainingSesion> sesion, DBWriteBatch& batch);
+
     /*!
      * \brief Recupera una sesión de entrenamiento completa (con resumen y reporte).
      * \param idSesion Identificador de la sesión.
@@ -127,6 +143,17 @@ public:
      */
     QMap<int, QDateTime> listSesionSummaries(int idClient, int idWorkout, int idEx);
 
+    /*!
+     * \brief Devuelve la tendencia de progreso de un cliente en un ejercicio, por día o por semana.
+     * \param idClient ID del cliente.
+     * \param idEx ID del ejercicio.
+     * \param from Primer día incluido (nulo: sin límite).
+     * \param to Último día incluido (nulo: sin límite).
+     * \param weekly `true` para agrupar por semana ISO.
+     * \return Tabla de `SesionRollupDaily` o `SesionRollupWeekly` ordenada por periodo.
+     */
+    DBTable getProgressTrend(int idClient, int idEx, const QDate& from, const QDate& to, bool weekly = false);
+
 signals:
     /*!
      * \brief Señal utilizada para notificar errores en la interfaz.
@@ -136,7 +163,7 @@ signals:
     void ui_errorMessage(const QString& msg, QtMsgType type = QtWarningMsg);
 
 private:
-    DBManager* dbManager;  //!< Puntero al gestor de base de datos.
+    DBHandle dbManager;  //!< Gestor de base de datos; desde otros hilos, la conexión del hilo.
 
     /*!
      * \brief Convierte un objeto `ExerciseEspec` a un `DBTable` para guardado.
@@ -7,6 +7,7 @@
 #include <QDebug>
 #include <QCoreApplication>
 #include <QBuffer>
+#include "db/dbtransaction.h"
 // Definimos una categoría para los logs
 Q_LOGGING_CATEGORY(UserRepo, "UserRepo")
 /**
@@ -59,6 +60,11 @@ QSharedPointer<User> UserRepository::getUserById(int id) {
     else if (type == UserType::Admin) tipoEntidad = TypeBDEnum::Admin;
     else return nullptr;
 
+    // La imagen completa solo se lee al cargar un usuario concreto
+    DBTable pictureTable = db->get(TypeBDEnum::UserPicture, DBFilter::IdUser, idStr);
+    if (pictureTable.rowCount() > 0)
+        userData.insert(UserField::Picture, pictureTable.value(0, "picture"));
+
     DBTable specificTable = db->get(tipoEntidad, DBFilter::IdUser, QString::number(id));
     //qDebug(UserRepo) << "Datos Recuperados:";
     //userTable.print();
@@ -154,25 +160,16 @@ bool UserRepository::saveUser(QSharedPointer<User> user) {
 
     if (type == UserType::Unknown) return false;
 
+    // La fila de users, la de la imagen y la del rol se confirman juntas; si alguna falla se deshacen todas
+    DBTransaction tx(db);
+
     // Guardamos datos comunes en tabla "users"
-    DBTable userTabledb=db->get(TypeBDEnum::User);
+    DBTable userTabledb=db->tableSchema(TypeBDEnum::User);
     DBTable userTable("users");
     userTable.setColumns(userTabledb.getColumnsNames());
    // userTable.setColumns({"idUser", "userName", "email", "password", "userType", "join_up_date", "last_login"});
-        QImage image;
-    if (user->getProfile_Picture().isNull()) {
-        QString path = QCoreApplication::applicationDirPath() + "/config/blank-profile.jpg";
-        image.load(path);
-        if (image.isNull()) {
-            qWarning() << "No se pudo cargar ninguna imagen del perfil. Usando imagen en blanco.";
-        }
-    }
-
-    QByteArray arrayImagen;
-    QBuffer buffer(&arrayImagen);
-    buffer.open(QIODevice::WriteOnly);
-    user->getProfile_Picture().save(&buffer, "PNG");
 
+    // La imagen se guarda aparte, junto a su miniatura; la columna profile_picture de users queda vacía
     userTable.addRow({
         id,
         user->getUserName(),
@@ -181,14 +178,41 @@ bool UserRepository::saveUser(QSharedPointer<User> user) {
         UserTypeToString(type),
         user->getJoin_up_date().toString(Qt::ISODate),
         user->getLast_login().toString(Qt::ISODate),
-        arrayImagen
-        //user->getProfile_Picture()
+        QVariant()
     });
     //qDebug(UserRepo)<<"Tabla generada";
     //userTable.print();
-    db->save(TypeBDEnum::User, userTable);
+    if (!db->save(TypeBDEnum::User, userTable)) {
+        qWarning(UserRepo) << "No se pudo guardar el usuario con IdUser:" << idStr;
+        return false;
+    }
     //db->get(TypeBDEnum::User).print();
 
+    // Un usuario sin imagen no tiene fila en user_pictures; si la tenía, se borra
+    const QImage picture = user->getProfile_Picture();
+    bool pictureSaved;
+    if (picture.isNull()) {
+        pictureSaved = db->deleteRow(TypeBDEnum::UserPicture, DBFilter::IdUser, idStr);
+    } else {
+        QByteArray imagen;
+        QBuffer buffer(&imagen);
+        buffer.open(QIODevice::WriteOnly);
+        picture.save(&buffer, "PNG");
+
+        QByteArray miniatura;
+        QBuffer bufferMiniatura(&miniatura);
+        bufferMiniatura.open(QIODevice::WriteOnly);
+        makeThumbnail(picture).save(&bufferMiniatura, "PNG");
+
+        DBTable pictureTable = db->tableSchema(TypeBDEnum::UserPicture);
+        pictureTable.addRow({id, imagen, miniatura});
+        pictureSaved = db->save(TypeBDEnum::UserPicture, pictureTable);
+    }
+    if (!pictureSaved) {
+        qWarning(UserRepo) << "No se pudo guardar la imagen del usuario con IdUser:" << idStr;
+        return false;
+    }
+
     // Guardamos en tabla específica según tipo
 
         //qDebug(UserRepo) << "Hacemos el dinamic Cast según el tipo de usuario .";
@@ -254,7 +278,8 @@ bool UserRepository::saveUser(QSharedPointer<User> user) {
 
        result=db->save(TypeBDEnum::Admin, adminTable, DBFilter::IdUser, idStr);
     }
-    return result;
+    if (!result) return false;
+    return tx.commit();
 }
 
 /**
@@ -281,6 +306,9 @@ bool UserRepository::deleteUser(int id) {
         {TypeBDEnum::ProfileMedical, DBFilter::IdClient},
          {TypeBDEnum::ProfileGeneral, DBFilter::IdClient}
     };
+    // Un usuario sin imagen no tiene fila en user_pictures: su borrado no cuenta para el resultado
+    db->deleteRow(TypeBDEnum::UserPicture, DBFilter::IdUser, idStr);
+
     bool check=true;
     for (const auto& filtro : filtros) {
         //esto es para FakeBD
@@ -544,3 +572,34 @@ int UserRepository::getNextUserId() {
     return db->generateID(TypeBDEnum::User);
 }
 
+/**
+ * @brief Solo se lee la columna de la miniatura; la imagen completa se decodifica únicamente para las imágenes
+ * migradas desde la tabla users, que aún no tienen miniatura. Esa miniatura no se guarda aquí, para que la
+ * lectura no escriba desde los hilos de los listados; se guardará la próxima vez que se guarde el usuario.
+ */
+QImage UserRepository::getUserThumbnail(int idUser) {
+    DBPageRequest peticion;
+    peticion.tipo = TypeBDEnum::UserPicture;
+    peticion.columns = {"thumbnail"};
+    peticion.equals.insert("idUser", idUser);
+    peticion.limit = 1;
+
+    DBTable fila = db->getPage(peticion);
+    if (fila.rowCount() == 0) return QImage();
+
+    QImage miniatura;
+    const QVariant datos = fila.value(0, 0);
+    if (!datos.isNull() && miniatura.loadFromData(datos.toByteArray())) return miniatura;
+
+    peticion.columns = {"picture"};
+    fila = db->getPage(peticion);
+    QImage imagen;
+    if (fila.rowCount() == 0 || !imagen.loadFromData(fila.value(0, 0).toByteArray())) return QImage();
+    return makeThumbnail(imagen);
+}
+
+QImage UserRepository::makeThumbnail(const QImage& picture) {
+    if (picture.isNull()) return QImage();
+    if (picture.width() <= thumbnailSize && picture.height() <= thumbnailSize) return picture;
+    return picture.scaled(thumbnailSize, thumbnailSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
@@ -14,6 +14,7 @@
 #include <QList>
 #include "profiles/profiles.h"
 #include "core/dbmanager.h"
+#include "db/dbhandle.h"
 #include <QPointer>
 #include "enums/enums.h"
 #include <QLoggingCategory>
@@ -116,11 +117,29 @@ public:
      */
     int getNextUserId();
 
+    /**
+     * @brief Recupera la miniatura de la imagen de perfil de un usuario sin leer la imagen completa.
+     *
+     * Puede llamarse desde otros hilos. Si la imagen se guardó sin miniatura, la genera en memoria.
+     * @param idUser ID del usuario.
+     * @return Miniatura, o imagen nula si el usuario no tiene imagen.
+     */
+    QImage getUserThumbnail(int idUser);
+
+    /**
+     * @brief Reduce una imagen de perfil al tamaño de miniatura conservando su proporción.
+     * @param picture Imagen completa.
+     * @return Miniatura de como mucho `thumbnailSize` píxeles de lado.
+     */
+    static QImage makeThumbnail(const QImage& picture);
+
+    static constexpr int thumbnailSize = 64; ///< Lado máximo de las miniaturas de perfil, en píxeles.
+
 private:
     /**
      * @brief Referencia al gestor de base de datos para todas las operaciones de persistencia.
      */
-    DBManager* db;
+    DBHandle db; ///< Gestor de base de datos; desde otros hilos, la conexión del hilo.
 
     /**
      * @brief Construye un objeto DBTable a partir de un mapa de datos genérico.
@@ -8,6 +8,7 @@
 #include "profiles/admin.h"
 #include "profiles/fitnesstrainer.h"
 #include "ui/main/comboboxdelegate.h"
+#include "utils/uiutils.h"
 
 
 /// @brief Constructor. Inicializa los modelos, conecta señales y carga los usuarios disponibles.
@@ -15,21 +16,30 @@ UsersAdminWidget::UsersAdminWidget(QSharedPointer<AppController> controller, QWi
     : QWidget(parent), ui(new Ui::UsersAdminWidget), controller(controller) {
     ui->setupUi(this);
 
-    userTableModel = new UiTableModel(this);
+    userTableModel = new DBPagedTableModel(controller->getConnectionPool(), this);
     editTableModel = new UiTableModel(this);
 
     ui->userTable->setModel(userTableModel);
     ui->editTable->setModel(editTableModel);
 
+    DBPageRequest usersQuery;
+    usersQuery.tipo = TypeBDEnum::User;
+    usersQuery.columns = {"idUser", "userName", "email", "userType"};
+    usersQuery.orderBy = "userName";
+    userTableModel->setQuery(usersQuery, {"IdUser", "UserName", "Email", "UserType"});
+    QSharedPointer<UserManager> users = controller->getUserManager();
+    thumbnails = UiUtils::showUserThumbnails(ui->userTable, userTableModel, 0, [users](int idUser) {
+        return users->getUserThumbnail(idUser);
+    });
+
     connect(ui->userTable, &QTableView::clicked, this, &UsersAdminWidget::onUserSelected);
+    connect(ui->userTable->horizontalHeader(), &QHeaderView::sectionClicked, this, &UsersAdminWidget::onUserHeaderClicked);
     connect(ui->saveButton, &QPushButton::clicked, this, &UsersAdminWidget::onSaveClicked);
     connect(ui->deleteButton, &QPushButton::clicked, this, &UsersAdminWidget::onDeleteClicked);
     connect(ui->newButton, &QPushButton::clicked, this, &UsersAdminWidget::onNewClicked);
 
     connect(editTableModel, &QAbstractItemModel::dataChanged,this, &UsersAdminWidget::onEditTableDataChanged);
 
-
-    loadUsers();
 }
 
 /// @brief Destructor.
@@ -37,29 +47,21 @@ UsersAdminWidget::~UsersAdminWidget() {
     delete ui;
 }
 
-/// @brief Carga todos los usuarios y los muestra en la tabla principal.
+/// @brief Recarga la tabla de usuarios; las filas se leen por páginas a medida que se muestran.
 void UsersAdminWidget::loadUsers() {
-    QList<QSharedPointer<User>> allUsers;
-     allUsers = controller->getUserManager()->listUsers(UserType::Unknown);
-    //allUsers += controller->getUserManager()->listUsers(UserType::Admin);
-    //allUsers += controller->getUserManager()->listUsers(UserType::Trainer);
-    //allUsers += controller->getUserManager()->listUsers(UserType::Client);
-
-    QList<QList<QVariant>> rows;
-    for (const auto& user : allUsers) {
-        QList<QVariant> row;
-        row << user->getId() << user->getUserName() << user->getEmail() << UserTypeToString(user->getUserType());
-        rows << row;
-    }
+    userTableModel->reload();
+}
 
-    userTableModel->setDataSet(rows, {"IdUser", "UserName", "Email", "UserType"});
+/// @brief Filtra la tabla de usuarios por la columna pulsada; el filtro se resuelve en la consulta.
+void UsersAdminWidget::onUserHeaderClicked(int logicalIndex) {
+    UiUtils::showFilterPopup(this, ui->userTable, userTableModel, logicalIndex);
 }
 /// @brief Maneja la selección de un usuario y carga sus datos en la tabla de edición.
 void UsersAdminWidget::onUserSelected(const QModelIndex& index) {
     int row = index.row();
     if (row < 0 || row >= userTableModel->rowCount()) return;
 
-    int id = userTableModel->getDataSet().at(row).at(0).toInt();
+    int id = userTableModel->data(userTableModel->index(row, 0)).toInt();
     selectedUserId = id;
 
     editUser= controller->getUserManager()->getUser(id);
@@ -146,6 +148,7 @@ void UsersAdminWidget::onSaveClicked() {
         editUser = QSharedPointer<Client>::create(data);}
 
      controller->getUserManager()->updateUser(editUser);
+    thumbnails->invalidate(editUser->getId());
     // selectedUserId = editUser->getId();
     loadUsers();
 }
@@ -154,6 +157,7 @@ void UsersAdminWidget::onSaveClicked() {
 void UsersAdminWidget::onDeleteClicked() {
     if (selectedUserId < 0) return;
     controller->getUserManager()->deleteUser(selectedUserId);
+    thumbnails->invalidate(selectedUserId);
     selectedUserId = -1;
     clearEditTable();
     loadUsers();
@@ -12,6 +12,8 @@
 #include "ui_usersadminwidget.h"
 #include "core/appcontroller.h"
 #include "ui/main/uitablemodel.h"
+#include "ui/main/dbpagedtablemodel.h"
+#include "ui/main/userthumbnailcache.h"
 #include "enums/UserFieldEnum.h"
 
 namespace Ui {
@@ -53,18 +55,23 @@ private slots:
     /// @brief Inicia la creación de un nuevo usuario.
     void onNewClicked();
 
+    /// @brief Muestra el filtro de la columna pulsada en la tabla de usuarios.
+    /// @param logicalIndex Columna pulsada.
+    void onUserHeaderClicked(int logicalIndex);
+
     /// @brief Detecta cambios en los datos de la tabla de edición.
     void onEditTableDataChanged(const QModelIndex& m1, const QModelIndex& m2);
 
 private:
     Ui_UsersAdminWidget *ui; ///< Interfaz gráfica generada por Qt Designer.
     QSharedPointer<AppController> controller; ///< Controlador principal de la aplicación.
-    UiTableModel* userTableModel; ///< Modelo de datos para la tabla de usuarios.
+    DBPagedTableModel* userTableModel; ///< Modelo paginado de la tabla de usuarios.
+    UserThumbnailCache* thumbnails; ///< Miniaturas de perfil de la tabla de usuarios.
     UiTableModel* editTableModel; ///< Modelo de datos para la tabla de edición.
     int selectedUserId = -1; ///< ID del usuario actualmente seleccionado o en edición.
     QSharedPointer<User> editUser; ///< Puntero al usuario actualmente en edición.
 
-    /// @brief Carga todos los usuarios desde el sistema y los muestra en la tabla.
+    /// @brief Vuelve a cargar la tabla de usuarios desde la primera página.
     void loadUsers();
 
     /// @brief Rellena la tabla de edición con los datos del usuario dado.
@@ -12,15 +12,27 @@ FeedBackGraphWidget::FeedBackGraphWidget(QWidget *parent)
     setMinimumSize(200, 200);
 }
 
-/// @brief Procesa el feedback recibido y actualiza los contadores de condiciones.
-/// Llama a `update()` para repintar el widget.
-/// @param feedback Objeto con las condiciones a analizar.
-void FeedBackGraphWidget::updateFromFeedback(const FeedBack &feedback)
+/// @brief Suma el intervalo desde el feedback anterior a las categorías que estaban activas y toma las
+/// categorías activas del nuevo feedback. Llama a `update()` para repintar el widget.
+/// @param feedback Objeto con las condiciones activas y el timestamp del frame.
+/// @param accumulate Indica si el intervalo transcurrido cuenta para la gráfica.
+void FeedBackGraphWidget::updateFromFeedback(const FeedBack &feedback, bool accumulate)
 {
-    for (const ConditionType &type:feedback.getEntriesList()) {
-         if (feedback.isCritical(type)) ++criticalCount;
-         else if (feedback.isAlert(type)) ++alertCount;
-         else if (feedback.isOptimal(type))  ++optimalCount;
+    const qint64 time = feedback.getTime();
+    if (accumulate && lastTime >= 0 && time > lastTime) {
+        const qint64 elapsed = time - lastTime;
+        if (optimalActive) optimalTime += elapsed;
+        if (alertActive) alertTime += elapsed;
+        if (criticalActive) criticalTime += elapsed;
+    }
+    lastTime = time;
+
+    optimalActive = alertActive = criticalActive = false;
+    for (const ConditionType &type:feedback.getActiveList()) {
+         const ConditionCategory category = feedback.categoryOf(type);
+         if (category == ConditionCategory::critical) criticalActive = true;
+         else if (category == ConditionCategory::alert) alertActive = true;
+         else if (feedback.isOptimal(type)) optimalActive = true;
     }
     //Actializa el widget(repinta)
     update();
@@ -47,12 +59,12 @@ void FeedBackGraphWidget::paintEvent(QPaintEvent *event)
     QRectF shadow = circulo.adjusted(0, 10, 0, 10);
     painter.drawEllipse(shadow);
 
-    int total = optimalCount + alertCount + criticalCount;
+    const qint64 total = optimalTime + alertTime + criticalTime;
     if (total == 0) return;
 
-    double optPerc = 100.0 * optimalCount / total;
-    double alertPerc = 100.0 * alertCount / total;
-    double critPerc = 100.0 * criticalCount / total;
+    double optPerc = 100.0 * optimalTime / total;
+    double alertPerc = 100.0 * alertTime / total;
+    double critPerc = 100.0 * criticalTime / total;
 
     int startAngle = 0;
 
@@ -10,8 +10,9 @@
 /// @class FeedBackGraphWidget
 /// @brief Widget gráfico que representa visualmente el resumen de condiciones de un ejercicio.
 ///
-/// Muestra una gráfica circular tipo donut con porcentajes de condiciones óptimas, de alerta y críticas.
-/// Esta visualización permite una rápida comprensión del estado general del rendimiento.
+/// Muestra una gráfica circular tipo donut con el porcentaje del tiempo de ejercicio en que ha habido alguna
+/// condición óptima, de alerta o crítica activa. El feedback solo llega cuando cambian las condiciones activas,
+/// así que cada intervalo entre dos feedbacks se suma a las categorías que estaban activas durante él.
 class FeedBackGraphWidget : public QWidget
 {
     Q_OBJECT
@@ -21,8 +22,9 @@ public:
     explicit FeedBackGraphWidget(QWidget *parent = nullptr);
 
     /// @brief Actualiza los datos del gráfico a partir de un objeto FeedBack.
-    /// @param feedback Estructura con las condiciones generadas durante el análisis del ejercicio.
-    void updateFromFeedback(const FeedBack& feedback);
+    /// @param feedback Estructura con las condiciones activas tras el frame y su timestamp.
+    /// @param accumulate Si es false (por ejemplo, en el descanso) el intervalo anterior no se suma.
+    void updateFromFeedback(const FeedBack& feedback, bool accumulate = true);
 
 protected:
     /// @brief Evento de pintura del widget.
@@ -31,9 +33,13 @@ protected:
     void paintEvent(QPaintEvent *event) override;
 
 private:
-    int optimalCount = 0;   ///< Número de condiciones clasificadas como óptimas.
-    int alertCount = 0;     ///< Número de condiciones clasificadas como alertas.
-    int criticalCount = 0;  ///< Número de condiciones clasificadas como críticas.
+    qint64 optimalTime = 0;       ///< Milisegundos con alguna condición óptima activa.
+    qint64 alertTime = 0;         ///< Milisegundos con alguna alerta activa.
+    qint64 criticalTime = 0;      ///< Milisegundos con alguna condición crítica activa.
+    bool optimalActive = false;   ///< Hay una condición óptima activa desde el último feedback.
+    bool alertActive = false;     ///< Hay una alerta activa desde el último feedback.
+    bool criticalActive = false;  ///< Hay una condición crítica activa desde el último feedback.
+    qint64 lastTime = -1;         ///< Timestamp del último feedback recibido (-1 si no hay ninguno).
 };
 
 #endif // FEEDBACKGRAPHWIDGET_H
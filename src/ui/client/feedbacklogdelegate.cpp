@@ -0,0 +1,37 @@
+/**
+ * @file feedbacklogdelegate.cpp
+ * @brief Implementación de la clase FeedbackLogDelegate.
+ */
+
+#include "feedbacklogdelegate.h"
+#include "feedbacklogmodel.h"
+#include <QColor>
+
+FeedbackLogDelegate::FeedbackLogDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+void FeedbackLogDelegate::initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const
+{
+    QStyledItemDelegate::initStyleOption(option, index);
+
+    const auto category = static_cast<ConditionCategory>(index.data(FeedbackLogModel::CategoryRole).toInt());
+    switch (category) {
+    case ConditionCategory::critical:
+        option->text = "[CRÍTICO] " + option->text;
+        option->palette.setColor(QPalette::Text, Qt::red);
+        option->font.setBold(true);
+        break;
+    case ConditionCategory::alert:
+        option->text = "[ALERTA] " + option->text;
+        option->palette.setColor(QPalette::Text, QColor(255, 165, 0));
+        break;
+    case ConditionCategory::info:
+        option->text = "[INFO] " + option->text;
+        option->palette.setColor(QPalette::Text, Qt::gray);
+        break;
+    default:
+        break;
+    }
+}
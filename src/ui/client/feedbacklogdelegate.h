@@ -0,0 +1,37 @@
+/**
+ * @file feedbacklogdelegate.h
+ * @brief Declaración de la clase FeedbackLogDelegate, que da formato a las filas de FeedbackLogModel.
+ */
+
+#ifndef FEEDBACKLOGDELEGATE_H
+#define FEEDBACKLOGDELEGATE_H
+
+#include <QStyledItemDelegate>
+
+/**
+ * @class FeedbackLogDelegate
+ * @brief Delegado de presentación para los mensajes de feedback.
+ *
+ * Añade el prefijo de severidad ([CRÍTICO], [ALERTA], [INFO]) y aplica el color y el peso de la fuente
+ * correspondientes, sustituyendo al HTML que antes se insertaba en cada mensaje.
+ */
+class FeedbackLogDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor del delegado.
+     * @param parent Objeto padre.
+     */
+    explicit FeedbackLogDelegate(QObject *parent = nullptr);
+
+protected:
+    /**
+     * @brief Completa las opciones de estilo de la fila con el texto, el color y la fuente de su severidad.
+     * @param option Opciones de estilo a completar.
+     * @param index Índice de la fila.
+     */
+    void initStyleOption(QStyleOptionViewItem *option, const QModelIndex &index) const override;
+};
+
+#endif // FEEDBACKLOGDELEGATE_H
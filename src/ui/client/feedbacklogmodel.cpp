@@ -0,0 +1,91 @@
+/**
+ * @file feedbacklogmodel.cpp
+ * @brief Implementación de la clase FeedbackLogModel.
+ */
+
+#include "feedbacklogmodel.h"
+
+/**
+ * @brief Constructor. Reserva el buffer y prepara el temporizador de refresco.
+ */
+FeedbackLogModel::FeedbackLogModel(int capacity, QObject *parent)
+    : QAbstractListModel(parent),
+    capacity(qMax(capacity, 1)),
+    rows(this->capacity)
+{
+    flushTimer.setSingleShot(true);
+    flushTimer.setInterval(flushIntervalMs);
+    connect(&flushTimer, &QTimer::timeout, this, &FeedbackLogModel::flush);
+}
+
+/**
+ * @brief Encola el mensaje y arranca el temporizador si no estaba en marcha. El lote se acota a la capacidad.
+ */
+void FeedbackLogModel::append(const QString &message, ConditionCategory category)
+{
+    pending.append({message, category});
+    if (pending.size() > capacity)
+        pending.removeFirst();
+    if (!flushTimer.isActive())
+        flushTimer.start();
+}
+
+/**
+ * @brief Elimina de una vez las filas que desbordan la capacidad y después inserta el lote completo.
+ */
+void FeedbackLogModel::flush()
+{
+    if (pending.isEmpty()) return;
+
+    const int incoming = pending.size();
+    const int overflow = count + incoming - capacity;
+    if (overflow > 0) {
+        beginRemoveRows(QModelIndex(), 0, overflow - 1);
+        head = (head + overflow) % capacity;
+        count -= overflow;
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), count, count + incoming - 1);
+    for (const LogRow& row : pending) {
+        rows[(head + count) % capacity] = row;
+        ++count;
+    }
+    endInsertRows();
+    pending.clear();
+}
+
+void FeedbackLogModel::clear()
+{
+    flushTimer.stop();
+    pending.clear();
+    beginResetModel();
+    head = 0;
+    count = 0;
+    endResetModel();
+}
+
+int FeedbackLogModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : count;
+}
+
+QVariant FeedbackLogModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= count) return QVariant();
+
+    const LogRow& row = rowAt(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+        return row.message;
+    case CategoryRole:
+        return static_cast<int>(row.category);
+    default:
+        return QVariant();
+    }
+}
+
+const FeedbackLogModel::LogRow &FeedbackLogModel::rowAt(int row) const
+{
+    return rows[(head + row) % capacity];
+}
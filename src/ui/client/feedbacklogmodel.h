@@ -0,0 +1,85 @@
+/**
+ * @file feedbacklogmodel.h
+ * @brief Declaración de la clase FeedbackLogModel, registro acotado de los mensajes de feedback de una sesión.
+ *
+ * Los mensajes que llegan durante la ejecución se acumulan en un lote y se insertan en el modelo a la
+ * frecuencia de refresco de la pantalla. El modelo guarda como máximo un número fijo de filas en un buffer
+ * circular, de modo que el coste de cada inserción y la memoria no dependen de la duración de la sesión.
+ */
+
+#ifndef FEEDBACKLOGMODEL_H
+#define FEEDBACKLOGMODEL_H
+
+#include <QAbstractListModel>
+#include <QList>
+#include <QString>
+#include <QTimer>
+#include <vector>
+#include "pose/condition.h"
+
+/**
+ * @class FeedbackLogModel
+ * @brief Modelo de lista con capacidad fija para mostrar mensajes de feedback en un QListView.
+ *
+ * Cada fila guarda el texto plano del mensaje y su severidad; la presentación (color, prefijo) la aplica
+ * FeedbackLogDelegate. Cuando se alcanza la capacidad, las filas más antiguas se eliminan al insertar nuevas.
+ */
+class FeedbackLogModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    /// Rol con la severidad (ConditionCategory) de la fila.
+    static constexpr int CategoryRole = Qt::UserRole + 1;
+
+    /**
+     * @brief Constructor.
+     * @param capacity Número máximo de filas que conserva el modelo.
+     * @param parent Objeto padre.
+     */
+    explicit FeedbackLogModel(int capacity = 200, QObject *parent = nullptr);
+
+    /**
+     * @brief Añade un mensaje al lote pendiente. Se mostrará en el siguiente refresco.
+     * @param message Texto del mensaje.
+     * @param category Severidad del mensaje.
+     */
+    void append(const QString& message, ConditionCategory category);
+
+    /**
+     * @brief Inserta en el modelo los mensajes pendientes, descartando los más antiguos si es necesario.
+     */
+    void flush();
+
+    /**
+     * @brief Elimina todas las filas y los mensajes pendientes.
+     */
+    void clear();
+
+    /// @copydoc QAbstractListModel::rowCount
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /// @copydoc QAbstractListModel::data
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+private:
+    /// Fila del registro.
+    struct LogRow {
+        QString message;
+        ConditionCategory category = ConditionCategory::none;
+    };
+
+    static constexpr int flushIntervalMs = 16; ///< Intervalo de refresco (~60 Hz).
+
+    int capacity;               ///< Número máximo de filas.
+    std::vector<LogRow> rows;   ///< Buffer circular de filas.
+    int head = 0;               ///< Posición de la fila más antigua en el buffer.
+    int count = 0;              ///< Filas ocupadas.
+    QList<LogRow> pending;      ///< Mensajes recibidos desde el último refresco.
+    QTimer flushTimer;          ///< Temporizador de un disparo que agrupa los mensajes.
+
+    /// Fila del buffer correspondiente a una fila del modelo.
+    const LogRow& rowAt(int row) const;
+};
+
+#endif // FEEDBACKLOGMODEL_H
@@ -1,5 +1,7 @@
 #include "userclientsesionexecution.h"
 #include "ui_userclientsesionexecution.h"
+#include "feedbacklogdelegate.h"
+#include <QScrollBar>
 #include <QImage>
 #include <QPixmap>
 #include <QTimer>
@@ -70,9 +72,12 @@ UserClientSesionExecution::UserClientSesionExecution(QSharedPointer<TrainingSesi
      QString setsstr = QString("Sets: 0 of %2").arg(maxSets);
      ui->SetLabel->setText(setsstr);
 
-     ui->criticalMsgEdit->setReadOnly(true);
-     ui->alertsMsgEdit->setReadOnly(true);
-     ui->infoMsgEdit->setReadOnly(true);
+     criticalLog = new FeedbackLogModel(200, this);
+     alertsLog = new FeedbackLogModel(200, this);
+     infoLog = new FeedbackLogModel(200, this);
+     setupLogView(ui->criticalLogView, criticalLog);
+     setupLogView(ui->alertsLogView, alertsLog);
+     setupLogView(ui->infoLogView, infoLog);
 
      //configuramos los botones
      if (!mute)ui->muteButton->setStyleSheet("QPushButton { background-color: green; color: white; font-weight: bold; }");
@@ -119,27 +124,27 @@ void UserClientSesionExecution::onNewImage2( const cv::Mat& image)
 void UserClientSesionExecution::onFeedbackReceived( const FeedBack& feedback)
 {
 
+    // La gráfica recibe todos los feedbacks para conocer las condiciones activas, pero solo suma el tiempo en ejecución
+    if (graphWidget!=nullptr) graphWidget->updateFromFeedback(feedback, inExecution);
+
     if (!inExecution && !waitingForExecutionActivation)
         return;
 
-    if (graphWidget!=nullptr && inExecution) graphWidget->updateFromFeedback(feedback);
-
     for (const ConditionType &type:feedback.getEntriesList()) {
 
         if (fireEffect(type))
         {
-            QStringList lines;
             QString message = feedback.getMessage(type);
             if (feedback.isCritical(type)){
-                ui->criticalMsgEdit->append(QString("<b style='color:red;'>[CRÍTICO] " + message + "</b>"+"\n"));
+                criticalLog->append(message, ConditionCategory::critical);
                 if (!mute && criticaSoundEnable && inExecution)soundManager->addtoSoundList(type,ConditionCategory::critical);
             }
             else if (feedback.isAlert(type)){
-                 ui->alertsMsgEdit->append(QString("<span style='color:orange;'>[ALERTA] " + message + "</span>"+"\n"));
+                 alertsLog->append(message, ConditionCategory::alert);
                  if (!mute && alertSoundEnabled && inExecution)soundManager->addtoSoundList(type,ConditionCategory::alert);
             }
             else{
-                 ui->infoMsgEdit->append(QString("<span style='color:gray;'>[INFO] " + message + "</span>"+"\n"));
+                 infoLog->append(message, ConditionCategory::info);
                  if (!mute && infoSoundEnable && inExecution)soundManager->addtoSoundList(type,ConditionCategory::info);
             }
         }
@@ -245,6 +250,21 @@ void UserClientSesionExecution::onFeedbackReceived( const FeedBack& feedback)
 void UserClientSesionExecution::appendFeedbackMessages( const FeedBack& feedback)
 {
 
+}
+/// @brief Configura una vista de registro: filas de altura uniforme, delegado de formato y desplazamiento
+/// automático al final si el usuario no se ha desplazado hacia arriba.
+void UserClientSesionExecution::setupLogView(QListView* view, FeedbackLogModel* model)
+{
+    view->setModel(model);
+    view->setItemDelegate(new FeedbackLogDelegate(view));
+    view->setUniformItemSizes(true);
+    view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    view->setSelectionMode(QAbstractItemView::NoSelection);
+
+    connect(model, &QAbstractItemModel::rowsInserted, view, [view]() {
+        QScrollBar* bar = view->verticalScrollBar();
+        if (bar->value() >= bar->maximum() - 1) view->scrollToBottom();
+    });
 }
 /// @brief Lógica de temporizador que actualiza la interfaz de tiempo y progreso.
 void UserClientSesionExecution::updateTimeLabel()
@@ -339,6 +359,7 @@ void UserClientSesionExecution::on_pauseButton_clicked()
         sessionTimer->stop();
         ui->pauseButton->setText("Resume");
         controller->pauseSesion();
+        soundManager->clearQueue();
 
     } else {
         sessionTimer->start();
@@ -351,6 +372,7 @@ void UserClientSesionExecution::on_pauseButton_clicked()
 void UserClientSesionExecution::on_EndSesionButton_clicked()
 {
     controller->finishExerciseSesion();
+    soundManager->clearQueue();
     this->accept();
 }
 /// @brief Controla si se debe mostrar un efecto o reproducir sonido según el tipo de condición.
@@ -443,7 +465,7 @@ void UserClientSesionExecution::on_NewSetButton_clicked()
     ui->restTimeLabel->setStyleSheet("QLabel { color : black; }");
     ui->restTimeBar->setStyleSheet("QProgressBar::chunk { background-color: blue; }");
 
-    ui->infoMsgEdit->append("<span style='color:blue;'>[INFO] Serie interrumpida. Descanso iniciado.</span>");
+    infoLog->append("Serie interrumpida. Descanso iniciado.", ConditionCategory::info);
     qDebug() << "Serie interrumpida manualmente: entrando en descanso.";
 
 }
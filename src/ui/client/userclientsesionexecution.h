@@ -18,6 +18,7 @@
 #include "core/appcontroller.h"
 #include "pose/feedback.h"
 #include "ui/client/feedbackgraphwidget.h"
+#include "ui/client/feedbacklogmodel.h"
 #include "workouts/trainingsesion.h"
 #include "ui_userclientsesionexecution.h"
 #include "core/soundfeedbackmanager.h"
@@ -102,6 +103,9 @@ private:
     QSharedPointer<ExerciseSummary> sum; ///< Resumen del ejercicio en ejecución.
     QTimer* sessionTimer; ///< Temporizador de sesión.
     FeedBackGraphWidget* graphWidget; ///< Widget de gráfica de condiciones.
+    FeedbackLogModel* criticalLog; ///< Registro de mensajes críticos.
+    FeedbackLogModel* alertsLog; ///< Registro de mensajes de alerta.
+    FeedbackLogModel* infoLog; ///< Registro de mensajes informativos.
 
     int elapsedSeconds; ///< Tiempo transcurrido desde el inicio.
     bool inRest; ///< Indica si el usuario está en descanso.
@@ -134,6 +138,13 @@ private:
      */
     void appendFeedbackMessages(const FeedBack& feedback);
 
+    /**
+     * @brief Asocia un registro de mensajes a su vista y la mantiene desplazada al último mensaje.
+     * @param view Vista de lista del formulario.
+     * @param model Modelo de mensajes.
+     */
+    void setupLogView(QListView* view, FeedbackLogModel* model);
+
     /**
      * @brief Determina si se debe emitir efecto o sonido para una condición dada.
      * @param type Tipo de condición.
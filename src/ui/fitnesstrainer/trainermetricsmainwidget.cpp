@@ -224,22 +224,28 @@ void TrainerMetricsMainWidget::populateHeatmapWidget() {
 
 
 void TrainerMetricsMainWidget::loadClientes() {
-    auto clients = controller->getUserManager()->listUsers(UserType::Client);
-    if (clients.isEmpty()) return;
-
-    QStandardItemModel* model = new QStandardItemModel(clients.size(), 3, this);
-    model->setHorizontalHeaderLabels({"ID", "Nombre", "Email"});
-
-    int row = 0;
-    for (const auto& client : clients) {
-        model->setItem(row, 0, new QStandardItem(QString::number(client->getId())));
-        model->setItem(row, 1, new QStandardItem(client->getUserName()));
-        model->setItem(row, 2, new QStandardItem(client->getEmail()));
-        row++;
-    }
+    // Solo se leen las columnas visibles y por páginas; el filtro por tipo usa el índice de users
+    clientesModel = new DBPagedTableModel(controller->getConnectionPool(), this);
+
+    DBPageRequest query;
+    query.tipo = TypeBDEnum::User;
+    query.columns = {"idUser", "userName", "email"};
+    query.equals.insert("userType", UserTypeToString(UserType::Client));
+    query.orderBy = "userName";
+    clientesModel->setQuery(query, {"ID", "Nombre", "Email"});
+
+    ui->clientesTable->setModel(clientesModel);
+    QSharedPointer<UserManager> users = controller->getUserManager();
+    UiUtils::showUserThumbnails(ui->clientesTable, clientesModel, 0, [users](int idUser) {
+        return users->getUserThumbnail(idUser);
+    });
+    connect(ui->clientesTable->horizontalHeader(), &QHeaderView::sectionClicked,
+            this, &TrainerMetricsMainWidget::onClientesHeaderClicked);
+}
 
-    ui->clientesTable->setModel(model);
-    ui->clientesTable->resizeColumnsToContents();
+void TrainerMetricsMainWidget::onClientesHeaderClicked(int logicalIndex)
+{
+    UiUtils::showFilterPopup(this, ui->clientesTable, clientesModel, logicalIndex);
 }
 
 void TrainerMetricsMainWidget::loadWorkoutsForClient(int idClient) {
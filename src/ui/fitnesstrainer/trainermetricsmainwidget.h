@@ -22,6 +22,7 @@
 #include "ui/metrics/timewidget.h"
 #include "ui/metrics/angleviewwidget.h"
 #include "ui/metrics/logviewerwidget.h"
+#include "ui/main/dbpagedtablemodel.h"
 #include "ui_trainermetricsmainwidget.h"
 
 Q_DECLARE_LOGGING_CATEGORY(trainerMetricsWidget)
@@ -132,6 +133,12 @@ private slots:
      */
     void onSerieChanged(int index);
 
+    /**
+     * @brief Clic en la cabecera de la tabla de clientes: muestra el filtro de la columna.
+     * @param logicalIndex Columna pulsada.
+     */
+    void onClientesHeaderClicked(int logicalIndex);
+
 private:
     Ui_TrainerMetricsMainWidget *ui; ///< Interfaz de usuario generada por Qt Designer.
     QSharedPointer<MetricsManager> metricsManager; ///< Gestor de métricas encargado del procesamiento de datos.
@@ -142,6 +149,7 @@ private:
     //ConditionDistributionChart* conditionChart = nullptr; ///< Gráfico de distribución de condiciones (comentado).
     AngleViewerWidget* angleViewer = nullptr; ///< Widget para visualización de ángulos.
     LogViewerWidget* logViewer = nullptr; ///< Widget de visualización del log de la sesión.
+    DBPagedTableModel* clientesModel = nullptr; ///< Clientes, cargados por páginas.
 
     int currentClientId   = -1; ///< ID del cliente actualmente seleccionado.
     int currentWorkoutId  = -1; ///< ID del entrenamiento seleccionado.
@@ -7,6 +7,7 @@
 #include "repositories/trainingrepository.h"
 #include "repositories/userrepository.h"
 #include "core/dbmanager.h"
+#include "db/dbtransaction.h"
 #include "core/loginmanager.h"
 
 class init_LoaderData : public QSharedData
@@ -23,11 +24,14 @@ Init_Loader::~Init_Loader() {}
 void Init_Loader::load(QSharedPointer<DBManager> db)
 {
        // db->initializeSchema();
+        // Todos los datos de ejemplo se confirman en un único commit
+        DBTransaction tx(db.data());
         loadExercises(db);
        loadWorkouts(db);
         loadClients(db);
         loadTrainerAndAdmin(db);
         loadTrainingSessions(db);
+        if (!tx.commit()) qWarning() << "Init_Loader: no se pudieron confirmar los datos iniciales";
 
 
 }
@@ -187,8 +191,8 @@ void Init_Loader::loadExercises(QSharedPointer<DBManager> db)
 void Init_Loader::loadWorkouts(QSharedPointer<DBManager> db)
 {
     // Obtener estructuras de las tablas reales
-    DBTable structureWorkout = db->get(TypeBDEnum::TrainingWorkout);
-    DBTable structureWorkoutExercises = db->get(TypeBDEnum::WorkoutExercises);
+    DBTable structureWorkout = db->tableSchema(TypeBDEnum::TrainingWorkout);
+    DBTable structureWorkoutExercises = db->tableSchema(TypeBDEnum::WorkoutExercises);
 
     DBTable workouts(structureWorkout.getTableName());
     workouts.setColumns(structureWorkout.getColumnsNames());
@@ -277,9 +281,9 @@ void Init_Loader::loadTrainerAndAdmin(QSharedPointer<DBManager> db)
 {
 
 
-    DBTable usersS = db->get(TypeBDEnum::User);
-    DBTable trainersS = db->get(TypeBDEnum::Trainer);
-    DBTable adminsS = db->get(TypeBDEnum::Admin);
+    DBTable usersS = db->tableSchema(TypeBDEnum::User);
+    DBTable trainersS = db->tableSchema(TypeBDEnum::Trainer);
+    DBTable adminsS = db->tableSchema(TypeBDEnum::Admin);
 
     DBTable users(usersS.getTableName()); users.setColumns(usersS.getColumnsNames());
     DBTable trainers(trainersS.getTableName()); trainers.setColumns(trainersS.getColumnsNames());
@@ -308,8 +312,8 @@ void Init_Loader::loadTrainingSessions(QSharedPointer<DBManager> db)
 {
 
     // Obtener estructura de tablas
-    DBTable sesionS = db->get(TypeBDEnum::TrainingSesion);
-    DBTable reportS = db->get(TypeBDEnum::SesionReport);
+    DBTable sesionS = db->tableSchema(TypeBDEnum::TrainingSesion);
+    DBTable reportS = db->tableSchema(TypeBDEnum::SesionReport);
 
     DBTable sesiones(sesionS.getTableName()); sesiones.setColumns(sesionS.getColumnsNames());
     DBTable reportes(reportS.getTableName()); reportes.setColumns(reportS.getColumnsNames());
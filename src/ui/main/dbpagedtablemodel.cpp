@@ -0,0 +1,152 @@
+/**
+ * @file dbpagedtablemodel.cpp
+ * @brief Implementación de la clase DBPagedTableModel.
+ */
+
+#include "dbpagedtablemodel.h"
+#include "core/dbmanager.h"
+#include <QCoreApplication>
+#include <QPointer>
+#include <QThreadPool>
+
+DBPagedTableModel::DBPagedTableModel(QSharedPointer<DBConnectionPool> pool, QObject *parent)
+    : QAbstractTableModel(parent),
+    pool(pool)
+{
+}
+
+void DBPagedTableModel::setQuery(const DBPageRequest& request, const QStringList& headers)
+{
+    this->request = request;
+    this->request.limit = qMax(request.limit, 1);
+    colHeaders = headers;
+    reload();
+}
+
+void DBPagedTableModel::setFilter(int column, const QString& text)
+{
+    if (column < 0 || column >= request.columns.size()) return;
+
+    const QString& name = request.columns[column];
+    if (request.contains.value(name) == text) return;
+    if (text.isEmpty())
+        request.contains.remove(name);
+    else
+        request.contains.insert(name, text);
+    reload();
+}
+
+void DBPagedTableModel::sort(int column, Qt::SortOrder order)
+{
+    if (column < 0 || column >= request.columns.size()) return;
+    request.orderBy = request.columns[column];
+    request.order = order;
+    reload();
+}
+
+/**
+ * @brief Las páginas pedidas antes del reinicio llegarán con una generación antigua y se descartarán.
+ */
+void DBPagedTableModel::reload()
+{
+    beginResetModel();
+    pages.clear();
+    loadedRows = 0;
+    ++generation;
+    loading = false;
+    atEnd = false;
+    endResetModel();
+
+    fetchMore(QModelIndex());
+}
+
+int DBPagedTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : loadedRows;
+}
+
+int DBPagedTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : colHeaders.size();
+}
+
+void DBPagedTableModel::setDecoration(int column, DecorationProvider provider)
+{
+    decorationColumn = column;
+    decoration = std::move(provider);
+    if (loadedRows > 0 && column >= 0 && column < colHeaders.size())
+        emit dataChanged(index(0, column), index(loadedRows - 1, column), {Qt::DecorationRole});
+}
+
+/**
+ * @brief Recorre solo las filas cargadas, que son las únicas que las vistas pueden estar mostrando.
+ */
+void DBPagedTableModel::decorationChanged(const QVariant& key)
+{
+    if (decorationColumn < 0 || decorationColumn >= colHeaders.size()) return;
+    for (int row = 0; row < loadedRows; ++row) {
+        const QModelIndex cell = index(row, decorationColumn);
+        if (data(cell) == key) emit dataChanged(cell, cell, {Qt::DecorationRole});
+    }
+}
+
+QVariant DBPagedTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= loadedRows) return QVariant();
+
+    const DBTable& page = pages[index.row() / request.limit];
+    if (role == Qt::DecorationRole && index.column() == decorationColumn && decoration)
+        return decoration(page.value(index.row() % request.limit, index.column()));
+    if (role != Qt::DisplayRole && role != Qt::EditRole) return QVariant();
+
+    return page.value(index.row() % request.limit, index.column());
+}
+
+QVariant DBPagedTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal) return QVariant();
+    return colHeaders.value(section);
+}
+
+bool DBPagedTableModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && pool && !atEnd && !loading;
+}
+
+/**
+ * @brief La consulta se ejecuta en un hilo del pool global; el resultado vuelve al hilo del modelo por la cola
+ * de eventos y solo se aplica si el modelo sigue existiendo.
+ */
+void DBPagedTableModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent)) return;
+    loading = true;
+
+    DBPageRequest pageRequest = request;
+    pageRequest.offset = loadedRows;
+    const int pageGeneration = generation;
+    QSharedPointer<DBConnectionPool> readers = pool;
+    QPointer<DBPagedTableModel> self(this);
+
+    QThreadPool::globalInstance()->start([readers, pageRequest, pageGeneration, self]() {
+        DBTable page = readers->connection(DBConnectionPool::Mode::ReadOnly)->getPage(pageRequest);
+        QMetaObject::invokeMethod(qApp, [self, pageGeneration, page]() {
+            if (self) self->appendPage(pageGeneration, page);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void DBPagedTableModel::appendPage(int pageGeneration, const DBTable& page)
+{
+    if (pageGeneration != generation) return;
+
+    loading = false;
+    const int count = page.rowCount();
+    atEnd = count < request.limit;
+    if (count == 0) return;
+
+    beginInsertRows(QModelIndex(), loadedRows, loadedRows + count - 1);
+    pages.append(page);
+    loadedRows += count;
+    endInsertRows();
+}
@@ -0,0 +1,112 @@
+/**
+ * @file dbpagedtablemodel.h
+ * @brief Declaración de la clase DBPagedTableModel, modelo de tabla que carga sus filas por páginas.
+ *
+ * Las páginas se piden a la base de datos a medida que la vista se desplaza (`canFetchMore`/`fetchMore`) y se
+ * leen en un hilo del QThreadPool con una conexión de solo lectura del DBConnectionPool. El filtrado y la
+ * ordenación se traducen a la consulta SQL, por lo que abrir una tabla con muchas filas solo cuesta una página.
+ */
+
+#ifndef DBPAGEDTABLEMODEL_H
+#define DBPAGEDTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QList>
+#include <QSharedPointer>
+#include <QStringList>
+#include <functional>
+#include "db/dbconnectionpool.h"
+#include "db/dbpagerequest.h"
+#include "db/dbtable.h"
+
+/**
+ * @class DBPagedTableModel
+ * @brief Modelo de solo lectura sobre una tabla de la base de datos, cargado por páginas en segundo plano.
+ *
+ * Cada cambio de filtro u orden reinicia el modelo e invalida las páginas que aún estén en camino.
+ */
+class DBPagedTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructor.
+     * @param pool Pool del que se obtiene la conexión de lectura de cada hilo.
+     * @param parent Objeto padre.
+     */
+    explicit DBPagedTableModel(QSharedPointer<DBConnectionPool> pool, QObject *parent = nullptr);
+
+    /**
+     * @brief Fija la consulta base y los encabezados, y carga la primera página.
+     * @param request Tabla, columnas visibles, filtros fijos y tamaño de página. `offset` se ignora.
+     * @param headers Encabezados de las columnas, en el orden de `request.columns`.
+     */
+    void setQuery(const DBPageRequest& request, const QStringList& headers);
+
+    /**
+     * @brief Filtra por el texto contenido en una columna. Un texto vacío elimina el filtro de esa columna.
+     * @param column Índice de la columna.
+     * @param text Texto a buscar.
+     */
+    void setFilter(int column, const QString& text);
+
+    /**
+     * @brief Vuelve a cargar desde la primera página con la consulta actual.
+     */
+    void reload();
+
+    /// Función que devuelve la decoración (icono) de una fila a partir del valor de su columna clave.
+    using DecorationProvider = std::function<QVariant(const QVariant& key)>;
+
+    /**
+     * @brief Muestra en una columna la decoración que devuelve el proveedor para el valor de esa columna.
+     * @param column Índice de la columna clave, que también recibe la decoración.
+     * @param provider Proveedor de la decoración; se consulta al pintar cada fila.
+     */
+    void setDecoration(int column, DecorationProvider provider);
+
+    /**
+     * @brief Avisa a las vistas de que la decoración de las filas con un valor clave ha cambiado.
+     * @param key Valor de la columna clave.
+     */
+    void decorationChanged(const QVariant& key);
+
+    /// @copydoc QAbstractTableModel::rowCount
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /// @copydoc QAbstractTableModel::columnCount
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    /// @copydoc QAbstractTableModel::data
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    /// @copydoc QAbstractTableModel::headerData
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /// @copydoc QAbstractTableModel::canFetchMore
+    bool canFetchMore(const QModelIndex &parent) const override;
+
+    /// @copydoc QAbstractTableModel::fetchMore
+    void fetchMore(const QModelIndex &parent) override;
+
+    /// @copydoc QAbstractTableModel::sort
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+private:
+    QSharedPointer<DBConnectionPool> pool; ///< Conexiones de los hilos de lectura.
+    DBPageRequest request;                 ///< Consulta actual.
+    QStringList colHeaders;                ///< Encabezados de columna.
+    QList<DBTable> pages;                  ///< Páginas cargadas; todas salvo la última tienen `request.limit` filas.
+    int loadedRows = 0;                    ///< Filas cargadas.
+    int generation = 0;                    ///< Se incrementa en cada reinicio para descartar páginas antiguas.
+    bool loading = false;                  ///< Hay una página en camino.
+    bool atEnd = false;                    ///< La última página recibida estaba incompleta.
+    int decorationColumn = -1;             ///< Columna clave de la decoración (-1: sin decoración).
+    DecorationProvider decoration;         ///< Proveedor de la decoración.
+
+    /// Incorpora una página recibida del hilo de lectura.
+    void appendPage(int pageGeneration, const DBTable& page);
+};
+
+#endif // DBPAGEDTABLEMODEL_H
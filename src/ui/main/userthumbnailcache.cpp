@@ -0,0 +1,55 @@
+/**
+ * @file userthumbnailcache.cpp
+ * @brief Implementación de la clase UserThumbnailCache.
+ */
+
+#include "userthumbnailcache.h"
+#include <QCoreApplication>
+#include <QPointer>
+#include <QThreadPool>
+
+UserThumbnailCache::UserThumbnailCache(Loader loader, int maxKilobytes, QObject *parent)
+    : QObject(parent),
+    loader(std::move(loader))
+{
+    images.setMaxCost(qMax(maxKilobytes, 1));
+}
+
+/**
+ * @brief Consultar la caché marca la entrada como usada recientemente. Cada usuario tiene como mucho una carga
+ * en curso.
+ */
+QImage UserThumbnailCache::thumbnail(int idUser)
+{
+    if (const QImage* image = images.object(idUser)) return *image;
+    if (!loader || pending.contains(idUser)) return QImage();
+    const quint64 load = nextLoad++;
+    pending.insert(idUser, load);
+
+    Loader read = loader;
+    QPointer<UserThumbnailCache> self(this);
+    QThreadPool::globalInstance()->start([read, idUser, load, self]() {
+        const QImage image = read(idUser);
+        QMetaObject::invokeMethod(qApp, [self, idUser, load, image]() {
+            if (self) self->store(idUser, load, image);
+        }, Qt::QueuedConnection);
+    });
+    return QImage();
+}
+
+void UserThumbnailCache::invalidate(int idUser)
+{
+    images.remove(idUser);
+    pending.remove(idUser);
+}
+
+void UserThumbnailCache::store(int idUser, quint64 load, const QImage& image)
+{
+    auto it = pending.find(idUser);
+    if (it == pending.end() || it.value() != load) return;
+    pending.erase(it);
+
+    const int cost = qMax(1, static_cast<int>(image.sizeInBytes() / 1024));
+    images.insert(idUser, new QImage(image), cost);
+    emit thumbnailReady(idUser);
+}
@@ -0,0 +1,72 @@
+/**
+ * @file userthumbnailcache.h
+ * @brief Declaración de la clase UserThumbnailCache, caché LRU de las miniaturas de perfil de los usuarios.
+ *
+ * Los listados de usuarios solo leen las columnas de texto; la miniatura de cada fila se pide a esta caché al
+ * pintarla. Si no está, se carga en un hilo del QThreadPool y la caché avisa con thumbnailReady() cuando llega,
+ * de modo que abrir una lista con cientos de clientes no lee ninguna imagen hasta que sus filas se muestran.
+ */
+
+#ifndef USERTHUMBNAILCACHE_H
+#define USERTHUMBNAILCACHE_H
+
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <functional>
+
+/**
+ * @class UserThumbnailCache
+ * @brief Caché en memoria de miniaturas por ID de usuario, con expulsión de las menos usadas recientemente.
+ *
+ * El coste de cada entrada es el tamaño de la imagen en KB. También se guardan los usuarios sin imagen, para no
+ * volver a consultarlos.
+ */
+class UserThumbnailCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Función que lee la miniatura de un usuario. Se ejecuta en un hilo del QThreadPool.
+    using Loader = std::function<QImage(int idUser)>;
+
+    /**
+     * @brief Constructor.
+     * @param loader Lectura de la miniatura desde la base de datos.
+     * @param maxKilobytes Memoria máxima de las miniaturas guardadas.
+     * @param parent Objeto padre.
+     */
+    explicit UserThumbnailCache(Loader loader, int maxKilobytes = 4096, QObject *parent = nullptr);
+
+    /**
+     * @brief Devuelve la miniatura de un usuario si ya está cargada; si no, pide su carga en segundo plano.
+     * @param idUser ID del usuario.
+     * @return Miniatura, o imagen nula si aún no se ha cargado o el usuario no tiene imagen.
+     */
+    QImage thumbnail(int idUser);
+
+    /**
+     * @brief Descarta la miniatura de un usuario, por ejemplo tras cambiar su imagen.
+     * @param idUser ID del usuario.
+     */
+    void invalidate(int idUser);
+
+signals:
+    /**
+     * @brief Se emite cuando termina la carga de la miniatura de un usuario.
+     * @param idUser ID del usuario.
+     */
+    void thumbnailReady(int idUser);
+
+private:
+    Loader loader;               ///< Lectura de miniaturas.
+    QCache<int, QImage> images;  ///< Miniaturas cargadas, por ID de usuario.
+    QHash<int, quint64> pending; ///< Carga en curso de cada usuario; una invalidación la descarta.
+    quint64 nextLoad = 0;        ///< Identificador de la siguiente carga.
+
+    /// Guarda una miniatura recibida del hilo de lectura si su carga sigue vigente.
+    void store(int idUser, quint64 load, const QImage& image);
+};
+
+#endif // USERTHUMBNAILCACHE_H
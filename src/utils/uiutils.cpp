@@ -409,6 +409,67 @@ void UiUtils::showFilterPopup(QWidget* parent, QTableView* table, QSortFilterPro
 
     menu->exec(QCursor::pos());
 }
+/**
+ * @brief Muestra un popup de filtrado que traslada el texto a la consulta de un modelo paginado.
+ *
+ * El filtro se aplica cuando se deja de escribir durante un momento, para no relanzar la consulta en cada tecla.
+ * @param parent Widget padre.
+ * @param table Tabla a la que se aplica el filtro.
+ * @param model Modelo paginado de la tabla.
+ * @param logicalIndex Índice lógico de la columna a filtrar.
+ */
+void UiUtils::showFilterPopup(QWidget* parent, QTableView* table, DBPagedTableModel* model, int logicalIndex)
+{
+    if (!table || !model) return;
+
+    QMenu* menu = new QMenu(parent);
+    QWidgetAction* actionWidget = new QWidgetAction(menu);
+    QLineEdit* filterEdit = new QLineEdit(menu);
+    QTimer* debounce = new QTimer(menu);
+    debounce->setSingleShot(true);
+    debounce->setInterval(250);
+
+    filterEdit->setPlaceholderText("Filtrar...");
+    actionWidget->setDefaultWidget(filterEdit);
+    menu->addAction(actionWidget);
+
+    QPointer<DBPagedTableModel> target(model);
+    QObject::connect(filterEdit, &QLineEdit::textChanged, debounce, qOverload<>(&QTimer::start));
+    QObject::connect(debounce, &QTimer::timeout, filterEdit, [target, filterEdit, logicalIndex]() {
+        if (target) target->setFilter(logicalIndex, filterEdit->text());
+    });
+
+    menu->exec(QCursor::pos());
+    if (debounce->isActive() && target) target->setFilter(logicalIndex, filterEdit->text());
+}
+/**
+ * @brief Muestra junto al ID de cada usuario de un modelo paginado la miniatura de su imagen de perfil.
+ *
+ * Las miniaturas se piden a una caché LRU al pintar cada fila y se cargan en segundo plano, de modo que solo se
+ * leen las de las filas visibles.
+ * @param table Tabla que muestra el modelo.
+ * @param model Modelo paginado de usuarios.
+ * @param idColumn Columna con el ID de usuario.
+ * @param loader Lectura de la miniatura de un usuario.
+ * @return Caché creada, hija de la tabla, para invalidar las miniaturas que cambien.
+ */
+UserThumbnailCache* UiUtils::showUserThumbnails(QTableView* table, DBPagedTableModel* model, int idColumn, UserThumbnailCache::Loader loader)
+{
+    if (!table || !model) return nullptr;
+
+    UserThumbnailCache* cache = new UserThumbnailCache(std::move(loader), 4096, table);
+    QPointer<UserThumbnailCache> source(cache);
+    model->setDecoration(idColumn, [source](const QVariant& id) -> QVariant {
+        if (!source) return QVariant();
+        const QImage image = source->thumbnail(id.toInt());
+        return image.isNull() ? QVariant() : QVariant(image);
+    });
+    QObject::connect(cache, &UserThumbnailCache::thumbnailReady, model, [model](int idUser) {
+        model->decorationChanged(idUser);
+    });
+    table->setIconSize(QSize(32, 32));
+    return cache;
+}
 /**
  * @brief Llena la tabla con una lista de usuarios.
  * @param list Lista de punteros a objetos User.
@@ -11,6 +11,8 @@
 
 #include "profiles/user.h"
 #include "ui/main/uitablemodel.h"
+#include "ui/main/dbpagedtablemodel.h"
+#include "ui/main/userthumbnailcache.h"
 #include "db/dbtable.h"
 #include "workouts/workoutsummary.h"
 #include "workouts/exerciseespec.h"
@@ -24,6 +26,8 @@
 #include <QWidgetAction>
 #include <QLineEdit>
 #include <QCursor>
+#include <QTimer>
+#include <QPointer>
 #include "ui/main/comboboxdelegate.h"
 #include <QStandardItem>
 #include "enums/PoseViewEnum.h"
@@ -59,6 +63,8 @@ public:
 
     // Utilidades adicionales
     static void showFilterPopup(QWidget *parent, QTableView *table, QSortFilterProxyModel *proxy, int logicalIndex);
+    static void showFilterPopup(QWidget *parent, QTableView *table, DBPagedTableModel *model, int logicalIndex);
+    static UserThumbnailCache* showUserThumbnails(QTableView *table, DBPagedTableModel *model, int idColumn, UserThumbnailCache::Loader loader);
     static void populateEnumTable(QTableView* table, const QVariantMap& data, const QStringList& allFields);
     static QVariantMap tableToVariantMap(QTableView* table);
 };
@@ -16,7 +16,7 @@ TrainingSesion::TrainingSesion(QSharedPointer<ExerciseSummary> ex,QDateTime date
 /**
  * @brief Devuelve el informe detallado de la sesión (`SesionReport`).
  */
-SesionReport TrainingSesion::getReport() const
+const SesionReport& TrainingSesion::getReport() const
 {
     return report;
 }
@@ -28,6 +28,14 @@ void TrainingSesion::setReport(const SesionReport &newReport)
     report.setIdSesion(IdSesion);
     report = newReport;
 }
+/**
+ * @brief Establece el informe de la sesión transfiriendo su contenido sin copiarlo.
+ */
+void TrainingSesion::setReport(SesionReport &&newReport)
+{
+    report.setIdSesion(IdSesion);
+    report = std::move(newReport);
+}
 /**
  * @brief Devuelve la duración total de la sesión en milisegundos.
  */
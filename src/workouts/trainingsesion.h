@@ -34,8 +34,9 @@ public:
     TrainingSesion(QSharedPointer<ExerciseSummary> ex, QDateTime date, int idClient, int IdSesion = -1);
 
     /// Acceso al informe detallado de ejecución
-    SesionReport getReport() const;
+    const SesionReport& getReport() const;
     void setReport(const SesionReport &newReport);
+    void setReport(SesionReport &&newReport);
 
     /// Duración total de la sesión (en milisegundos)
     qint64 getDuration() const;
@@ -12,6 +12,9 @@
 #include <QTest>
 #include <QDebug>
 #include <QFile>
+#include <QDir>
+#include <QSignalSpy>
+#include "core/persistencemanager.h"
 
 void TestIntegracionTrainingRepositoryDB::initTestCase() {
     dbPath = "testdb.sqlite";
@@ -220,6 +223,44 @@ void TestIntegracionTrainingRepositoryDB::test_SaveAndGetWorkout_Valido() {
 }
 
 
+void TestIntegracionTrainingRepositoryDB::test_GetEspecs_Lote() {
+    QSharedPointer<ExerciseEspec> especA(new ExerciseEspec({}));
+    especA->setIdEx(-1);
+    especA->setName("LoteA");
+    State a1(-1,-1, 100, 300);
+    State a2(-1,-1, 200, 500);
+    a1.addAngleConstraint("LoteA,S0", AngleConstraint());
+    a2.addAngleConstraint("LoteA,S1", AngleConstraint());
+    especA->addState(a1);
+    especA->addState(a2);
+    especA->addTransition(qMakePair(0, 1), QSet<Condition>{ Condition(ConditionType::EndOfExercise, "LoteA 0->1") });
+
+    QSharedPointer<ExerciseEspec> especB(new ExerciseEspec({}));
+    especB->setIdEx(-1);
+    especB->setName("LoteB");
+    State b1(-1,-1, 150, 450);
+    b1.addAngleConstraint("LoteB,S0", AngleConstraint());
+    especB->addState(b1);
+
+    QVERIFY(repo->saveEspec(especA) != -1);
+    QVERIFY(repo->saveEspec(especB) != -1);
+
+    QHash<int, QSharedPointer<ExerciseEspec>> especs =
+        repo->getEspecs({especA->getIdEx(), especB->getIdEx(), 9999});
+
+    QCOMPARE(especs.size(), 2);
+    QVERIFY(!especs.contains(9999));
+
+    QSharedPointer<ExerciseEspec> ra = especs.value(especA->getIdEx());
+    QSharedPointer<ExerciseEspec> rb = especs.value(especB->getIdEx());
+    QVERIFY(ra != nullptr && rb != nullptr);
+    QCOMPARE(ra->getName(), QString("LoteA"));
+    QCOMPARE(ra->getStatesList().size(), 2);
+    QCOMPARE(rb->getStatesList().size(), 1);
+    QCOMPARE(rb->getStatesList().first().getMaxTime(), 450);
+    QVERIFY(rb->getStatesList().first().getConstraints().contains("LoteB,S0"));
+}
+
 void TestIntegracionTrainingRepositoryDB::test_DeleteWorkoutFull() {
     QSharedPointer<ExerciseEspec> espec(new ExerciseEspec({}));
 
@@ -290,6 +331,12 @@ void TestIntegracionTrainingRepositoryDB::test_SaveAndGet_TrainingSesion()
     report.addCondition(0, 2,0, Condition(ConditionType::EndOfRepetition, "R_Ankle-R_Hip"));
     report.addCondition(0, 2,0, Condition(ConditionType::EndOfExercise,   "R_Ankle-R_Hip"));
 
+    LineStats knee;
+    for (double a : {90.0, 120.0, 150.0}) knee.add(a);
+    report.setRepetitionStats(0, 1, {{PoseView::Front, {{"L_Knee-L_Hip", knee}}}});
+    report.angleAccumulator().addAngles(0, 1, 0, PoseView::Front, {{"L_Knee-L_Hip", 95.5}});
+    report.angleAccumulator().setOverload(0, 1, 0, PoseView::Front, "L_Knee-L_Hip", 12.5);
+
     sesion->setReport(report);
 
     QVERIFY(repo->SaveTrainingSesion(sesion));
@@ -308,6 +355,19 @@ void TestIntegracionTrainingRepositoryDB::test_SaveAndGet_TrainingSesion()
 
 
     SesionReport r = recuperada->getReport();
+    LineStats kneeStats = r.getRepetitionStats(0, 1).value(PoseView::Front).value("L_Knee-L_Hip");
+    QCOMPARE(kneeStats.count, 3);
+    QCOMPARE(kneeStats.min, 90.0);
+    QCOMPARE(kneeStats.max, 150.0);
+    QCOMPARE(kneeStats.mean, 120.0);
+
+    // El log se guarda como texto y al recuperarlo debe coincidir con el generado desde los eventos
+    QCOMPARE(r.getLog(), report.getLog());
+    QCOMPARE(r.parseLog().size(), report.parseLog().size());
+    QCOMPARE(report.getConditions(0, 2).size(), 4);
+    QCOMPARE(r.getConditions(0, 2).size(), 4);
+    QCOMPARE(r.getGlobalAngleRange()[0][1][0][PoseView::Front].value("L_Knee-L_Hip").first, 95.5);
+    QCOMPARE(r.getGlobalAngleOverloads()[0][1][0][PoseView::Front].value("L_Knee-L_Hip"), 12.5);
     // QCOMPARE(r.getConditionCount(0, 1, "L_Knee-L_Hip", ConditionType::EndOfRepetition), 2);
     // QCOMPARE(r.getConditionCount(0, 1, "L_Knee-L_Hip", ConditionType::EndOfSet),        1);
     // QCOMPARE(r.getConditionCount(0, 2, "R_Ankle-R_Hip", ConditionType::EndOfRepetition), 3);
@@ -315,3 +375,34 @@ void TestIntegracionTrainingRepositoryDB::test_SaveAndGet_TrainingSesion()
 
 }
 
+void TestIntegracionTrainingRepositoryDB::test_SaveTrainingSesion_SegundoPlano()
+{
+    QSharedPointer<ExerciseSummary> summary(new ExerciseSummary(6, "Zancada", "Piernas alternas", "Fuerza", "Glúteos"));
+    QSharedPointer<TrainingSesion> sesion(new TrainingSesion(summary, QDateTime::currentDateTime(), 43));
+    sesion->setDuration(30000);
+
+    DBWriteBatch batch;
+    QVERIFY(repo->buildSesionBatch(sesion, batch));
+    QVERIFY(sesion->getIdSesion() != -1);
+
+    const QString journalPath = "testjournal";
+    QDir(journalPath).removeRecursively();
+    {
+        PersistenceManager persistence(dbPath, journalPath);
+        QSignalSpy escritos(&persistence, &PersistenceManager::batchWritten);
+
+        QVERIFY(persistence.enqueue(batch));
+        QCOMPARE(QDir(journalPath).entryList(QDir::Files).size(), 1);
+
+        QVERIFY(escritos.wait(5000));
+        QCOMPARE(persistence.pendingCount(), 0);
+    }
+    QCOMPARE(QDir(journalPath).entryList(QDir::Files).size(), 0);
+
+    QSharedPointer<TrainingSesion> recuperada = repo->getTrainingSesion(sesion->getIdSesion());
+    QVERIFY(recuperada != nullptr);
+    QCOMPARE(recuperada->getIdClient(), 43);
+    QCOMPARE(recuperada->getExerciseSummary()->getName(), QString("Zancada"));
+
+    QDir(journalPath).removeRecursively();
+}
@@ -42,6 +42,9 @@ private slots:
     /** @test Verifica que se guarda y recupera un workout correctamente */
     void test_SaveAndGetWorkout_Valido();
 
+    /** @test Verifica que varias especificaciones se cargan en lote, cada una con sus propios estados */
+    void test_GetEspecs_Lote();
+
     /** @test Verifica eliminación completa de un workout */
     void test_DeleteWorkoutFull();
 
@@ -49,6 +52,9 @@ private slots:
     //void test_SaveTrainingSesion();
     void test_SaveAndGet_TrainingSesion();
 
+    /** @test Verifica que una sesión encolada en PersistenceManager se guarda en segundo plano y su entrada del diario se borra */
+    void test_SaveTrainingSesion_SegundoPlano();
+
 };
 
 #endif // TESTINTEGRACIONTRAININGREPOSITORYDB_H
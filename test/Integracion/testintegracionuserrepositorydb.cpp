@@ -278,3 +278,37 @@ void TestIntegracionUserRepositoryDB::test_GetClientProfile() {
     qDebug() << "[Tabla general_records tras insertar]";
     db->get(TypeBDEnum::ProfileGeneral).print();
 }
+
+/**
+ * @test Verifica el almacenamiento separado de la imagen de perfil y su miniatura.
+ */
+void TestIntegracionUserRepositoryDB::test_ProfilePicture() {
+    QHash<UserField, QVariant> data;
+    data[UserField::IdUser] = 40;
+    data[UserField::UserName] = "foto";
+    data[UserField::Email] = "foto@correo.com";
+    data[UserField::Pass] = "clave";
+
+    QSharedPointer<Client> client(new Client(data));
+    client->setUserType(UserType::Client);
+    QImage picture(200, 100, QImage::Format_ARGB32);
+    picture.fill(Qt::blue);
+    client->setProfile_Picture(picture);
+    QVERIFY(repo->saveUser(client));
+
+    // La fila de users no lleva la imagen
+    DBTable users = db->get(TypeBDEnum::User, DBFilter::IdUser, "40");
+    QCOMPARE(users.rowCount(), 1);
+    QVERIFY(users.value(0, "profile_picture").isNull());
+
+    QSharedPointer<User> loaded = repo->getUserById(40);
+    QVERIFY(loaded != nullptr);
+    QCOMPARE(loaded->getProfile_Picture().size(), QSize(200, 100));
+
+    QImage thumbnail = repo->getUserThumbnail(40);
+    QCOMPARE(thumbnail.size(), QSize(UserRepository::thumbnailSize, UserRepository::thumbnailSize / 2));
+    QVERIFY(repo->getUserThumbnail(404).isNull());
+
+    QVERIFY(repo->deleteUser(40));
+    QVERIFY(repo->getUserThumbnail(40).isNull());
+}
@@ -64,6 +64,12 @@ private slots:
      * @test Verifica que se puede recuperar el perfil completo de un cliente.
      */
     void test_GetClientProfile();
+
+    /**
+     * @test Verifica que la imagen de perfil se guarda fuera de la tabla users, se recupera al cargar el usuario
+     * y tiene una miniatura reducida.
+     */
+    void test_ProfilePicture();
 };
 
 #endif // TEST_INTEGRACION_USERREPOSITORY_DB_H
@@ -54,6 +54,38 @@ DBTable FakeDBManager::get(TypeBDEnum tipo, DBFilter filtro,  QString valorFiltr
 
     return tablaF;
 }
+/**
+ * @brief Devuelve las filas de la tabla simulada cuyo campo de filtro está en la lista.
+ */
+DBTable FakeDBManager::get(TypeBDEnum tipo, DBFilter filtro, const QStringList& listaValores) {
+
+    QString tableName = TypeBDEnumToString(tipo);
+    DBTable tabla = testTables.value(tipo, DBTable(tableName));
+
+    if (filtro == DBFilter::none || listaValores.isEmpty()) return tabla;
+
+    QString campo = BDFilterToString(filtro);
+    QStringList columnas = tabla.getColumnsNames();
+    if (!columnas.contains(campo,Qt::CaseInsensitive)) return DBTable(tableName);
+
+    DBTable tablaF(tableName);
+    tablaF.setColumns(columnas);
+    for (int i = 0; i < tabla.rowCount(); ++i) {
+        if (listaValores.contains(tabla.value(i, campo).toString()))
+            tablaF.addRow(tabla.getRow(i));
+    }
+    return tablaF;
+}
+/**
+ * @brief Devuelve una tabla vacía con las columnas de la tabla simulada.
+ */
+DBTable FakeDBManager::tableSchema(TypeBDEnum tipo) {
+    QString tableName = TypeBDEnumToString(tipo);
+    DBTable tabla(tableName);
+    tabla.setColumns(testTables.value(tipo, DBTable(tableName)).getColumnsNames());
+    return tabla;
+}
+
 /**
  * @brief Simula el guardado de una tabla para un tipo dado.
  */
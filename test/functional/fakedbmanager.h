@@ -38,6 +38,14 @@ public:
      * @return Tabla simulada del tipo solicitado.
      */
     DBTable get(TypeBDEnum tipo, DBFilter filtro=DBFilter::none, const QString valorFiltro="")  override;
+    /**
+     * @brief Simula la obtención de una tabla filtrando por una lista de valores.
+     * @param tipo Tipo de entidad (tabla).
+     * @param filtro Tipo de filtro.
+     * @param listaValores Valores aceptados del filtro.
+     * @return Filas de la tabla simulada cuyo campo coincide con alguno de los valores.
+     */
+    DBTable get(TypeBDEnum tipo, DBFilter filtro, const QStringList& listaValores) override;
     /**
      * @brief Simula el guardado de una tabla.
      * @param tipo Tipo de entidad.
@@ -55,6 +63,12 @@ public:
      * @return true si se eliminó la tabla.
      */
    bool deleteRow(TypeBDEnum tipo, DBFilter filtro,  QString& valorFiltro)override;
+    /**
+     * @brief Simula la lectura del esquema de una tabla.
+     * @param tipo Tipo de entidad.
+     * @return Tabla vacía con las columnas de la tabla simulada.
+     */
+    DBTable tableSchema(TypeBDEnum tipo) override;
     /**
      * @brief Establece una tabla simulada para un tipo determinado.
      * @param tipo Tipo de entidad.
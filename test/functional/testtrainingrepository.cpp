@@ -55,6 +55,12 @@ void TestTrainingRepository::initTestCase() {
     DBTable sessionTable("TrainingSesion");
     sessionTable.setColumns({"idSesion", "idClient", "idExercise", "date", "duration"});
     fakeDB->setTestTable(TypeBDEnum::TrainingSesion,sessionTable);
+
+    DBTable trendTable("SesionSummary");
+    trendTable.setColumns({"idSesion", "idClient", "idWorkout", "idEx", "date", "day", "week", "duration",
+                           "repetitions", "timeUnderTension", "criticalCount", "alertCount", "infoCount",
+                           "overloadCount", "romMean", "lineStats"});
+    fakeDB->setTestTable(TypeBDEnum::SesionSummary,trendTable);
 }
 
 void TestTrainingRepository::cleanupTestCase() {
@@ -5,6 +5,12 @@
 #include "testdb.h"
 #include "testfitnesstrainer.h"
 #include "testpose.h"
+#include "teststate.h"
+#include "testangleaccumulator.h"
+#include "testkinematicstracker.h"
+#include "testangleseriesrecorder.h"
+#include "testfeedbackaggregator.h"
+#include "testfeedbackmessagetable.h"
 #include "Sqlite3_Test.h"
 #include "testexerciseespec.h"
 #include "testdbtable.h"
@@ -55,6 +61,18 @@ int main(int argc, char *argv[]) {
     status |= QTest::qExec(&testUserPreferences, argc, argv);
 
      //Tests de las clases de pose
+    TestState testState;
+    status |= QTest::qExec(&testState, argc, argv);
+    TestAngleAccumulator testAngleAccumulator;
+    status |= QTest::qExec(&testAngleAccumulator, argc, argv);
+    TestKinematicsTracker testKinematicsTracker;
+    status |= QTest::qExec(&testKinematicsTracker, argc, argv);
+    TestAngleSeriesRecorder testAngleSeriesRecorder;
+    status |= QTest::qExec(&testAngleSeriesRecorder, argc, argv);
+    TestFeedbackAggregator testFeedbackAggregator;
+    status |= QTest::qExec(&testFeedbackAggregator, argc, argv);
+    TestFeedbackMessageTable testFeedbackMessageTable;
+    status |= QTest::qExec(&testFeedbackMessageTable, argc, argv);
     //TestPose testPose;
     //status |= QTest::qExec(&testPose, argc, argv);
 
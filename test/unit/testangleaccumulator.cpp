@@ -0,0 +1,82 @@
+#include "testangleaccumulator.h"
+#include "pose/angleaccumulator.h"
+#include "pose/linestats.h"
+#include <QtTest>
+
+/**
+ * @brief Codo: 90, 75, 120, 60, 100 (mínimo 60, máximo 120, media 89); rodilla: 170, 150, 165, 155, 160 (mínimo 150,
+ * máximo 170, media 160).
+ */
+void TestAngleAccumulator::test_RangoSerieConocida() {
+    AngleAccumulator acc(2, 3, {10, 20}, {"codo"});
+    QVERIFY(acc.isEmpty());
+
+    const QList<double> codo = {90, 75, 120, 60, 100};
+    const QList<double> rodilla = {170, 150, 165, 155, 160};
+    LineStats statsCodo;
+    LineStats statsRodilla;
+    for (int i = 0; i < codo.size(); ++i) {
+        acc.addAngles(1, 2, 10, PoseView::Front, {{"codo", codo[i]}, {"rodilla", rodilla[i]}});
+        statsCodo.add(codo[i]);
+        statsRodilla.add(rodilla[i]);
+    }
+    QVERIFY(!acc.isEmpty());
+
+    const auto ranges = acc.toRangeMap();
+    QCOMPARE(ranges[1][2][10][PoseView::Front].value("codo"), qMakePair(60.0, 120.0));
+    QCOMPARE(ranges[1][2][10][PoseView::Front].value("rodilla"), qMakePair(150.0, 170.0));
+    // Solo aparece la celda con datos
+    QCOMPARE(ranges.size(), 1);
+    QCOMPARE(ranges[1].size(), 1);
+    QCOMPARE(ranges[1][2].size(), 1);
+    QVERIFY(!ranges[1][2][10].contains(PoseView::Left));
+
+    QCOMPARE(statsCodo.min, 60.0);
+    QCOMPARE(statsCodo.max, 120.0);
+    QCOMPARE(statsCodo.mean, 89.0);
+    QCOMPARE(statsRodilla.mean, 160.0);
+    QCOMPARE(statsRodilla.variance(), 62.5);
+}
+
+/**
+ * @brief Tras acumular en la celda (1,1,10), se escribe en la serie 5, la repetición 7, el estado 30 y una línea
+ * nueva; el rango inicial se conserva.
+ */
+void TestAngleAccumulator::test_CrecimientoConservaDatos() {
+    AngleAccumulator acc(1, 1, {10}, {"codo"});
+    acc.addAngles(1, 1, 10, PoseView::Front, {{"codo", 80}});
+    acc.addAngles(1, 1, 10, PoseView::Front, {{"codo", 95}});
+
+    acc.addAngles(5, 7, 30, PoseView::Left, {{"hombro", 45}});
+    acc.setRange(2, 1, 10, PoseView::Front, "cadera", 30, 110);
+
+    const auto ranges = acc.toRangeMap();
+    QCOMPARE(ranges[1][1][10][PoseView::Front].value("codo"), qMakePair(80.0, 95.0));
+    QCOMPARE(ranges[5][7][30][PoseView::Left].value("hombro"), qMakePair(45.0, 45.0));
+    QCOMPARE(ranges[2][1][10][PoseView::Front].value("cadera"), qMakePair(30.0, 110.0));
+    QVERIFY(!ranges[1][1][10][PoseView::Front].contains("hombro"));
+
+    // Los índices negativos se ignoran
+    acc.addAngles(-1, 1, 10, PoseView::Front, {{"codo", 10}});
+    QCOMPARE(acc.toRangeMap()[1][1][10][PoseView::Front].value("codo"), qMakePair(80.0, 95.0));
+}
+
+/**
+ * @brief Dos sobrecargas seguidas dejan la última; clearRanges() conserva las sobrecargas y clear() lo vacía todo.
+ */
+void TestAngleAccumulator::test_SobrecargasYLimpieza() {
+    AngleAccumulator acc(1, 1, {10}, {"codo"});
+    acc.addAngles(1, 1, 10, PoseView::Front, {{"codo", 150}});
+    acc.setOverload(1, 1, 10, PoseView::Front, "codo", 5);
+    acc.setOverload(1, 1, 10, PoseView::Front, "codo", 12);
+    QCOMPARE(acc.toOverloadMap()[1][1][10][PoseView::Front].value("codo"), 12.0);
+
+    acc.clearRanges();
+    QVERIFY(!acc.isEmpty());
+    QVERIFY(acc.toRangeMap().isEmpty());
+    QCOMPARE(acc.toOverloadMap()[1][1][10][PoseView::Front].value("codo"), 12.0);
+
+    acc.clear();
+    QVERIFY(acc.isEmpty());
+    QVERIFY(acc.toOverloadMap().isEmpty());
+}
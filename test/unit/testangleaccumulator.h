@@ -0,0 +1,36 @@
+#ifndef TESTANGLEACCUMULATOR_H
+#define TESTANGLEACCUMULATOR_H
+
+#include <QObject>
+
+/**
+ * @file testangleaccumulator.h
+ * @brief Declaración de la clase de test unitario para AngleAccumulator.
+ *
+ * Comprueba que el tensor acumula el mínimo y el máximo de una serie conocida de ángulos, junto con la media de
+ * los estadísticos por repetición, que crecer más allá de las dimensiones iniciales conserva los datos y que las
+ * sobrecargas y la limpieza se comportan de forma independiente.
+ */
+class TestAngleAccumulator : public QObject {
+    Q_OBJECT
+
+private slots:
+
+    /**
+     * @brief Caja negra: una serie conocida de ángulos da su mínimo, su máximo y su media.
+     */
+    void test_RangoSerieConocida();
+
+    /**
+     * @brief Caja blanca: una serie, repetición, estado o línea fuera de las dimensiones iniciales amplía el
+     * tensor sin perder los valores acumulados.
+     */
+    void test_CrecimientoConservaDatos();
+
+    /**
+     * @brief Caja negra: la sobrecarga guarda el último valor y limpiar los rangos no borra las sobrecargas.
+     */
+    void test_SobrecargasYLimpieza();
+};
+
+#endif // TESTANGLEACCUMULATOR_H
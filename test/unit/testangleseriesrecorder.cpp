@@ -0,0 +1,178 @@
+#include "testangleseriesrecorder.h"
+#include "pose/angleseriesrecorder.h"
+#include <QDataStream>
+#include <QtTest>
+#include <cmath>
+#include <memory>
+
+/**
+ * @brief Con resolución de 0.01° el error máximo es 0.005°.
+ */
+void TestAngleSeriesRecorder::test_RecuperacionCuantizada() {
+    AngleSeriesRecorder recorder(1024 * 1024, 16, 0.01);
+
+    for (int i = 0; i < 100; ++i)
+        recorder.record(PoseView::Front, 1, 1, i * 33, {{"codo", 90.0 + 40.0 * std::sin(i * 0.1)}});
+
+    QCOMPARE(recorder.frameCount(PoseView::Front), 100);
+    QList<AngleFrame> frames = recorder.frames(PoseView::Front, 0, 99 * 33);
+    QCOMPARE(frames.size(), 100);
+    for (int i = 0; i < frames.size(); ++i) {
+        QCOMPARE(frames[i].time, static_cast<int64_t>(i * 33));
+        QVERIFY(qAbs(frames[i].angles.value("codo") - (90.0 + 40.0 * std::sin(i * 0.1))) <= 0.005 + 1e-9);
+    }
+}
+
+/**
+ * @brief Un instante entre dos frames devuelve el anterior; uno previo al primero no devuelve nada.
+ */
+void TestAngleSeriesRecorder::test_AccesoPorTimestamp() {
+    AngleSeriesRecorder recorder(1024 * 1024, 8, 0.01);
+
+    for (int i = 0; i < 50; ++i)
+        recorder.record(PoseView::Left, 1, 1, 1000 + i * 40, {{"rodilla", 10.0 + i}});
+
+    AngleFrame frame;
+    QVERIFY(!recorder.frameAt(PoseView::Left, 999, frame));
+    QVERIFY(!recorder.frameAt(PoseView::Front, 2000, frame));
+
+    QVERIFY(recorder.frameAt(PoseView::Left, 1000 + 20 * 40 + 15, frame));
+    QCOMPARE(frame.time, static_cast<int64_t>(1000 + 20 * 40));
+    QVERIFY(qAbs(frame.angles.value("rodilla") - 30.0) < 1e-9);
+}
+
+/**
+ * @brief Tres repeticiones de 30 frames: cada consulta devuelve exactamente los suyos.
+ */
+void TestAngleSeriesRecorder::test_AccesoPorRepeticion() {
+    AngleSeriesRecorder recorder(1024 * 1024, 16, 0.01);
+
+    for (int i = 0; i < 90; ++i)
+        recorder.record(PoseView::Front, 2, 1 + i / 30, i * 33, {{"hombro", static_cast<double>(i)}});
+
+    QList<AngleFrame> rep2 = recorder.framesFor(PoseView::Front, 2, 2);
+    QCOMPARE(rep2.size(), 30);
+    QCOMPARE(rep2.first().time, static_cast<int64_t>(30 * 33));
+    QCOMPARE(rep2.last().time, static_cast<int64_t>(59 * 33));
+    for (const AngleFrame& f : rep2) {
+        QCOMPARE(f.serie, 2);
+        QCOMPARE(f.rep, 2);
+    }
+    QVERIFY(recorder.framesFor(PoseView::Front, 1, 1).isEmpty());
+}
+
+/**
+ * @brief Una línea que falta en un frame o que aparece a mitad de sesión se decodifica correctamente.
+ */
+void TestAngleSeriesRecorder::test_LineasAusentes() {
+    AngleSeriesRecorder recorder(1024 * 1024, 16, 0.01);
+
+    recorder.record(PoseView::Front, 1, 1, 0, {{"a", 10.0}, {"b", 20.0}});
+    recorder.record(PoseView::Front, 1, 1, 33, {{"a", 11.0}});
+    recorder.record(PoseView::Front, 1, 1, 66, {{"a", 12.0}, {"b", 22.0}, {"c", 30.0}});
+
+    QList<AngleFrame> frames = recorder.frames(PoseView::Front, 0, 100);
+    QCOMPARE(frames.size(), 3);
+    QVERIFY(!frames[1].angles.contains("b"));
+    QVERIFY(qAbs(frames[1].angles.value("a") - 11.0) < 1e-9);
+    QVERIFY(qAbs(frames[2].angles.value("b") - 22.0) < 1e-9);
+    QVERIFY(qAbs(frames[2].angles.value("c") - 30.0) < 1e-9);
+    QCOMPARE(recorder.getLines(PoseView::Front).size(), 3);
+}
+
+/**
+ * @brief Con un presupuesto de 256 bytes casi todo se vuelca y los datos se recuperan igual.
+ */
+void TestAngleSeriesRecorder::test_VolcadoADisco() {
+    AngleSeriesRecorder recorder(256, 16, 0.01);
+
+    for (int i = 0; i < 500; ++i)
+        recorder.record(PoseView::Right, 1, 1 + i / 100, i * 33, {{"cadera", 100.0 + (i % 50)}, {"tobillo", 80.0 - (i % 20)}});
+
+    QVERIFY(recorder.memoryUsage() < recorder.compressedSize());
+
+    AngleFrame frame;
+    QVERIFY(recorder.frameAt(PoseView::Right, 10 * 33, frame));
+    QVERIFY(qAbs(frame.angles.value("cadera") - 110.0) < 1e-9);
+    QVERIFY(qAbs(frame.angles.value("tobillo") - 70.0) < 1e-9);
+    QCOMPARE(recorder.framesFor(PoseView::Right, 1, 3).size(), 100);
+
+    recorder.clear();
+    QVERIFY(recorder.isEmpty());
+}
+
+/**
+ * @brief Tras copiar una grabación con bloques en disco, los frames que se añaden al original no aparecen en la
+ * copia, y borrar el original no impide leer la copia.
+ */
+void TestAngleSeriesRecorder::test_CopiaIndependiente() {
+    auto original = std::make_unique<AngleSeriesRecorder>(256, 16, 0.01);
+    for (int i = 0; i < 500; ++i)
+        original->record(PoseView::Right, 1, 1 + i / 100, i * 33, {{"cadera", 100.0 + (i % 50)}});
+    QVERIFY(original->memoryUsage() < original->compressedSize());
+
+    AngleSeriesRecorder copia(*original);
+    QCOMPARE(copia.frameCount(PoseView::Right), 500);
+    QCOMPARE(copia.compressedSize(), original->compressedSize());
+    QVERIFY(copia.memoryUsage() < copia.compressedSize());
+
+    original->record(PoseView::Right, 2, 1, 500 * 33, {{"cadera", 90.0}});
+    QCOMPARE(original->frameCount(PoseView::Right), 501);
+    QCOMPARE(copia.frameCount(PoseView::Right), 500);
+
+    original.reset();
+    AngleFrame frame;
+    QVERIFY(copia.frameAt(PoseView::Right, 10 * 33, frame));
+    QVERIFY(qAbs(frame.angles.value("cadera") - 110.0) < 1e-9);
+    QCOMPARE(copia.framesFor(PoseView::Right, 1, 1).size(), 100);
+    QVERIFY(copia.framesFor(PoseView::Right, 2, 1).isEmpty());
+}
+
+namespace {
+
+/// Serializa a mano una grabación con un único bloque en la vista frontal y el resto de vistas vacías.
+QByteArray bloqueFrontal(const QStringList& lines, const QMap<QPair<int, int>, QList<int>>& repBlocks,
+                         qint32 frames, qint32 lineCount, const QByteArray& data)
+{
+    QByteArray out;
+    QDataStream stream(&out, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << quint16(1) << 0.01 << qint32(16);
+    stream << lines << repBlocks << frames << quint32(1);
+    stream << qint64(0) << qint64(0) << qint32(1) << qint32(1) << frames << lineCount << data;
+    for (int v = 1; v < 5; ++v)
+        stream << QStringList() << QMap<QPair<int, int>, QList<int>>() << qint32(0) << quint32(0);
+    return out;
+}
+
+}
+
+/**
+ * @brief Se rechazan un bloque con más líneas que el diccionario, un recuento de frames negativo, un índice de
+ * repetición sin bloque y un blob cortado a la mitad. Un frame incompleto cuyo mapa de presencia no cabe en el
+ * bloque detiene la decodificación.
+ */
+void TestAngleSeriesRecorder::test_DatosCorruptos() {
+    const QMap<QPair<int, int>, QList<int>> reps = {{qMakePair(1, 1), {0}}};
+    const QByteArray frame("\x00\x00\x00\x00\x02", 5);
+    AngleSeriesRecorder recorder;
+
+    QVERIFY(recorder.deserialize(bloqueFrontal({"codo"}, reps, 1, 1, frame)));
+    QCOMPARE(recorder.framesFor(PoseView::Front, 1, 1).size(), 1);
+
+    QVERIFY(!recorder.deserialize(bloqueFrontal({"codo"}, reps, 1, 3, frame)));
+    QVERIFY(recorder.isEmpty());
+    QVERIFY(!recorder.deserialize(bloqueFrontal({"codo"}, reps, -1, 1, frame)));
+    QVERIFY(!recorder.deserialize(bloqueFrontal({"codo"}, {{qMakePair(1, 1), {1}}}, 1, 1, frame)));
+
+    AngleSeriesRecorder source(1024 * 1024, 8, 0.01);
+    for (int i = 0; i < 40; ++i)
+        source.record(PoseView::Front, 1, 1, i * 33, {{"codo", 90.0 + i}});
+    const QByteArray valid = source.serialize();
+    QVERIFY(!recorder.deserialize(valid.left(valid.size() / 2)));
+
+    // Frame incompleto (marca 1) de 9 líneas sin los 2 bytes del mapa de presencia
+    const QStringList nine = {"a", "b", "c", "d", "e", "f", "g", "h", "i"};
+    QVERIFY(recorder.deserialize(bloqueFrontal(nine, reps, 2, 9, QByteArray("\x00\x00\x00\x01", 4))));
+    QVERIFY(recorder.framesFor(PoseView::Front, 1, 1).isEmpty());
+}
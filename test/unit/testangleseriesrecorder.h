@@ -0,0 +1,57 @@
+#ifndef TESTANGLESERIESRECORDER_H
+#define TESTANGLESERIESRECORDER_H
+
+#include <QObject>
+
+/**
+ * @file testangleseriesrecorder.h
+ * @brief Declaración de la clase de test unitario para AngleSeriesRecorder.
+ *
+ * Comprueba que los ángulos se recuperan con el error de cuantización esperado, que el acceso por
+ * timestamp y por repetición devuelve los frames correctos y que los bloques volcados a disco se siguen
+ * leyendo igual.
+ */
+class TestAngleSeriesRecorder : public QObject {
+    Q_OBJECT
+
+private slots:
+
+    /**
+     * @brief Caja negra: los ángulos recuperados difieren como máximo media resolución de los registrados.
+     */
+    void test_RecuperacionCuantizada();
+
+    /**
+     * @brief Caja negra: frameAt() devuelve el último frame anterior o igual al instante pedido.
+     */
+    void test_AccesoPorTimestamp();
+
+    /**
+     * @brief Caja negra: framesFor() devuelve solo los frames de la serie y repetición indicadas.
+     */
+    void test_AccesoPorRepeticion();
+
+    /**
+     * @brief Caja blanca: las líneas ausentes en un frame no aparecen al decodificarlo.
+     */
+    void test_LineasAusentes();
+
+    /**
+     * @brief Caja blanca: con un presupuesto pequeño los bloques se vuelcan a disco y siguen siendo legibles.
+     */
+    void test_VolcadoADisco();
+
+    /**
+     * @brief Caja blanca: una copia lee los bloques volcados del original y no comparte con él ni los frames nuevos
+     * ni el fichero de volcado.
+     */
+    void test_CopiaIndependiente();
+
+    /**
+     * @brief Valores límite: un bloque serializado truncado o con índices fuera de rango se rechaza o se decodifica
+     * hasta donde llega, sin leer fuera de los datos.
+     */
+    void test_DatosCorruptos();
+};
+
+#endif // TESTANGLESERIESRECORDER_H
@@ -1,4 +1,11 @@
 #include "testdb.h"
+#include "db/dbtransaction.h"
+#include "db/dbmigrations.h"
+#include "db/dbconnectionpool.h"
+#include "db/dbhandle.h"
+#include "pose/sesionsummary.h"
+#include <QSqlQuery>
+#include <QSqlRecord>
 
 void TestDB::initTestCase() {
     dbPath = "testdb.sqlite";
@@ -174,3 +181,348 @@ void TestDB::testIsValidFilterForTable() {
     QVERIFY(!invalido); // Debe ser false porque "idUser" no está en esa tabla
 }
 
+void TestDB::testPreparedStatementCache() {
+    DBTable tabla("exercise_espec");
+    tabla.setColumns(QStringList() << "idEx" << "Name" << "Description" << "ExerciseType" << "TargetMuscle" << "Equipment" << "Series" << "Repetitions" << "Duration" << "Weight" << "RestTime");
+    tabla.addRow({120, "Press d'Arnold", "Desc", "fuerza", "hombro", "mancuernas", 3, 10, 60, 20, 90});
+    QVERIFY(dbManager->save(TypeBDEnum::ExerciseEspec, tabla));
+
+    DBTable resultado = dbManager->get(TypeBDEnum::ExerciseEspec, DBFilter::Name, "Press d'Arnold");
+    QCOMPARE(resultado.rowCount(), 1);
+    QCOMPARE(resultado.value(0, "Name").toString(), QString("Press d'Arnold"));
+
+    int sentencias = dbManager->statementCache.size();
+    DBTable repetido = dbManager->get(TypeBDEnum::ExerciseEspec, DBFilter::Name, "Press d'Arnold");
+    QCOMPARE(repetido.rowCount(), 1);
+    QCOMPARE(dbManager->statementCache.size(), sentencias);
+
+    // Con la caché casi llena, el guardado con filtro la vacía mientras prepara sus sentencias y sigue usando
+    // las que ya había obtenido
+    dbManager->clearStatementCache();
+    for (int i = 0; dbManager->statementCache.size() < DBManager::maxCachedStatements - 1; ++i)
+        QVERIFY(dbManager->preparedQuery(QString("SELECT %1").arg(i)));
+    DBTable cambio("exercise_espec");
+    cambio.setColumns(tabla.getColumnsNames());
+    cambio.addRow({120, "Press d'Arnold", "Otra desc", "fuerza", "hombro", "mancuernas", 4, 8, 60, 22, 90});
+    QVERIFY(dbManager->save(TypeBDEnum::ExerciseEspec, cambio, DBFilter::Name, "Press d'Arnold"));
+    QVERIFY(dbManager->statementCache.size() < DBManager::maxCachedStatements);
+    resultado = dbManager->get(TypeBDEnum::ExerciseEspec, DBFilter::Name, "Press d'Arnold");
+    QCOMPARE(resultado.rowCount(), 1);
+    QCOMPARE(resultado.value(0, "Description").toString(), QString("Otra desc"));
+
+    QString id = "120";
+    QVERIFY(dbManager->deleteRow(TypeBDEnum::ExerciseEspec, DBFilter::IdEx, id));
+    QCOMPARE(dbManager->get(TypeBDEnum::ExerciseEspec, DBFilter::IdEx, id).rowCount(), 0);
+}
+
+/**
+ * @brief Verifica el anidamiento de transacciones mediante savepoints y el guardado masivo.
+ */
+void TestDB::testNestedTransaction() {
+    QStringList columnas = QStringList() << "idEx" << "Name" << "Description" << "ExerciseType" << "TargetMuscle" << "Equipment" << "Series" << "Repetitions" << "Duration" << "Weight" << "RestTime";
+
+    DBTable exterior("exercise_espec");
+    exterior.setColumns(columnas);
+    exterior.addRow({130, "Remo", "Desc", "fuerza", "espalda", "barra", 3, 10, 60, 40, 90});
+    exterior.addRow({131, "Jalón", "Desc", "fuerza", "espalda", "polea", 3, 12, 60, 35, 90});
+
+    DBTable interior("exercise_espec");
+    interior.setColumns(columnas);
+    interior.addRow({132, "Dominadas", "Desc", "fuerza", "espalda", "barra", 3, 8, 60, 0, 120});
+
+    {
+        DBTransaction tx(dbManager);
+        QVERIFY(dbManager->save(TypeBDEnum::ExerciseEspec, exterior));
+        {
+            DBTransaction anidada(dbManager);
+            QCOMPARE(dbManager->transactionDepth(), 2);
+            QVERIFY(dbManager->save(TypeBDEnum::ExerciseEspec, interior));
+            anidada.rollback();
+        }
+        QVERIFY(tx.commit());
+    }
+    QCOMPARE(dbManager->transactionDepth(), 0);
+
+    QCOMPARE(dbManager->get(TypeBDEnum::ExerciseEspec, DBFilter::IdEx, "130").rowCount(), 1);
+    QCOMPARE(dbManager->get(TypeBDEnum::ExerciseEspec, DBFilter::IdEx, "131").rowCount(), 1);
+    QCOMPARE(dbManager->get(TypeBDEnum::ExerciseEspec, DBFilter::IdEx, "132").rowCount(), 0);
+
+    {
+        DBTransaction descartada(dbManager);
+        QString id = "130";
+        QVERIFY(dbManager->deleteRow(TypeBDEnum::ExerciseEspec, DBFilter::IdEx, id));
+    }
+    QCOMPARE(dbManager->get(TypeBDEnum::ExerciseEspec, DBFilter::IdEx, "130").rowCount(), 1);
+}
+
+/**
+ * @brief Verifica la versión del esquema y el uso del índice de sesiones.
+ */
+void TestDB::testMigrateSchema() {
+    QCOMPARE(dbManager->schemaVersion(), dbLatestSchemaVersion());
+
+    QSqlQuery plan(dbManager->qdb);
+    QVERIFY(plan.exec("EXPLAIN QUERY PLAN SELECT * FROM TrainingSesion WHERE idClient = 1 AND idWorkout = 2 AND idEx = 3"));
+    QString detalle;
+    while (plan.next()) detalle += plan.value(plan.record().count() - 1).toString();
+    QVERIFY(detalle.contains("idx_trainingsesion_client_workout_ex"));
+
+    QVERIFY(dbManager->migrateSchema());
+    QCOMPARE(dbManager->schemaVersion(), dbLatestSchemaVersion());
+
+    // Una base de datos anterior a las migraciones, sin las columnas nuevas de SesionReport, las recibe al migrar
+    QVERIFY(dbManager->execControl("ALTER TABLE SesionReport DROP COLUMN reportBlob"));
+    QVERIFY(dbManager->execControl("ALTER TABLE SesionReport DROP COLUMN repStatsJson"));
+    QVERIFY(dbManager->execControl("PRAGMA user_version = 0"));
+    // Abrirla no la migra; lo hace la conexión principal
+    QVERIFY(dbManager->openDatabase(dbPath));
+    QCOMPARE(dbManager->schemaVersion(), 0);
+    QVERIFY(dbManager->migrateSchema());
+    QCOMPARE(dbManager->schemaVersion(), dbLatestSchemaVersion());
+    const QStringList columnas = dbManager->getTableColumns("SesionReport");
+    QCOMPARE(columnas.mid(columnas.size() - 2), (QStringList{"repStatsJson", "reportBlob"}));
+}
+
+/**
+ * @brief Verifica la secuencia de IDs y su convivencia con IDs explícitos.
+ */
+void TestDB::testGenerateIDSequence() {
+    int primero = dbManager->generateID(TypeBDEnum::TrainingWorkout);
+    int segundo = dbManager->generateID(TypeBDEnum::TrainingWorkout);
+    QVERIFY(primero >= 1);
+    QVERIFY(segundo > primero);
+
+    // Se ocupa con un ID explícito el siguiente que entregaría el bloque
+    DBTable tabla("training_workout");
+    tabla.setColumns(QStringList() << "idWorkout" << "name" << "description" << "estimatedDuration");
+    tabla.addRow({segundo + 1, "Explícito", "Desc", 30});
+    QVERIFY(dbManager->save(TypeBDEnum::TrainingWorkout, tabla));
+
+    int tercero = dbManager->generateID(TypeBDEnum::TrainingWorkout);
+    QVERIFY(tercero > segundo + 1);
+}
+
+/**
+ * @brief Verifica que tableSchema() coincide con las columnas de una lectura completa.
+ */
+void TestDB::testTableSchema() {
+    DBTable esquema = dbManager->tableSchema(TypeBDEnum::ExerciseEspec);
+    QCOMPARE(esquema.rowCount(), 0);
+    QCOMPARE(esquema.getColumnsNames(), dbManager->get(TypeBDEnum::ExerciseEspec).getColumnsNames());
+    QVERIFY(dbManager->tableSchema(TypeBDEnum::TrainingSesion).getColumnsNames().contains("idSesion"));
+}
+
+/**
+ * @brief Verifica la serialización de DBWriteBatch y su escritura con writeBatch().
+ */
+void TestDB::testWriteBatch() {
+    DBTable ejercicios = dbManager->tableSchema(TypeBDEnum::ExerciseEspec);
+    ejercicios.addRow({140, "Peso muerto", "Desc", "fuerza", "espalda", "barra", 3, 5, 60, 80, 180});
+    DBTable workouts = dbManager->tableSchema(TypeBDEnum::TrainingWorkout);
+    workouts.addRow({140, "Cadena posterior", "Desc", 40});
+
+    DBWriteBatch lote;
+    lote.id = "lote-140";
+    lote.description = "prueba";
+    lote.tables = {qMakePair(TypeBDEnum::ExerciseEspec, ejercicios), qMakePair(TypeBDEnum::TrainingWorkout, workouts)};
+
+    QByteArray binario = lote.toBinary();
+    DBWriteBatch recuperado;
+    QVERIFY(recuperado.fromBinary(binario));
+    QCOMPARE(recuperado.id, QString("lote-140"));
+    QCOMPARE(recuperado.tables.size(), 2);
+    QVERIFY(!DBWriteBatch().fromBinary(binario.left(binario.size() / 2)));
+
+    QVERIFY(dbManager->writeBatch(recuperado));
+    QCOMPARE(dbManager->get(TypeBDEnum::ExerciseEspec, DBFilter::IdEx, "140").rowCount(), 1);
+    QCOMPARE(dbManager->get(TypeBDEnum::TrainingWorkout, DBFilter::IdWorkout, "140").value(0, "name").toString(),
+             QString("Cadena posterior"));
+}
+
+void TestDB::testConnectionPool() {
+    DBConnectionPool pool(dbPath);
+    dbManager->setConnectionPool(&pool);
+    DBHandle escritura(dbManager);
+    DBHandle lectura(dbManager, DBConnectionPool::Mode::ReadOnly);
+    QCOMPARE(escritura.get(), dbManager);
+
+    DBManager* conexionHilo = nullptr;
+    bool escrituraRechazada = false;
+    int filasLeidas = -1;
+    QThread* hilo = QThread::create([&]() {
+        conexionHilo = escritura.get();
+        DBTable fila = conexionHilo->tableSchema(TypeBDEnum::TrainingWorkout);
+        fila.addRow({150, "Hilo", "Desc", 20});
+        conexionHilo->save(TypeBDEnum::TrainingWorkout, fila);
+
+        DBTable otra = lectura->tableSchema(TypeBDEnum::TrainingWorkout);
+        otra.addRow({151, "Solo lectura", "Desc", 20});
+        escrituraRechazada = !lectura->save(TypeBDEnum::TrainingWorkout, otra);
+        filasLeidas = lectura->get(TypeBDEnum::TrainingWorkout, DBFilter::IdWorkout, "150").rowCount();
+    });
+    hilo->start();
+    QVERIFY(hilo->wait(5000));
+    delete hilo;
+    dbManager->setConnectionPool(nullptr);
+
+    QVERIFY(conexionHilo != nullptr);
+    QVERIFY(conexionHilo != dbManager);
+    QVERIFY(escrituraRechazada);
+    QCOMPARE(filasLeidas, 1);
+    QCOMPARE(pool.size(), 0);
+    QCOMPARE(dbManager->get(TypeBDEnum::TrainingWorkout, DBFilter::IdWorkout, "150").rowCount(), 1);
+
+    // Si el pool se destruye antes que un hilo con conexión, la conexión sigue abierta hasta que el hilo termina
+    QString nombre;
+    QThread vivo;
+    QObject contexto;
+    contexto.moveToThread(&vivo);
+    vivo.start();
+    {
+        DBConnectionPool temporal(dbPath);
+        QMetaObject::invokeMethod(&contexto, [&]() { nombre = temporal.connection()->connectionName(); },
+                                  Qt::BlockingQueuedConnection);
+    }
+    QVERIFY(QSqlDatabase::contains(nombre));
+    vivo.quit();
+    QVERIFY(vivo.wait(5000));
+    QVERIFY(!QSqlDatabase::contains(nombre));
+}
+
+void TestDB::testScan() {
+    DBTable workouts = dbManager->tableSchema(TypeBDEnum::TrainingWorkout);
+    for (int id = 160; id < 165; ++id)
+        workouts.addRow({id, QString("Recorrido %1").arg(id), "Desc", 30});
+    QVERIFY(dbManager->saveBulk(TypeBDEnum::TrainingWorkout, workouts));
+
+    const int total = dbManager->get(TypeBDEnum::TrainingWorkout).rowCount();
+    int filas = 0;
+    int bloques = 0;
+    int mayorBloque = 0;
+    QVERIFY(dbManager->scan(TypeBDEnum::TrainingWorkout, {}, [&](const DBTable& chunk) {
+        filas += chunk.rowCount();
+        mayorBloque = qMax(mayorBloque, chunk.rowCount());
+        ++bloques;
+        return true;
+    }, 2));
+    QCOMPARE(filas, total);
+    QCOMPARE(bloques, (total + 1) / 2);
+    QCOMPARE(mayorBloque, 2);
+
+    int vistos = 0;
+    QVERIFY(dbManager->scan(TypeBDEnum::TrainingWorkout, {}, [&](const DBTable& chunk) {
+        vistos += chunk.rowCount();
+        return false;
+    }, 2));
+    QCOMPARE(vistos, 2);
+
+    QString nombre;
+    QVERIFY(dbManager->scan(TypeBDEnum::TrainingWorkout, {{DBFilter::IdWorkout, 163}}, [&](const DBTable& chunk) {
+        nombre = chunk.stringValue(0, chunk.columnIndex("name"));
+        return true;
+    }));
+    QCOMPARE(nombre, QString("Recorrido 163"));
+}
+
+void TestDB::testGetPage() {
+    // Usa los workouts 160-164 guardados en testScan
+    DBPageRequest peticion;
+    peticion.tipo = TypeBDEnum::TrainingWorkout;
+    peticion.columns = {"idWorkout", "name"};
+    peticion.contains.insert("name", "recorrido");
+    peticion.orderBy = "name";
+    peticion.order = Qt::DescendingOrder;
+    peticion.limit = 2;
+    peticion.offset = 1;
+
+    DBTable pagina = dbManager->getPage(peticion);
+    QCOMPARE(pagina.columnCount(), 2);
+    QCOMPARE(pagina.rowCount(), 2);
+    QCOMPARE(pagina.stringValue(0, 1), QString("Recorrido 163"));
+    QCOMPARE(pagina.intValue(1, 0), 162);
+
+    peticion.offset = 4;
+    QCOMPARE(dbManager->getPage(peticion).rowCount(), 1);
+
+    // Los comodines del texto se buscan literalmente
+    peticion.offset = 0;
+    peticion.contains.insert("name", "Recorrido%");
+    QCOMPARE(dbManager->getPage(peticion).rowCount(), 0);
+
+    peticion.contains.clear();
+    peticion.orderBy = "name; DROP TABLE training_workout";
+    QCOMPARE(dbManager->getPage(peticion).rowCount(), 0);
+    QVERIFY(dbManager->get(TypeBDEnum::TrainingWorkout).rowCount() > 0);
+}
+
+void TestDB::testSesionRollup() {
+    auto resumen = [this](int idSesion, const QDate& dia, int reps, int tut, double rom) {
+        DBTable fila = dbManager->tableSchema(TypeBDEnum::SesionSummary);
+        fila.addRow({idSesion, 7, 1, 3, dia.toString(Qt::ISODate), dia.toString(Qt::ISODate),
+                     SesionSummary::weekKey(dia), 60000, reps, tut, 1, 2, 3, 0, rom, "{}"});
+        return dbManager->saveBulk(TypeBDEnum::SesionSummary, fila);
+    };
+    const QDate lunes(2025, 1, 6);
+    QVERIFY(resumen(900, lunes, 10, 5000, 40.0));
+    QVERIFY(resumen(901, lunes, 8, 4000, 60.0));
+    QVERIFY(resumen(902, lunes.addDays(1), 6, 3000, 50.0));
+    QVERIFY(resumen(903, lunes.addDays(7), 12, 6000, 70.0));
+    // Reprocesar la misma sesión reemplaza su fila
+    QVERIFY(resumen(901, lunes, 8, 4000, 60.0));
+
+    DBPageRequest diario;
+    diario.tipo = TypeBDEnum::SesionRollupDaily;
+    diario.equals.insert("idClient", 7);
+    diario.equals.insert("idEx", 3);
+    diario.between.insert("day", qMakePair(QVariant(lunes.toString(Qt::ISODate)),
+                                           QVariant(lunes.addDays(1).toString(Qt::ISODate))));
+    diario.orderBy = "day";
+    DBTable dias = dbManager->getPage(diario);
+    QCOMPARE(dias.rowCount(), 2);
+    QCOMPARE(dias.intValue(0, dias.columnIndex("sessions")), 2);
+    QCOMPARE(dias.intValue(0, dias.columnIndex("repetitions")), 18);
+    QCOMPARE(dias.intValue(0, dias.columnIndex("timeUnderTension")), 9000);
+    QCOMPARE(dias.doubleValue(0, dias.columnIndex("romMean")), 50.0);
+    QCOMPARE(dias.intValue(1, dias.columnIndex("sessions")), 1);
+
+    DBPageRequest semanal;
+    semanal.tipo = TypeBDEnum::SesionRollupWeekly;
+    semanal.equals = diario.equals;
+    semanal.orderBy = "week";
+    DBTable semanas = dbManager->getPage(semanal);
+    QCOMPARE(semanas.rowCount(), 2);
+    QCOMPARE(semanas.stringValue(0, semanas.columnIndex("week")), QString("2025-W02"));
+    QCOMPARE(semanas.intValue(0, semanas.columnIndex("sessions")), 3);
+    QCOMPARE(semanas.intValue(1, semanas.columnIndex("repetitions")), 12);
+
+    // Borrar el único resumen de un día elimina su acumulado
+    QString idSesion = "902";
+    QVERIFY(dbManager->deleteRow(TypeBDEnum::SesionSummary, DBFilter::IdSesion, idSesion));
+    QCOMPARE(dbManager->getPage(diario).rowCount(), 1);
+    QCOMPARE(dbManager->getPage(semanal).intValue(0, semanas.columnIndex("sessions")), 2);
+
+    // Volver a guardar una sesión con otra fecha la pasa al nuevo periodo y la retira del anterior, tanto por
+    // UPDATE (guardado con filtro) como por REPLACE (guardado masivo)
+    const QDate otraSemana = lunes.addDays(14);
+    DBTable cambio = dbManager->tableSchema(TypeBDEnum::SesionSummary);
+    cambio.addRow({903, 7, 1, 3, otraSemana.toString(Qt::ISODate), otraSemana.toString(Qt::ISODate),
+                   SesionSummary::weekKey(otraSemana), 60000, 15, 6000, 1, 2, 3, 0, 70.0, "{}"});
+    QVERIFY(dbManager->save(TypeBDEnum::SesionSummary, cambio, DBFilter::IdClient, "7"));
+    QVERIFY(resumen(900, lunes.addDays(2), 10, 5000, 40.0));
+
+    semanas = dbManager->getPage(semanal);
+    QCOMPARE(semanas.rowCount(), 2);
+    QCOMPARE(semanas.stringValue(0, semanas.columnIndex("week")), QString("2025-W02"));
+    QCOMPARE(semanas.intValue(0, semanas.columnIndex("sessions")), 2);
+    QCOMPARE(semanas.stringValue(1, semanas.columnIndex("week")), QString("2025-W04"));
+    QCOMPARE(semanas.intValue(1, semanas.columnIndex("repetitions")), 15);
+
+    diario.between.clear();
+    dias = dbManager->getPage(diario);
+    QCOMPARE(dias.rowCount(), 3);
+    QCOMPARE(dias.stringValue(0, dias.columnIndex("day")), lunes.toString(Qt::ISODate));
+    QCOMPARE(dias.intValue(0, dias.columnIndex("sessions")), 1);
+    QCOMPARE(dias.intValue(0, dias.columnIndex("repetitions")), 8);
+    QCOMPARE(dias.stringValue(1, dias.columnIndex("day")), lunes.addDays(2).toString(Qt::ISODate));
+    QCOMPARE(dias.stringValue(2, dias.columnIndex("day")), otraSemana.toString(Qt::ISODate));
+}
@@ -100,6 +100,66 @@ private slots:
      */
     void testIsValidFilterForTable();
 
+    /**
+     * @brief Comprueba que los valores se enlazan como parámetros (un texto con comillas se guarda y se
+     * filtra sin alterarse), que repetir una consulta reutiliza su sentencia preparada y que vaciar la caché a
+     * mitad de un guardado no invalida las sentencias que este ya tiene.
+     */
+    void testPreparedStatementCache();
+
+    /**
+     * @brief Caja blanca: una transacción anidada que se revierte descarta solo sus cambios, y la
+     * transacción exterior confirma el resto; un guardado masivo inserta todas las filas.
+     */
+    void testNestedTransaction();
+
+    /**
+     * @brief Caja blanca: tras cargar el esquema la versión guardada es la última, la consulta de sesiones
+     * usa su índice y volver a migrar no cambia nada. Una base de datos sin versión ni columnas nuevas las recibe.
+     */
+    void testMigrateSchema();
+
+    /**
+     * @brief Caja blanca: los IDs generados son crecientes y no se repiten, y un ID guardado explícitamente
+     * dentro del bloque reservado no se vuelve a entregar.
+     */
+    void testGenerateIDSequence();
+
+    /**
+     * @brief Caja blanca: el esquema de una tabla tiene sus columnas en el orden de `SELECT *` y ninguna fila.
+     */
+    void testTableSchema();
+
+    /**
+     * @brief Caja negra: un lote serializado y recuperado se guarda completo en una transacción, y un bloque
+     * truncado se rechaza.
+     */
+    void testWriteBatch();
+
+    /**
+     * @brief Caja blanca: desde otro hilo un DBHandle usa una conexión propia del pool, la de solo lectura
+     * rechaza escrituras y las conexiones se cierran al terminar el hilo, también si el pool ya no existe.
+     */
+    void testConnectionPool();
+
+    /**
+     * @brief Caja negra: el recorrido por bloques entrega las mismas filas que get() en bloques del tamaño pedido
+     * y se detiene cuando el visitante devuelve false.
+     */
+    void testScan();
+
+    /**
+     * @brief Caja negra: una página aplica en SQL el filtro de texto, el orden y la ventana de filas, y rechaza
+     * columnas que no existen en la tabla.
+     */
+    void testGetPage();
+
+    /**
+     * @brief Caja negra: los resúmenes de sesión mantienen los acumulados diario y semanal, volver a guardar una
+     * sesión no la cuenta dos veces, cambiarle la fecha la mueve de periodo y la tendencia se lee por rango de fechas.
+     */
+    void testSesionRollup();
+
 private:
     DBManager* dbManager; ///< Puntero al gestor de base de datos a probar.
     QString dbPath;       ///< Ruta al archivo de base de datos temporal utilizado en las pruebas.
@@ -64,10 +64,10 @@ void TestDBTable::testInternalState_addRowUpdatesCorrectly()
 {
     DBTable table("test");
     table.setColumns({"a", "b"});
-    QCOMPARE(table.rows.size(), 0);
+    QCOMPARE(table.rowTotal, 0);
     table.addRow({1, 2});
-    QCOMPARE(table.rows.size(), 1);
-    QCOMPARE(table.rows[0][1].toInt(), 2);
+    QCOMPARE(table.rowTotal, 1);
+    QCOMPARE(table.data[1].integers[0], qint64(2));
 }
 
 void TestDBTable::testLogicalCondition_columnIndexNegative()
@@ -87,3 +87,59 @@ void TestDBTable::testLoop_getRowIteratesAllColumns()
     QCOMPARE(fila.size(), 3);
     QCOMPARE(fila[2].toInt(), 30);
 }
+
+void TestDBTable::testInternalState_typedColumns()
+{
+    DBTable table("test");
+    table.setColumns({"id", "peso", "nombre", "mixta"});
+    table.addRow({QVariant(), 72.5, "Ana", 1});
+    table.addRow({qlonglong(7), QVariant(QMetaType::fromType<double>()), "Luis", "dos"});
+
+    // La primera celda inválida no fija el tipo; el primer valor válido sí
+    QVERIFY(table.data[0].kind == DBTable::Column::Kind::Integer);
+    QVERIFY(!table.value(0, "id").isValid());
+    QCOMPARE(table.value(1, "id").typeId(), int(QMetaType::LongLong));
+
+    QVERIFY(table.data[1].kind == DBTable::Column::Kind::Real);
+    QVERIFY(table.value(1, "peso").isNull());
+    QVERIFY(table.data[2].kind == DBTable::Column::Kind::Text);
+
+    // Un valor de otro tipo pasa la columna a genérica sin perder los anteriores
+    QVERIFY(table.data[3].kind == DBTable::Column::Kind::Generic);
+    QCOMPARE(table.value(0, "mixta").typeId(), int(QMetaType::Int));
+    QCOMPARE(table.value(1, "mixta").toString(), QString("dos"));
+
+    table.setValue(0, "nombre", 5);
+    QVERIFY(table.data[2].kind == DBTable::Column::Kind::Generic);
+    QCOMPARE(table.value(1, "nombre").toString(), QString("Luis"));
+    QVERIFY(table.contains("nombre", 5));
+}
+
+void TestDBTable::testColumnIndexAccessors()
+{
+    DBTable table("test");
+    table.setColumns({"idSesion", "Fecha", "Duracion"});
+    table.addRow({1, "2025-01-01", 30.5});
+    table.addRow({2, "2025-01-02", 45.0});
+
+    QCOMPARE(table.columnIndex("fecha"), 1);
+    QCOMPARE(table.columnIndex("IDSESION"), 0);
+    QCOMPARE(table.columnIndex("no_existe"), -1);
+
+    QCOMPARE(table.intValue(1, 0), 2);
+    QCOMPARE(table.stringValue(0, 1), QString("2025-01-01"));
+    QCOMPARE(table.doubleValue(1, 2), 45.0);
+    QCOMPARE(table.value(5, 0), QVariant());
+
+    table.setValue(1, 2, 50.0);
+    QCOMPARE(table.value(1, "duracion").toDouble(), 50.0);
+
+    // Añadir una columna con filas existentes la deja vacía para esas filas
+    table.setColumns({"idSesion", "Fecha", "Duracion", "Notas"});
+    QVERIFY(!table.value(0, "Notas").isValid());
+    table.addRow({3, "2025-01-03", 20.0, "ok"});
+    QCOMPARE(table.stringValue(2, 3), QString("ok"));
+
+    DBTable movida = std::move(table);
+    QCOMPARE(movida.rowCount(), 3);
+}
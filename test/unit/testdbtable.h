@@ -22,6 +22,8 @@ private slots:
     void testInternalState_addRowUpdatesCorrectly();  // Cobertura interna de rows
     void testLogicalCondition_columnIndexNegative();  // Cubrimiento lógico
     void testLoop_getRowIteratesAllColumns();         // Bucle en getRow
+    void testInternalState_typedColumns();            // Almacenamiento por tipo y paso a genérico
+    void testColumnIndexAccessors();                  // Acceso por índice de columna
 };
 
 #endif // TESTDBTABLE_H
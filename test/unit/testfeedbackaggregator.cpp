@@ -0,0 +1,123 @@
+#include "testfeedbackaggregator.h"
+#include "pose/feedbackaggregator.h"
+#include <QtTest>
+
+/**
+ * @brief 60 frames a 33 ms con Not_Steady: una activación a los 100 ms y una liberación 500 ms después del último.
+ */
+void TestFeedbackAggregator::test_ActivacionYLiberacion() {
+    FeedbackAggregator aggregator;
+    Condition cond(ConditionType::Not_Steady, "codo");
+
+    int onsets = 0;
+    int offsets = 0;
+    int64_t t = 0;
+    for (int i = 0; i < 60; ++i, t += 33) {
+        FeedbackDelta delta = aggregator.update({cond}, t);
+        onsets += delta.onsets.size();
+        offsets += delta.offsets.size();
+    }
+    QCOMPARE(onsets, 1);
+    QCOMPARE(offsets, 0);
+    QCOMPARE(aggregator.getActive().size(), 1);
+
+    for (int i = 0; i < 20; ++i, t += 33) {
+        FeedbackDelta delta = aggregator.update({}, t);
+        onsets += delta.onsets.size();
+        offsets += delta.offsets.size();
+    }
+    QCOMPARE(onsets, 1);
+    QCOMPARE(offsets, 1);
+    QVERIFY(aggregator.getActive().isEmpty());
+}
+
+/**
+ * @brief Detección presente un frame de cada tres: sigue activa sin nuevas activaciones.
+ */
+void TestFeedbackAggregator::test_HisteresisIntermitente() {
+    FeedbackAggregator aggregator;
+    Condition cond(ConditionType::symmetryDeviation, "hombro", 0, PoseView::Left);
+
+    int onsets = 0;
+    int offsets = 0;
+    for (int i = 0; i < 90; ++i) {
+        QList<Condition> conds;
+        if (i < 10 || i % 3 == 0) conds.append(cond);
+        FeedbackDelta delta = aggregator.update(conds, i * 33);
+        onsets += delta.onsets.size();
+        offsets += delta.offsets.size();
+    }
+    QCOMPARE(onsets, 1);
+    QCOMPARE(offsets, 0);
+}
+
+/**
+ * @brief Una condición presente 66 ms (menos que los 100 ms de mantenimiento) nunca se activa.
+ */
+void TestFeedbackAggregator::test_DeteccionBreve() {
+    FeedbackAggregator aggregator;
+    Condition cond(ConditionType::FastMovement, "rodilla");
+
+    int onsets = 0;
+    int offsets = 0;
+    for (int i = 0; i < 30; ++i) {
+        QList<Condition> conds;
+        if (i < 3) conds.append(cond);
+        FeedbackDelta delta = aggregator.update(conds, i * 33);
+        onsets += delta.onsets.size();
+        offsets += delta.offsets.size();
+    }
+    QCOMPARE(onsets, 0);
+    QCOMPARE(offsets, 0);
+}
+
+/**
+ * @brief Dos fines de repetición consecutivos generan dos activaciones; JointOverload se activa en el primer frame.
+ */
+void TestFeedbackAggregator::test_EventosPuntuales() {
+    FeedbackAggregator aggregator;
+
+    FeedbackDelta first = aggregator.update({Condition(ConditionType::EndOfRepetition, "1")}, 0);
+    FeedbackDelta second = aggregator.update({Condition(ConditionType::EndOfRepetition, "2")}, 33);
+    QCOMPARE(first.onsets.size(), 1);
+    QCOMPARE(second.onsets.size(), 1);
+    QVERIFY(aggregator.getActive().isEmpty());
+
+    FeedbackDelta overload = aggregator.update({Condition(ConditionType::JointOverload, "codo")}, 66);
+    QCOMPARE(overload.onsets.size(), 1);
+}
+
+/**
+ * @brief 300 frames a 33 ms (9,9 s) con los tres tiempos agotados: dos avisos por tiempo de estado (al activarse y
+ * a los 5 s) y uno por tiempo de serie.
+ */
+void TestFeedbackAggregator::test_TiemposAgotados() {
+    FeedbackAggregator aggregator;
+
+    int maxState = 0;
+    int minState = 0;
+    int setTime = 0;
+    int64_t t = 0;
+    for (int i = 0; i < 300; ++i, t += 33) {
+        QList<Condition> conds = {
+            Condition(ConditionType::MaxStateTimeout, "2", int(t)),
+            Condition(ConditionType::MinStateTimeout, "1", int(t)),
+            Condition(ConditionType::SetTime, "", int(t))
+        };
+        FeedbackDelta delta = aggregator.update(conds, t);
+        for (const Condition& cond : delta.onsets) {
+            if (cond.type == ConditionType::MaxStateTimeout) ++maxState;
+            if (cond.type == ConditionType::MinStateTimeout) ++minState;
+            if (cond.type == ConditionType::SetTime) ++setTime;
+        }
+    }
+    QCOMPARE(maxState, 2);
+    QCOMPARE(minState, 2);
+    QCOMPARE(setTime, 1);
+    QCOMPARE(aggregator.getActive().size(), 3);
+
+    // Al desaparecer se liberan, y una nueva aparición se notifica al instante
+    for (int i = 0; i < 40; ++i, t += 33) aggregator.update({}, t);
+    QVERIFY(aggregator.getActive().isEmpty());
+    QCOMPARE(aggregator.update({Condition(ConditionType::MaxStateTimeout, "2", 0)}, t).onsets.size(), 1);
+}
@@ -0,0 +1,46 @@
+#ifndef TESTFEEDBACKAGGREGATOR_H
+#define TESTFEEDBACKAGGREGATOR_H
+
+#include <QObject>
+
+/**
+ * @file testfeedbackaggregator.h
+ * @brief Declaración de la clase de test unitario para FeedbackAggregator.
+ *
+ * Comprueba que una condición continua solo se notifica al activarse y al liberarse, que la histéresis
+ * absorbe detecciones intermitentes, que las alertas de tiempo agotado se recuerdan a intervalos y que los
+ * eventos puntuales se notifican siempre.
+ */
+class TestFeedbackAggregator : public QObject {
+    Q_OBJECT
+
+private slots:
+
+    /**
+     * @brief Caja negra: una alerta presente durante muchos frames genera una activación y una liberación.
+     */
+    void test_ActivacionYLiberacion();
+
+    /**
+     * @brief Caja blanca: una ausencia más corta que el tiempo de liberación no libera la condición.
+     */
+    void test_HisteresisIntermitente();
+
+    /**
+     * @brief Valores límite: una detección más corta que el tiempo de mantenimiento no se notifica.
+     */
+    void test_DeteccionBreve();
+
+    /**
+     * @brief Caja negra: los eventos puntuales se notifican cada vez que aparecen.
+     */
+    void test_EventosPuntuales();
+
+    /**
+     * @brief Caja negra: los tiempos agotados presentes en cada frame generan una activación y un recordatorio
+     * por intervalo, no un mensaje por frame.
+     */
+    void test_TiemposAgotados();
+};
+
+#endif // TESTFEEDBACKAGGREGATOR_H
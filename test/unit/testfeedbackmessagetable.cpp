@@ -0,0 +1,64 @@
+#include "testfeedbackmessagetable.h"
+#include "pose/feedback.h"
+#include "pose/feedbackmessagetable.h"
+#include <QtTest>
+
+/**
+ * @brief La tabla con las líneas "codo" y "rodilla" resuelve el mensaje de sobrecarga para cada una.
+ */
+void TestFeedbackMessageTable::test_MensajesPorLinea() {
+    FeedbackMessageTable table({"codo", "rodilla"});
+
+    QCOMPARE(table.lineId("codo"), 1);
+    QCOMPARE(table.lineId("rodilla"), 2);
+    QCOMPARE(table.message(ConditionType::JointOverload, 1), QString("Estas forzando la articulación en la línea codo"));
+    QCOMPARE(table.message(ConditionType::JointOverload, 2), QString("Estas forzando la articulación en la línea rodilla"));
+    QCOMPARE(table.message(ConditionType::EndOfSet, 0), QString("Serie Completada!!"));
+    QCOMPARE(table.category(ConditionType::JointOverload), ConditionCategory::critical);
+}
+
+/**
+ * @brief Las líneas desconocidas y los IDs fuera de rango no provocan accesos inválidos.
+ */
+void TestFeedbackMessageTable::test_LineaDesconocida() {
+    FeedbackMessageTable table({"codo"});
+
+    QCOMPARE(table.lineId("hombro"), 0);
+    QCOMPARE(table.lineName(0), QString());
+    QVERIFY(table.message(ConditionType::MaxAngle, 5).isEmpty());
+}
+
+/**
+ * @brief Un feedback con una sobrecarga y un fin de repetición devuelve un mensaje crítico y uno informativo.
+ */
+void TestFeedbackMessageTable::test_FeedBackClasificacion() {
+    auto table = QSharedPointer<const FeedbackMessageTable>::create(QStringList{"codo"});
+    FeedBack feedback({Condition(ConditionType::JointOverload, "codo"),
+                       Condition(ConditionType::EndOfRepetition, "1")}, {}, table);
+
+    QVERIFY(feedback.contains(ConditionType::JointOverload));
+    QVERIFY(!feedback.contains(ConditionType::Not_Steady));
+    QCOMPARE(feedback.getEntriesList().size(), 2);
+    QCOMPARE(feedback.getLineId(ConditionType::JointOverload), 1);
+    QVERIFY(feedback.isCritical(ConditionType::JointOverload));
+    QVERIFY(feedback.isInfo(ConditionType::EndOfRepetition));
+    QCOMPARE(feedback.getCriticalMessages(), QList<QString>{"Estas forzando la articulación en la línea codo"});
+    QCOMPARE(feedback.getInfoMessages().size(), 1);
+    QVERIFY(feedback.getAlerts().isEmpty());
+}
+
+/**
+ * @brief Un feedback sin activaciones (solo una liberación) que mantiene una alerta y la forma óptima activas
+ * las devuelve como activas sin mensajes nuevos; la categoría de un tipo ausente se sigue consultando.
+ */
+void TestFeedbackMessageTable::test_FeedBackActivas() {
+    auto table = QSharedPointer<const FeedbackMessageTable>::create(QStringList{"codo"});
+    FeedBack feedback({}, {Condition(ConditionType::OptimalForm, "codo"), Condition(ConditionType::Not_Steady, "codo")},
+                      table, 1500);
+
+    QVERIFY(feedback.getEntriesList().isEmpty());
+    QVERIFY(feedback.getActiveList() == (QList<ConditionType>{ConditionType::Not_Steady, ConditionType::OptimalForm}));
+    QCOMPARE(feedback.getTime(), int64_t(1500));
+    QVERIFY(!feedback.contains(ConditionType::JointOverload));
+    QVERIFY(feedback.categoryOf(ConditionType::JointOverload) == ConditionCategory::critical);
+}
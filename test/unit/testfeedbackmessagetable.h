@@ -0,0 +1,39 @@
+#ifndef TESTFEEDBACKMESSAGETABLE_H
+#define TESTFEEDBACKMESSAGETABLE_H
+
+#include <QObject>
+
+/**
+ * @file testfeedbackmessagetable.h
+ * @brief Declaración de la clase de test unitario para FeedbackMessageTable y FeedBack.
+ *
+ * Comprueba que los mensajes se resuelven por tipo y línea al construir la tabla y que FeedBack los
+ * recupera a partir de sus índices.
+ */
+class TestFeedbackMessageTable : public QObject {
+    Q_OBJECT
+
+private slots:
+
+    /**
+     * @brief Caja negra: los mensajes con línea incluyen el nombre de la línea del ejercicio.
+     */
+    void test_MensajesPorLinea();
+
+    /**
+     * @brief Valores límite: una línea que no pertenece al ejercicio recibe el ID 0.
+     */
+    void test_LineaDesconocida();
+
+    /**
+     * @brief Caja blanca: FeedBack clasifica las condiciones con la categoría de la tabla.
+     */
+    void test_FeedBackClasificacion();
+
+    /**
+     * @brief Caja negra: el feedback conserva los tipos activos y el timestamp, aunque no se acaben de activar.
+     */
+    void test_FeedBackActivas();
+};
+
+#endif // TESTFEEDBACKMESSAGETABLE_H
@@ -0,0 +1,92 @@
+#include "testkinematicstracker.h"
+#include "pose/kinematicstracker.h"
+#include <QtTest>
+#include <cmath>
+
+/**
+ * @brief Una línea no registrada o con menos frames que la ventana no tiene estimación válida.
+ */
+void TestKinematicsTracker::test_VentanaIncompleta() {
+    KinematicsTracker tracker(7);
+
+    QVERIFY(!tracker.sample(PoseView::Front, "codo").valid);
+
+    for (int i = 0; i < 6; ++i)
+        tracker.update(PoseView::Front, {{"codo", 90.0 + i}}, 1000 + i * 33);
+
+    QVERIFY(!tracker.sample(PoseView::Front, "codo").valid);
+
+    tracker.update(PoseView::Front, {{"codo", 96.0}}, 1000 + 6 * 33);
+    QVERIFY(tracker.sample(PoseView::Front, "codo").valid);
+}
+
+/**
+ * @brief 3 grados cada 30 ms equivalen a 100 grados/s con aceleración nula.
+ */
+void TestKinematicsTracker::test_VelocidadConstante() {
+    KinematicsTracker tracker(7);
+
+    for (int i = 0; i < 10; ++i)
+        tracker.update(PoseView::Left, {{"rodilla", 30.0 + 3.0 * i}}, i * 30);
+
+    KinematicSample s = tracker.sample(PoseView::Left, "rodilla");
+    QVERIFY(s.valid);
+    QVERIFY(qAbs(s.angle - 57.0) < 1e-6);
+    QVERIFY(qAbs(s.velocity - 100.0) < 1e-6);
+    QVERIFY(qAbs(s.acceleration) < 1e-6);
+}
+
+/**
+ * @brief Con ángulo = 0.5·a·t² y a = 400 grados/s² el filtro devuelve a y la velocidad a·t.
+ */
+void TestKinematicsTracker::test_AceleracionConstante() {
+    KinematicsTracker tracker(9);
+
+    double t = 0;
+    for (int i = 0; i < 12; ++i) {
+        t = i * 0.04;
+        tracker.update(PoseView::Front, {{"hombro", 0.5 * 400.0 * t * t}}, i * 40);
+    }
+
+    KinematicSample s = tracker.sample(PoseView::Front, "hombro");
+    QVERIFY(s.valid);
+    QVERIFY(qAbs(s.acceleration - 400.0) < 1e-6);
+    QVERIFY(qAbs(s.velocity - 400.0 * t) < 1e-6);
+}
+
+/**
+ * @brief Al cruzar 360° el ángulo se desenrolla y la velocidad sigue siendo constante.
+ */
+void TestKinematicsTracker::test_CruceCeroGrados() {
+    KinematicsTracker tracker(5);
+
+    for (int i = 0; i < 8; ++i) {
+        double angle = std::fmod(354.0 + 2.0 * i, 360.0);
+        tracker.update(PoseView::Front, {{"cadera", angle}}, i * 20);
+    }
+
+    KinematicSample s = tracker.sample(PoseView::Front, "cadera");
+    QVERIFY(s.valid);
+    QVERIFY(qAbs(s.velocity - 100.0) < 1e-6);
+    QVERIFY(qAbs(s.angle - 8.0) < 1e-6);
+}
+
+/**
+ * @brief Los frames de una vista no alteran la otra y reset() vacía todas las ventanas.
+ */
+void TestKinematicsTracker::test_VistasIndependientesYReset() {
+    KinematicsTracker tracker(5);
+
+    for (int i = 0; i < 5; ++i) {
+        tracker.update(PoseView::Front, {{"codo", 10.0 * i}}, i * 100);
+        tracker.update(PoseView::Right, {{"codo", 50.0}}, i * 100);
+    }
+
+    QVERIFY(qAbs(tracker.sample(PoseView::Front, "codo").velocity - 100.0) < 1e-6);
+    QVERIFY(qAbs(tracker.sample(PoseView::Right, "codo").velocity) < 1e-6);
+    QVERIFY(!tracker.sample(PoseView::Left, "codo").valid);
+
+    tracker.reset();
+    QVERIFY(!tracker.sample(PoseView::Front, "codo").valid);
+    QVERIFY(!tracker.sample(PoseView::Right, "codo").valid);
+}
@@ -0,0 +1,45 @@
+#ifndef TESTKINEMATICSTRACKER_H
+#define TESTKINEMATICSTRACKER_H
+
+#include <QObject>
+
+/**
+ * @file testkinematicstracker.h
+ * @brief Declaración de la clase de test unitario para KinematicsTracker.
+ *
+ * Comprueba que el filtro Savitzky–Golay causal recupera la velocidad y aceleración de trayectorias
+ * conocidas, que las estimaciones no son válidas hasta completar la ventana y que el paso por 0°/360°
+ * no se interpreta como un salto de velocidad.
+ */
+class TestKinematicsTracker : public QObject {
+    Q_OBJECT
+
+private slots:
+
+    /**
+     * @brief Caja negra: una línea desconocida o con la ventana incompleta devuelve una muestra no válida.
+     */
+    void test_VentanaIncompleta();
+
+    /**
+     * @brief Caja negra: un movimiento a velocidad constante da velocidad exacta y aceleración nula.
+     */
+    void test_VelocidadConstante();
+
+    /**
+     * @brief Caja negra: una trayectoria cuadrática da la aceleración esperada.
+     */
+    void test_AceleracionConstante();
+
+    /**
+     * @brief Valores límite: cruzar de 359° a 0° no genera velocidades espurias.
+     */
+    void test_CruceCeroGrados();
+
+    /**
+     * @brief Caja blanca: las vistas se filtran de forma independiente y reset() invalida las muestras.
+     */
+    void test_VistasIndependientesYReset();
+};
+
+#endif // TESTKINEMATICSTRACKER_H
@@ -0,0 +1,112 @@
+#include "teststate.h"
+#include "pose/state.h"
+#include "pose/kinematicstracker.h"
+#include <QtTest>
+
+namespace {
+
+/// Estado con una restricción de 60°–120° en el codo, vista frontal, mantenida y con 4° de tolerancia.
+State estadoMantenido()
+{
+    State state(1, 1);
+    AngleConstraint constraint(1, 1, 1, 60, 120, -1, -1, -1, -1, -1, Direction::Steady, 4, "codo", PoseView::Front);
+    state.addAngleConstraint("codo", constraint);
+    return state;
+}
+
+}
+
+/**
+ * @brief Dos frames a 90° guardan la caché con ese ángulo y margen 2° (mitad de la tolerancia); un frame a 91° da
+ * el mismo reporte y la referencia sigue en 90°, luego no se ha reevaluado.
+ */
+void TestState::test_HoldReutilizado() {
+    State state = estadoMantenido();
+    state.getReport({{"codo", 90}}, 1000);
+    QList<Condition> completo = state.getReport({{"codo", 90}}, 1033);
+
+    QVERIFY(state.holdCache.value(PoseView::Front).valid);
+    QCOMPARE(state.holdCache.value(PoseView::Front).margin.value("codo"), 2.0);
+
+    QList<Condition> reutilizado = state.getReport({{"codo", 91}}, 1066);
+    QCOMPARE(reutilizado, completo);
+    QCOMPARE(state.holdCache.value(PoseView::Front).anchor.value("codo"), 90.0);
+
+    // La caché es por vista: otra vista no la usa
+    state.getReport({{"codo", 91}}, 1100, PoseView::Left);
+    QVERIFY(!state.holdCache.value(PoseView::Left).valid);
+}
+
+/**
+ * @brief A 93° (3° de la referencia, fuera del margen) se reevalúa y la referencia pasa a 93°; a 99° el salto de
+ * 6° supera la tolerancia, la pose no está quieta y la caché queda inválida.
+ */
+void TestState::test_HoldInvalidadoPorAngulo() {
+    State state = estadoMantenido();
+    state.getReport({{"codo", 90}}, 1000);
+    state.getReport({{"codo", 90}}, 1033);
+    QVERIFY(state.holdCache.value(PoseView::Front).valid);
+
+    state.getReport({{"codo", 93}}, 1066);
+    QVERIFY(state.holdCache.value(PoseView::Front).valid);
+    QCOMPARE(state.holdCache.value(PoseView::Front).anchor.value("codo"), 93.0);
+
+    state.getReport({{"codo", 99}}, 1100);
+    QVERIFY(!state.holdCache.value(PoseView::Front).valid);
+
+    // Si falta la línea con restricción tampoco se reutiliza
+    state.getReport({{"codo", 99}}, 1133);
+    QVERIFY(state.holdCache.value(PoseView::Front).valid);
+    state.getReport({{"hombro", 40}}, 1166);
+    QVERIFY(!state.holdCache.value(PoseView::Front).valid);
+}
+
+/**
+ * @brief Con la caché válida, setEntryTime() (nueva entrada en el estado) y addAngleConstraint() la vacían.
+ */
+void TestState::test_HoldInvalidadoPorFase() {
+    State state = estadoMantenido();
+    state.getReport({{"codo", 90}}, 1000);
+    state.getReport({{"codo", 90}}, 1033);
+    QVERIFY(state.holdCache.value(PoseView::Front).valid);
+
+    state.setEntryTime(1066);
+    QVERIFY(state.holdCache.isEmpty());
+
+    state.getReport({{"codo", 90}}, 1100);
+    QVERIFY(state.holdCache.value(PoseView::Front).valid);
+    AngleConstraint otra(2, 1, 1, 80, 100, -1, -1, -1, -1, -1, Direction::Steady, 4, "codo", PoseView::Front);
+    state.addAngleConstraint("codo", otra);
+    QVERIFY(state.holdCache.isEmpty());
+}
+
+/**
+ * @brief Ángulo = 30 + 0.5·a·t² cada 33 ms con a = 6000 grados/s² (el doble del umbral) frente a 3 grados por
+ * frame constantes. Las condiciones se piden tras actualizar el tracker con cada frame, como en la máquina de estados.
+ */
+void TestState::test_PicoAceleracion() {
+    AngleConstraint constraint(1, 1, 1, 0, 180, -1, -1, -1, -1, -1, Direction::Not_matter, -1, "codo", PoseView::Front);
+
+    auto picos = [&](auto angleAt) {
+        State state(1, 1);
+        state.addAngleConstraint("codo", constraint);
+        KinematicsTracker tracker(7);
+        QList<Condition> spikes;
+        for (int i = 0; i < 10; ++i) {
+            const QHash<QString, double> angles = {{"codo", angleAt(i * 0.033)}};
+            tracker.update(PoseView::Front, angles, i * 33);
+            for (const Condition& cond : state.getReport(angles, i * 33, PoseView::Front, &tracker))
+                if (cond.type == ConditionType::AccelerationSpikes) spikes.append(cond);
+        }
+        return spikes;
+    };
+
+    const double a = 2 * State::ACCEL_SPIKE_THRESHOLD;
+    const QList<Condition> spikes = picos([a](double t) { return 30.0 + 0.5 * a * t * t; });
+    // La ventana de 7 frames se completa en el séptimo, y desde ahí cada frame tiene el pico
+    QCOMPARE(spikes.size(), 4);
+    QCOMPARE(spikes.first().keypointLine, QString("codo"));
+    QVERIFY(qAbs(spikes.first().value.toDouble() - a) < 1e-3);
+
+    QVERIFY(picos([](double t) { return 30.0 + 3.0 * t / 0.033; }).isEmpty());
+}
@@ -0,0 +1,42 @@
+#ifndef TESTSTATE_H
+#define TESTSTATE_H
+
+#include <QObject>
+
+/**
+ * @file teststate.h
+ * @brief Declaración de la clase de test unitario para State.
+ *
+ * Comprueba la caché de pose quieta: mientras los ángulos no se alejan de los de la última evaluación completa
+ * se reutilizan sus condiciones, y un cambio de ángulo, de restricciones o de fase la invalida.
+ */
+class TestState : public QObject {
+    Q_OBJECT
+
+private slots:
+
+    /**
+     * @brief Caja blanca: con la pose quieta, un ángulo dentro del margen reutiliza las condiciones guardadas sin
+     * volver a evaluar las restricciones.
+     */
+    void test_HoldReutilizado();
+
+    /**
+     * @brief Caja blanca: un ángulo fuera del margen fuerza una evaluación completa, y un salto mayor que la
+     * tolerancia deja la caché inválida.
+     */
+    void test_HoldInvalidadoPorAngulo();
+
+    /**
+     * @brief Caja blanca: entrar de nuevo en el estado o cambiar sus restricciones descarta la caché.
+     */
+    void test_HoldInvalidadoPorFase();
+
+    /**
+     * @brief Caja negra: una serie de ángulos cuya aceleración, estimada por KinematicsTracker, supera el umbral
+     * emite AccelerationSpikes, y una serie a velocidad constante no.
+     */
+    void test_PicoAceleracion();
+};
+
+#endif // TESTSTATE_H